@@ -0,0 +1,73 @@
+#ifndef DERIVED_H
+#define DERIVED_H
+
+#include <stdbool.h>
+#include "tracking.h"
+#include "kinematics.h"
+#include "expression.h"
+
+#define DERIVED_MAX 6
+#define DERIVED_NAME_LEN 16
+#define DERIVED_SOURCE_LEN 96
+#define DERIVED_HISTORY 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DERIVED_MASS = 0,       // m (kg)
+    DERIVED_GRAVITY,        // g (m/s²)
+    DERIVED_PARAM_COUNT
+} DerivedParam;
+
+// Une grandeur "nom = expression", compilée une fois et évaluée par blocs sur les
+// colonnes de Kinematics et les grandeurs définies avant elle.
+typedef struct DerivedColumn {
+    char source[DERIVED_SOURCE_LEN];
+    char name[DERIVED_NAME_LEN];
+    ExprProgram program;
+    bool valid;
+    ExprError error;
+    int errorPos;           // position dans source
+    float *values;          // mêmes indices que ts->points, lus sur [first, end)
+} DerivedColumn;
+
+typedef struct DerivedSet {
+    Kinematics *kinematics;  // partagée avec la fenêtre graphique
+    float params[DERIVED_PARAM_COUNT];
+    DerivedColumn columns[DERIVED_MAX];
+    int count;
+    int first, end;
+    bool ready;              // la série a au moins KINEMATICS_MIN_SPAN points
+    // Suivi incrémental : seules les lignes que Kinematics a recalculées sont réévaluées.
+    bool synced;
+    unsigned int kinVersion;
+    float evalParams[DERIVED_PARAM_COUNT];
+    unsigned int version;
+    int changedFrom[DERIVED_HISTORY];
+} DerivedSet;
+
+void Derived_Init(DerivedSet *set, Kinematics *kinematics);
+void Derived_Free(DerivedSet *set);
+// Compile "nom = expression" à l'indice 'index' (count : ajout). Une définition
+// refusée est gardée avec son erreur pour être corrigée.
+bool Derived_Define(DerivedSet *set, int index, const char *source);
+void Derived_Remove(DerivedSet *set, int index);
+// Énergies, quantité de mouvement et angle polaire, sauf celles déjà définies.
+void Derived_AddPresets(DerivedSet *set);
+int Derived_Find(const DerivedSet *set, const char *name);
+
+// Met à jour Tracking_UpdatePhysical, Kinematics puis les grandeurs ; sans effet si rien n'a changé.
+void Derived_Update(DerivedSet *set, TrackingSystem *ts);
+// Valeurs d'une grandeur valide, NULL si elle est en erreur ou si la série est trop courte.
+const float* Derived_Values(const DerivedSet *set, int column);
+// Même fonctionnement que Kinematics_Version / Kinematics_ChangedSince.
+unsigned int Derived_Version(const DerivedSet *set);
+bool Derived_ChangedSince(const DerivedSet *set, unsigned int version, int *from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
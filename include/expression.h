@@ -0,0 +1,60 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <stdbool.h>
+
+#define EXPR_MAX_OPS 96
+#define EXPR_MAX_STACK 12
+#define EXPR_BLOCK 256      // lignes traitées par chaque instruction d'un seul tenant
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    EXPR_OK = 0,
+    EXPR_ERR_EMPTY,
+    EXPR_ERR_SYNTAX,        // caractère ou jeton inattendu
+    EXPR_ERR_PAREN,         // parenthèse non fermée
+    EXPR_ERR_UNKNOWN,       // nom inconnu
+    EXPR_ERR_ARGS,          // mauvais nombre d'arguments
+    EXPR_ERR_COMPLEX,       // trop d'instructions ou pile trop profonde
+    EXPR_ERR_NAME,          // définition "nom = expression" incorrecte (derived.c)
+    EXPR_ERROR_COUNT
+} ExprError;
+
+typedef struct ExprOp {
+    unsigned char code;
+    unsigned char arg;      // colonne, paramètre ou fonction
+    float value;            // constante
+} ExprOp;
+
+// Programme postfixe : chaque instruction s'applique à un bloc de EXPR_BLOCK lignes,
+// les constantes sont repliées à la compilation.
+typedef struct ExprProgram {
+    ExprOp ops[EXPR_MAX_OPS];
+    int count;
+    int depth;
+} ExprProgram;
+
+// Noms résolus à la compilation : colonnes (une valeur par ligne) et paramètres
+// (un scalaire lu à chaque évaluation). Un nom vide n'est jamais reconnu.
+typedef struct ExprSymbols {
+    const char *const *columns;
+    int columnCount;
+    const char *const *params;
+    int paramCount;
+} ExprSymbols;
+
+bool Expr_Compile(const char *source, const ExprSymbols *symbols, ExprProgram *out, ExprError *error, int *errorPos);
+// out[i] pour i dans [begin, end), avec columns[c][i] et params[p] aux indices de la compilation.
+void Expr_Eval(const ExprProgram *program, const float *const *columns, const float *params, int begin, int end, float *out);
+bool Expr_IsIdentifier(const char *name);
+// Fonctions et constantes du langage, interdites comme noms de colonne.
+bool Expr_IsReserved(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
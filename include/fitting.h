@@ -0,0 +1,91 @@
+#ifndef FITTING_H
+#define FITTING_H
+
+#include <stdbool.h>
+
+#define FIT_MAX_DEGREE 8
+#define FIT_MAX_PARAMS (FIT_MAX_DEGREE + 1)
+#define FIT_BOOTSTRAP_REPLICATES 1000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FIT_AUTO = 0,           // droite ou parabole, sommes incrémentales (regression.h)
+    FIT_POLYNOMIAL,         // polynôme de degré quelconque, QR sur x centré réduit
+    FIT_DAMPED_OSCILLATOR,  // A e^(-γt) cos(ωt + φ) + c
+    FIT_EXP_DECAY,          // A e^(-t/τ) + c
+    FIT_PROJECTILE_DRAG,    // y0 + vt t + (v0 - vt)(1 - e^(-kt))/k
+    FIT_MODEL_COUNT
+} FitModel;
+
+typedef enum {
+    BOOT_OFF = 0,
+    BOOT_RESAMPLE,      // tirage des points avec remise
+    BOOT_JITTER,        // bruit gaussien de l'écart-type des résidus autour du modèle
+    BOOT_MODE_COUNT
+} BootstrapMode;
+
+// Intervalles de confiance à 95 % (percentiles 2,5 et 97,5) par paramètre.
+typedef struct FitInterval {
+    bool valid;
+    int replicates;
+    double lo[FIT_MAX_PARAMS];
+    double hi[FIT_MAX_PARAMS];
+    double stdDev[FIT_MAX_PARAMS];
+} FitInterval;
+
+// Série ajustée telle que l'appelant l'identifie (ex. mode du graphique et plage de points).
+typedef struct FitKey {
+    int series;
+    int begin;
+    int end;
+} FitKey;
+
+typedef struct FitResult {
+    FitModel model;
+    int degree;
+    FitKey key;
+    bool valid;
+    int paramCount;
+    // Polynôme : coefficients de x^k. Modèles physiques : t = x - xCenter.
+    double params[FIT_MAX_PARAMS];
+    double sigma[FIT_MAX_PARAMS];   // incertitudes type (1σ)
+    double basis[FIT_MAX_PARAMS];   // polynôme en (x - xCenter) / xScale, pour l'évaluation
+    double xCenter;
+    double xScale;
+    double rSquared;
+    double rmse;
+    int iterations;
+    FitInterval interval;
+} FitResult;
+
+bool Fit_Polynomial(const float *x, const float *y, int count, int degree, FitResult *out);
+// Levenberg-Marquardt ; l'estimation initiale est tirée des données.
+bool Fit_Nonlinear(FitModel model, const float *x, const float *y, int count, FitResult *out);
+bool Fit_Run(FitModel model, int degree, const float *x, const float *y, int count, FitResult *out);
+double Fit_Eval(const FitResult *fit, double x);
+// Réajuste le modèle de 'base' sur une autre série en partant de ses paramètres.
+bool Fit_Refit(const FitResult *base, const float *x, const float *y, int count, FitResult *out);
+// Réajustements répartis sur tous les coeurs (Job_ParallelFor) ; remplit base->interval.
+bool Fit_Bootstrap(FitResult *base, BootstrapMode mode, int replicates, const float *x, const float *y, int count);
+const char* Fit_ParamName(FitModel model, int index);
+
+// Ajustement sur un thread de travail : Submit copie la série et ne relance un
+// calcul que si elle a changé ; le graphique affiche le dernier résultat terminé.
+typedef struct FitEngine FitEngine;
+
+FitEngine* FitEngine_Create(void);
+void FitEngine_Destroy(FitEngine *engine);
+// 'key' identifie la série et se retrouve dans le résultat.
+void FitEngine_Submit(FitEngine *engine, FitModel model, int degree, BootstrapMode boot, FitKey key, const float *x, const float *y, int count);
+bool FitEngine_IsBusy(FitEngine *engine);
+// Copie le dernier résultat terminé ; false tant qu'aucun n'est disponible.
+bool FitEngine_Result(FitEngine *engine, FitResult *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
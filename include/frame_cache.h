@@ -0,0 +1,28 @@
+#ifndef FRAME_CACHE_H
+#define FRAME_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FRAME_CACHE_BUDGET_BYTES ((size_t)512 * 1024 * 1024)
+#define FRAME_CACHE_MIN_FRAMES 8
+#define FRAME_CACHE_MAX_FRAMES 1024
+
+// Images RGB24 décodées, indexées par numéro d'image. Partagé entre le thread UI
+// et les workers : toutes les fonctions sont thread-safe.
+typedef struct FrameCache FrameCache;
+
+FrameCache* FrameCache_Create(int width, int height, size_t budgetBytes);
+void FrameCache_Destroy(FrameCache *cache);
+void FrameCache_Clear(FrameCache *cache);
+int FrameCache_Capacity(const FrameCache *cache);
+bool FrameCache_Contains(FrameCache *cache, long long frameIdx);
+bool FrameCache_Fetch(FrameCache *cache, long long frameIdx, uint8_t *dst, double *outTime);
+
+// Réserve un emplacement (NULL si l'image est déjà présente ou en cours d'écriture).
+// L'appelant remplit width*height*3 octets puis appelle FrameCache_EndWrite.
+uint8_t* FrameCache_BeginWrite(FrameCache *cache, long long frameIdx);
+void FrameCache_EndWrite(FrameCache *cache, long long frameIdx, double time, bool ok);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef GRAPH_EXPORT_H
+#define GRAPH_EXPORT_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define GRAPH_EXPORT_WIDTH 4000
+#define GRAPH_EXPORT_MAX_PANELS 4
+#define GRAPH_EXPORT_CURVE_STEPS 800
+
+typedef enum { GRAPH_EXPORT_PNG, GRAPH_EXPORT_SVG } GraphExportFormat;
+
+typedef enum {
+    GRAPH_EXPORT_IDLE,
+    GRAPH_EXPORT_RUNNING,
+    GRAPH_EXPORT_DONE,
+    GRAPH_EXPORT_FAILED
+} GraphExportStatus;
+
+// Description d'un panneau telle qu'affichée, copiée sur le thread principal.
+typedef struct GraphExportPanel {
+    char label[16];             // vide : pas de titre (panneau seul)
+    char equation[512];
+    Color color;
+    float minX, maxX, minY, maxY;
+    float width, height;        // taille du tracé à l'écran (mise en page et tailles de texte)
+    bool fill;
+    bool hasCurve;
+    float curveY[GRAPH_EXPORT_CURVE_STEPS + 1]; // courbe aux abscisses régulières de [minX, maxX]
+} GraphExportPanel;
+
+typedef struct GraphExport GraphExport;
+
+// fontData : police TTF embarquée, relue à la résolution d'impression par le thread de travail.
+GraphExport* GraphExport_Create(const unsigned char *fontData, int fontSize);
+void GraphExport_Destroy(GraphExport *ex);
+
+bool GraphExport_IsBusy(GraphExport *ex);
+// Instantané : Begin vide la liste, AddPanel copie la description et les points
+// indices[0..count) de x/y. Sans effet pendant un export.
+void GraphExport_Begin(GraphExport *ex);
+void GraphExport_AddPanel(GraphExport *ex, const GraphExportPanel *desc, const float *x, const float *y, const int *indices, int count);
+int GraphExport_PanelCount(GraphExport *ex);
+bool GraphExport_Start(GraphExport *ex, GraphExportFormat format, const char *path);
+// Récupère la fin du travail ; DONE / FAILED restent jusqu'au prochain export.
+GraphExportStatus GraphExport_Status(GraphExport *ex);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef GRAPH_GPU_H
+#define GRAPH_GPU_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+// Géométrie du graphique conservée sur le GPU : les sommets sont exprimés par
+// rapport au coin du tracé et ne sont renvoyés que lorsqu'ils changent.
+// Sans shader (GL ancien), le même tampon est rejoué en mode immédiat.
+
+// Triangles colorés (courbe d'ajustement, remplissage).
+typedef struct GraphGeometry {
+    float *vertices;        // x, y
+    unsigned char *colors;  // r, g, b, a
+    int count;
+    int capacity;
+    unsigned int vao;
+    unsigned int vboPosition;
+    unsigned int vboColor;
+    int gpuCapacity;
+    bool dirty;
+} GraphGeometry;
+
+// Disques identiques dessinés par instanciation : un centre par instance, en
+// unités des données. Le passage aux pixels se fait dans le shader, si bien qu'un
+// changement d'axes ne renvoie rien et qu'un ajout n'envoie que les nouveaux centres.
+typedef struct GraphMarkers {
+    float *centers;
+    int count;
+    int capacity;
+    unsigned int vao;
+    unsigned int vboDisc;
+    unsigned int vboCenters;
+    int gpuCapacity;
+    bool dirty;
+    int dirtyFrom;          // premier centre à renvoyer
+} GraphMarkers;
+
+// Données -> pixels locaux au tracé : (p - offset) * scale.
+typedef struct GraphMapping {
+    float scaleX, scaleY;
+    float offsetX, offsetY;
+} GraphMapping;
+
+void GraphGpu_Init(void);
+void GraphGpu_Shutdown(void);
+
+void GraphGeometry_Clear(GraphGeometry *g);
+void GraphGeometry_Triangle(GraphGeometry *g, Vector2 a, Color ca, Vector2 b, Color cb, Vector2 c, Color cc);
+void GraphGeometry_Segment(GraphGeometry *g, Vector2 a, Vector2 b, float thick, Color color);
+void GraphGeometry_Draw(GraphGeometry *g, Vector2 origin);
+void GraphGeometry_Unload(GraphGeometry *g);
+
+void GraphMarkers_Clear(GraphMarkers *m);
+void GraphMarkers_Truncate(GraphMarkers *m, int count);
+void GraphMarkers_Add(GraphMarkers *m, Vector2 center);
+void GraphMarkers_Draw(GraphMarkers *m, Vector2 origin, GraphMapping mapping, float radius, Color color);
+void GraphMarkers_Unload(GraphMarkers *m);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef GRAPH_LOD_H
+#define GRAPH_LOD_H
+
+#include <stdbool.h>
+
+#define GRAPH_LOD_MAX_LEVELS 24
+
+// Noeud de niveau l : points [j * 2^l, (j + 1) * 2^l), indices de leurs extrêmes en y.
+typedef struct GraphLodNode {
+    int iMin;
+    int iMax;
+} GraphLodNode;
+
+// Pyramide min/max d'une série : le rendu ne dessine que les extrêmes de chaque
+// bloc, donc les pics restent visibles quel que soit le nombre de points. Seuls
+// les blocs qui contiennent un point modifié sont recalculés.
+typedef struct GraphLod {
+    float *x;
+    float *y;
+    int count;
+    int capacity;
+    GraphLodNode *levels[GRAPH_LOD_MAX_LEVELS]; // levels[0] inutilisé (points bruts)
+    int levelCount;
+    unsigned int version; // incrémenté à chaque modification
+} GraphLod;
+
+void GraphLod_Sync(GraphLod *lod, const float *x, const float *y, int count);
+// Comme GraphLod_Sync quand l'appelant sait que seuls les points [from, count) ont
+// changé (ajouts en fin de série) : aucune comparaison sur le reste.
+void GraphLod_Update(GraphLod *lod, const float *x, const float *y, int count, int from);
+// Indices (croissants) à dessiner sur [begin, end) : au plus 2 par bloc et
+// 'budget' blocs, soit environ 2 x 'budget' primitives. Renvoie le nombre écrit.
+int GraphLod_Select(const GraphLod *lod, int begin, int end, int budget, int *out, int maxOut);
+// Indices des extrêmes en y sur [begin, end) en O(log n). Faux si la plage est vide.
+bool GraphLod_Range(const GraphLod *lod, int begin, int end, int *iMin, int *iMax);
+// Premier indice dont x >= value (x croissant).
+int GraphLod_LowerBound(const GraphLod *lod, float value);
+void GraphLod_Free(GraphLod *lod);
+
+#endif
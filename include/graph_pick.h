@@ -0,0 +1,30 @@
+#ifndef GRAPH_PICK_H
+#define GRAPH_PICK_H
+
+#include <stdbool.h>
+
+#define GRAPH_PICK_CELL 8.0f
+
+// Grille de recherche en pixels (coordonnées locales au tracé) pour les séries
+// non monotones : seules les cellules proches de la souris sont parcourues.
+typedef struct GraphPick {
+    int *cellStart;   // cols * rows + 1 débuts de cellule dans items
+    int *items;       // indices des points, groupés par cellule
+    float *px;        // positions des points dans l'ordre de items
+    float *py;
+    int cols, rows;
+    int count;
+    int capacity;
+    int cellCapacity;
+} GraphPick;
+
+// Range les 'count' points dans la grille d'un tracé width x height couvrant [minX, maxX] x [minY, maxY].
+void GraphPick_Build(GraphPick *pick, const float *x, const float *y, int count,
+                     float minX, float maxX, float minY, float maxY, float width, float height);
+// Point le plus proche de (qx, qy) à moins de 'maxDist' pixels, ou -1.
+int GraphPick_Nearest(const GraphPick *pick, float qx, float qy, float maxDist);
+// Indice du x le plus proche de 'value' dans une série croissante (recherche dichotomique).
+int GraphPick_NearestSorted(const float *x, int count, float value);
+void GraphPick_Free(GraphPick *pick);
+
+#endif
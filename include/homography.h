@@ -0,0 +1,22 @@
+#ifndef HOMOGRAPHY_H
+#define HOMOGRAPHY_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Matrice 3x3 rangée par lignes, H[8] normalisé à 1.
+// Renvoie false si l'un des deux quadrilatères n'est pas convexe, est presque aplati,
+// ou si leurs coins ne sont pas parcourus dans le même sens (points cliqués dans le désordre).
+bool Homography_FromQuad(const Vector2 src[4], const Vector2 dst[4], float H[9]);
+Vector2 Homography_Apply(const float H[9], Vector2 p);
+void Homography_Multiply(const float A[9], const float B[9], float out[9]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef IMAGE_SEQUENCE_H
+#define IMAGE_SEQUENCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "frame_cache.h"
+#include "video_crop.h"
+
+#define SEQUENCE_DEFAULT_FPS 30.0
+#define SEQUENCE_MAX_INFLIGHT 32
+
+// Suite d'images numérotées (caméras rapides) : chaque image est un fichier
+// indépendant, l'accès à une image quelconque ne coûte qu'un décodage.
+typedef struct ImageSequence ImageSequence;
+
+// Dossier, motif ("img_%05d.tif" : un seul %d, "%%" pour un % littéral) ou une image
+// de la suite. Un motif est lu à partir du plus petit numéro présent dans le dossier.
+bool ImageSequence_IsSource(const char *source);
+ImageSequence* ImageSequence_Open(const char *source);
+void ImageSequence_Close(ImageSequence *seq);
+
+int ImageSequence_Count(const ImageSequence *seq);
+int ImageSequence_Width(const ImageSequence *seq);
+int ImageSequence_Height(const ImageSequence *seq);
+const char* ImageSequence_CodecName(const ImageSequence *seq);
+const char* ImageSequence_PixelFormat(const ImageSequence *seq);
+
+// Décode la zone 'crop' de l'image en RGB24 (crop->width*crop->height*3 octets). Thread-safe.
+bool ImageSequence_Decode(ImageSequence *seq, long long frameIdx, const VideoCrop *crop, uint8_t *dst);
+
+// Décode en tâche de fond les 'count' images suivantes dans le sens 'direction'.
+void ImageSequence_Prefetch(ImageSequence *seq, FrameCache *cache, const VideoCrop *crop, long long fromIdx, int direction, int count, double fps);
+void ImageSequence_Wait(ImageSequence *seq);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Job Job;
+typedef struct JobMutex JobMutex;
+
+typedef void (*JobFunc)(void *arg);
+typedef void (*JobRangeFunc)(void *ctx, int begin, int end);
+
+void JobSystem_Init(int workerCount); // 0 = un thread par coeur
+void JobSystem_Shutdown(void);
+int JobSystem_WorkerCount(void);
+
+Job* Job_Submit(JobFunc func, void *arg);
+bool Job_IsDone(Job *job);
+void Job_Wait(Job *job); // Bloque jusqu'à la fin puis libère le handle
+void Job_ParallelFor(int count, int minChunk, JobRangeFunc func, void *ctx);
+
+JobMutex* JobMutex_Create(void);
+void JobMutex_Destroy(JobMutex *mutex);
+void JobMutex_Lock(JobMutex *mutex);
+void JobMutex_Unlock(JobMutex *mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
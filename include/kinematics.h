@@ -0,0 +1,69 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <stdbool.h>
+#include "tracking.h"
+
+#define KINEMATICS_MAX_HALF 50
+// Plus courte série dérivable : en dessous de la fenêtre réglée, la fenêtre est
+// réduite jusqu'au schéma à 3 points.
+#define KINEMATICS_MIN_SPAN 3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DIFF_CENTRAL = 0,   // différences finies sur 3 points
+    DIFF_SAVGOL,        // Savitzky-Golay (fenêtre 2*half+1, degré 'order')
+    DIFF_SPLINE,        // spline de lissage discrète (Whittaker), raideur 'lambda'
+    DIFF_METHOD_COUNT
+} DiffMethod;
+
+// Colonnes SoA tenues par Kinematics, dans l'ordre des variables d'expression.
+typedef enum {
+    KIN_T = 0, KIN_X, KIN_Y, KIN_VX, KIN_VY, KIN_AX, KIN_AY,
+    KIN_COLUMN_COUNT
+} KinematicsColumn;
+
+typedef struct DiffSettings {
+    DiffMethod method;
+    int half;
+    int order;
+    float lambda;
+} DiffSettings;
+
+// Vitesses et accélérations de la série mesurée. Les noyaux de convolution sont
+// calculés une fois par réglage ; seules les images dont la fenêtre contient un
+// point modifié sont recalculées. Une fenêtre à pas irrégulier (image manquante)
+// est ajustée par moindres carrés sur les temps réels.
+typedef struct Kinematics Kinematics;
+
+DiffSettings Kinematics_DefaultSettings(void);
+Kinematics* Kinematics_Create(void);
+void Kinematics_Destroy(Kinematics *k);
+void Kinematics_Configure(Kinematics *k, DiffSettings settings);
+DiffSettings Kinematics_Settings(const Kinematics *k);
+int Kinematics_WindowSize(const Kinematics *k);
+
+// Lit ts->physX/physY (Tracking_UpdatePhysical doit avoir été appelé).
+void Kinematics_Update(Kinematics *k, const TrackingSystem *ts);
+float Kinematics_Velocity(const Kinematics *k, int index, bool isX);
+float Kinematics_Accel(const Kinematics *k, int index, bool isX);
+// Accès direct aux tableaux, lus sur [Kinematics_First, Kinematics_Count) ;
+// valables jusqu'au prochain Kinematics_Update. NULL avant la première mise à jour.
+const float* Kinematics_Column(const Kinematics *k, KinematicsColumn column);
+int Kinematics_First(const Kinematics *k);
+int Kinematics_Count(const Kinematics *k);
+
+// Chaque recalcul avance la version. Kinematics_ChangedSince donne le premier indice
+// recalculé depuis 'version' (k->count si rien n'a bougé), ou faux si cet
+// historique n'est plus connu.
+unsigned int Kinematics_Version(const Kinematics *k);
+bool Kinematics_ChangedSince(const Kinematics *k, unsigned int version, int *from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -8,18 +8,18 @@ typedef enum {
     T_FILE, T_EXPORT, T_GRAPHS, T_HELP,
     T_OPEN_VIDEO, T_OPEN_PROJET, T_SAVE_PROJET, T_QUIT,
     T_TO_REGRESSI, T_TO_EXCEL, T_COPY_CLIPBOARD,
-    T_VIEW_CURVES, T_USER_GUIDE, T_LANGUAGE,
+    T_VIEW_CURVES, T_VIEW_SPECTRUM, T_VIEW_DERIVED, T_USER_GUIDE, T_LANGUAGE,
     T_MSG_LOADED,
     
     // Filtres de fichiers (SFD)
-    T_FILTER_CSV, T_FILTER_TXT, T_FILTER_LAB,
+    T_FILTER_CSV, T_FILTER_TXT, T_FILTER_LAB, T_FILTER_PNG, T_FILTER_SVG,
     
     // En-têtes Export & Tableaux
     T_HEADER_TIME, T_HEADER_X, T_HEADER_Y,
     T_DEFAULT_PROJECT_NAME, T_UNTITLED,
     
     // Interface Canevas (Loupe, Drag)
-    T_MAGNIFIER, T_OUT_OF_ZONE, T_DRAG_VIDEO,
+    T_MAGNIFIER, T_OUT_OF_ZONE, T_DRAG_VIDEO, T_VIDEO_OPENING, T_VIDEO_OPEN_FAILED, T_POINTS_FULL,
     
     // États du Tracker (Overlay Vidéo)
     T_INITIALIZING, T_READY_SPACE, T_TRACKING_MSG, T_LOST_RETRY,
@@ -36,9 +36,26 @@ typedef enum {
     
     // Fenêtre Graphiques
     T_GRAPH_WINDOW_TITLE,
+    T_GRAPH_PANELS,
+    T_GRAPH_EXPORTING, T_GRAPH_EXPORTED, T_GRAPH_EXPORT_FAILED,
     T_SHOW_FIT, T_HIDE_FIT,
     T_SHOW_FILL, T_HIDE_FILL,
     T_FIT_NA,
+    T_DIFF_CENTRAL, T_DIFF_SAVGOL, T_DIFF_SPLINE, T_DIFF_WINDOW, T_DIFF_ORDER, T_DIFF_SMOOTHING,
+    T_FIT_AUTO, T_FIT_POLYNOMIAL, T_FIT_OSCILLATOR, T_FIT_DECAY, T_FIT_DRAG, T_FIT_PENDING,
+    T_BOOT_OFF, T_BOOT_RESAMPLE, T_BOOT_JITTER, T_BOOT_PENDING,
+
+    // Fenêtre Spectre
+    T_SPEC_WINDOW_TITLE,
+    T_SPEC_RECT, T_SPEC_HANN, T_SPEC_HAMMING, T_SPEC_BLACKMAN,
+    T_SPEC_PADDING, T_SPEC_SCALE_LIN, T_SPEC_SCALE_DB,
+    T_SPEC_NO_DATA, T_SPEC_PEAK, T_SPEC_GRID,
+
+    // Grandeurs dérivées
+    T_DERIVED_TITLE, T_DERIVED_MASS, T_DERIVED_GRAVITY, T_DERIVED_PRESETS, T_DERIVED_ADD,
+    T_DERIVED_HELP_VARS, T_DERIVED_HELP_FUNCS, T_DERIVED_ERR_AT,
+    T_EXPR_ERR_EMPTY, T_EXPR_ERR_SYNTAX, T_EXPR_ERR_PAREN, T_EXPR_ERR_UNKNOWN,
+    T_EXPR_ERR_ARGS, T_EXPR_ERR_COMPLEX, T_EXPR_ERR_NAME,
     
     // Onglets du panneau droit
     T_TAB_MEASURES, T_TAB_CALIB, T_TAB_INFO,
@@ -46,10 +63,13 @@ typedef enum {
     // Paramètres Étalonnage
     T_AXIS_ORIENTATION, T_ORIGIN_POS, T_CLICK_ON_VIDEO, T_PLACE_ORIGIN,
     T_SCALE, T_DEFINE_SCALE_AB, T_DEFINE_SCALE, T_REAL_DIST, T_PX_PER_METER,
+    T_PLANE, T_PLANE_DEFINE, T_PLANE_CLICK, T_PLANE_WIDTH, T_PLANE_HEIGHT, T_PLANE_ACTIVE, T_PLANE_INVALID, T_PLANE_NONE,
+    T_LENS, T_LENS_TRACE, T_LENS_TRACING, T_LENS_FIT, T_LENS_RESET, T_LENS_NONE, T_LENS_LINES,
     
     // Détails Vidéo (Tab Info)
     T_FILE_SECTION, T_VIDEO_SECTION, T_ENCODING_SECTION,
-    T_RES, T_FPS, T_DURATION, T_TOTAL_FRAMES, T_CODEC, T_PIXELS,
+    T_RES, T_FPS, T_DURATION, T_TOTAL_FRAMES, T_CODEC, T_PIXELS, T_DISCARDED, T_GPU_UPLOAD, T_DOUBLE_BUFFER,
+    T_CROP_ZONE, T_CROP_DEFINE, T_CROP_RESET,
     
     // Guide Utilisateur (Aide F1)
     T_HELP_TITLE, 
@@ -0,0 +1,33 @@
+#ifndef LATEST_JOB_H
+#define LATEST_JOB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calcul sur un thread de travail qui ne suit que la dernière série reçue : Submit
+// copie (x, y) et les réglages et ne relance un calcul que s'ils ont changé ; une
+// demande reçue pendant un calcul attend la fin de celui-ci, les précédentes sont oubliées.
+typedef struct LatestJob LatestJob;
+
+// Thread de travail : x et y sont une copie propre au calcul, modifiable.
+typedef void (*LatestJobRun)(void *ctx, const void *params, int key, float *x, float *y, int count);
+// Thread principal, calcul terminé : reprise du résultat avant le lancement du suivant.
+typedef void (*LatestJobCollect)(void *ctx);
+
+// 'params' : structure de réglages comparée octet par octet (sans remplissage).
+LatestJob* LatestJob_Create(size_t paramsSize, LatestJobRun run, LatestJobCollect collect, void *ctx);
+void LatestJob_Destroy(LatestJob *lj);
+void LatestJob_Submit(LatestJob *lj, const void *params, int key, const float *x, const float *y, int count);
+// Récupère le calcul terminé (collect) puis lance la dernière demande en attente.
+void LatestJob_Pump(LatestJob *lj);
+bool LatestJob_IsBusy(const LatestJob *lj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef LENS_H
+#define LENS_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define LENS_MAX_POINTS 128
+#define LENS_MAX_LINES 16
+#define LENS_ITERATIONS 6
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Modèle de Brown-Conrady en coordonnées normalisées ((p - center) / focal).
+typedef struct LensModel {
+    bool enabled;
+    float k1, k2;       // radiaux
+    float p1, p2;       // tangentiels
+    Vector2 center;     // centre optique (px)
+    float focal;        // rayon de normalisation (px)
+} LensModel;
+
+// Points cliqués le long d'arêtes droites dans la scène (méthode du fil à plomb).
+typedef struct LensLines {
+    Vector2 points[LENS_MAX_POINTS];
+    int lineIds[LENS_MAX_POINTS];
+    int count;
+    int lineCount;
+} LensLines;
+
+void Lens_Reset(LensModel *lens);
+bool Lens_Equals(const LensModel *a, const LensModel *b);
+
+// Corrige 'count' points en un seul passage (tableaux x/y séparés, dst peut être src).
+// La boucle n'a pas de branche : le compilateur la vectorise.
+void Lens_UndistortBatch(const LensModel *lens, const float *srcX, const float *srcY, float *dstX, float *dstY, int count);
+Vector2 Lens_Undistort(const LensModel *lens, Vector2 p);
+
+void LensLines_Clear(LensLines *lines);
+void LensLines_Add(LensLines *lines, Vector2 p);
+void LensLines_NextLine(LensLines *lines);
+
+// Ajuste k1, k2 (et p1, p2 à partir de trois lignes) pour redresser les lignes.
+bool Lens_Fit(LensModel *lens, const LensLines *lines, int frameW, int frameH);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
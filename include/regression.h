@@ -0,0 +1,48 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include <stdbool.h>
+
+#define REGRESSION_RECOMPUTE_INTERVAL 4096
+
+typedef enum { REG_LINEAR, REG_QUADRATIC } RegressionType;
+typedef struct { RegressionType type; double a, b, c, rSquared; } RegressionResult;
+
+// Moments de la série : suffisent pour les ajustements de degré 1 et 2 et leur R².
+// Ils sont pris en x - origin (premier x ajouté) pour que le système reste bien
+// conditionné quand x est loin de zéro (temps absolus).
+typedef struct RegressionStats {
+    double n;
+    double origin;
+    double sx, sx2, sx3, sx4;
+    double sy, sxy, sx2y, sy2;
+} RegressionStats;
+
+// Suit une série (x[i], y[i]) sur [begin, end) et met les moments à jour point par
+// point ; un recalcul compensé (Neumaier) borne la dérive tous les
+// REGRESSION_RECOMPUTE_INTERVAL ajouts/retraits.
+typedef struct RegressionTracker {
+    RegressionStats stats;
+    float *x;
+    float *y;
+    int capacity;
+    int begin;
+    int end;
+    int key;
+    int updatesSinceRecompute;
+    bool valid;
+} RegressionTracker;
+
+void Regression_Add(RegressionStats *s, double x, double y);
+void Regression_Remove(RegressionStats *s, double x, double y);
+void Regression_Recompute(RegressionStats *s, const float *x, const float *y, int count);
+RegressionResult Regression_Linear(const RegressionStats *s);
+RegressionResult Regression_Quadratic(const RegressionStats *s);
+
+// 'key' identifie la série (ex. le mode du graphique) : un changement force un recalcul.
+void RegressionTracker_Sync(RegressionTracker *rt, int key, const float *x, const float *y, int begin, int end);
+// Idem quand seuls les points d'indice >= 'from' ont pu changer : le reste n'est pas relu.
+void RegressionTracker_SyncFrom(RegressionTracker *rt, int key, const float *x, const float *y, int begin, int end, int from);
+void RegressionTracker_Free(RegressionTracker *rt);
+
+#endif
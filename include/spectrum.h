@@ -0,0 +1,63 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stdbool.h>
+
+#define SPECTRUM_MAX_SAMPLES (1 << 20)  // grille uniforme après rééchantillonnage
+#define SPECTRUM_MAX_PAD 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SPECTRUM_RECT = 0,
+    SPECTRUM_HANN,
+    SPECTRUM_HAMMING,
+    SPECTRUM_BLACKMAN,
+    SPECTRUM_WINDOW_COUNT
+} SpectrumWindow;
+
+// Spectre d'amplitude unilatéral : amp[k] à la fréquence k * df, k = 0 .. bins - 1.
+typedef struct SpectrumResult {
+    bool valid;
+    int key;
+    int samples;        // points de la grille uniforme
+    int fftSize;        // après bourrage de zéros (puissance de 2)
+    int bins;
+    double sampleRate;  // Hz
+    double df;
+    double peakFreq;    // pic principal, interpolé entre les raies
+    double peakAmp;
+    float *amp;
+    int capacity;
+} SpectrumResult;
+
+// Rééchantillonne (t, v) par interpolation linéaire au pas dt à partir de t[0].
+// Les instants doivent être croissants ; renvoie le nombre d'échantillons écrits.
+int Spectrum_Resample(const float *t, const float *v, int count, double dt, double *out, int maxOut);
+// Pas médian entre instants successifs (robuste aux images sautées).
+double Spectrum_MedianStep(const float *t, int count);
+// FFT complexe en place, n puissance de 2.
+void Spectrum_FFT(double *re, double *im, int n);
+// Série irrégulière -> grille uniforme -> tendance retirée, fenêtre, zéros -> FFT réelle.
+// pad : facteur de bourrage (1, 2, 4 ou 8).
+bool Spectrum_Compute(const float *t, const float *v, int count, SpectrumWindow window, int pad, SpectrumResult *out);
+void Spectrum_FreeResult(SpectrumResult *r);
+
+// Calcul sur un thread de travail : même fonctionnement que FitEngine (fitting.h).
+typedef struct SpectrumEngine SpectrumEngine;
+
+SpectrumEngine* SpectrumEngine_Create(void);
+void SpectrumEngine_Destroy(SpectrumEngine *engine);
+// Copie la série ; ignorée si elle est identique à la précédente.
+void SpectrumEngine_Submit(SpectrumEngine *engine, SpectrumWindow window, int pad, int key, const float *t, const float *v, int count);
+bool SpectrumEngine_IsBusy(SpectrumEngine *engine);
+// Dernier spectre terminé (valable jusqu'au prochain appel), NULL s'il n'y en a pas.
+const SpectrumResult* SpectrumEngine_Result(SpectrumEngine *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,6 +2,8 @@
 #define TRACKING_H
 
 #include "raylib.h"
+#include "lens.h"
+#include "homography.h"
 
 #define MAX_POINTS 4096
 
@@ -36,17 +38,61 @@ typedef struct Calibration {
     int scaleStep;
     float realDistance;
     float pxPerMeter;
+    LensModel lens;
+    LensLines lensLines;
+    bool isSettingLens;
+    // Plan en perspective : coins d'un rectangle connu, cliqués dans l'ordre
+    // haut-gauche, haut-droit, bas-droit, bas-gauche. Actif quand planeStep == 4.
+    Vector2 planePoints[4];
+    int planeStep;
+    bool isSettingPlane;
+    float planeWidth;
+    float planeHeight;
 } Calibration;
 
+// Homographie image corrigée -> plan, recalculée seulement quand ses entrées changent.
+typedef struct PlaneCache {
+    Vector2 points[4];
+    float width;
+    float height;
+    LensModel lens;
+    float H[9];
+    bool computed;
+    bool valid;
+} PlaneCache;
+
+// Pixels corrigés -> mètres : (x', y', w) = m * (x, y, 1), matrice 3x3 par lignes.
+typedef struct PhysicalTransform {
+    float m[9];
+} PhysicalTransform;
+
 typedef struct TrackingSystem {
     MeasurePoint points[MAX_POINTS];
     int count;
+    // Positions corrigées de la distorsion, mêmes indices que 'points'.
+    float undistX[MAX_POINTS];
+    float undistY[MAX_POINTS];
+    // Positions physiques, remplies par Tracking_UpdatePhysical.
+    float physX[MAX_POINTS];
+    float physY[MAX_POINTS];
     
     Vector2 origin;
     float scale;
     bool isCalibrated;
     int startFrame;
     Calibration calib;
+    PlaneCache planeCache;
+
+    // 'revision' avance à chaque modification ; 'editRevision' seulement quand elle
+    // ne se résume pas à des points ajoutés en fin de série (édition, objectif,
+    // étalonnage, rechargement). Tant qu'editRevision n'a pas bougé, un lecteur
+    // qui a vu 'n' points n'a que [n, count) à traiter.
+    unsigned int revision;
+    unsigned int editRevision;
+    PhysicalTransform physTransform; // transformation appliquée à physX/physY
+    int physCount;
+    unsigned int physEdit;
+    bool physValid;
 } TrackingSystem;
 
 
@@ -54,7 +100,17 @@ void Tracking_Init(TrackingSystem *ts);
 Vector2 ScreenToVideo(Vector2 screenPos, Rectangle destRect, float sourceW, float sourceH);
 Vector2 VideoToScreen(Vector2 videoPos, Rectangle destRect, float sourceW, float sourceH);
 Vector2 PixelToPhysical(struct TrackingSystem *ts, Vector2 pixelPos);
-void Tracking_AddPoint(TrackingSystem *ts, double time, Vector2 videoPos);
+bool Tracking_IsCalibrated(TrackingSystem *ts);
+bool Tracking_HasPlane(TrackingSystem *ts);
+PhysicalTransform Tracking_BuildTransform(TrackingSystem *ts);
+void Tracking_TransformBatch(const PhysicalTransform *t, const float *x, const float *y, float *outX, float *outY, int count);
+void Tracking_UpdatePhysical(TrackingSystem *ts);
+void Tracking_ApplyLens(TrackingSystem *ts);
+// false si le point n'a pas pu être ajouté : la série est limitée à MAX_POINTS.
+bool Tracking_AddPoint(TrackingSystem *ts, double time, Vector2 videoPos);
+bool Tracking_IsFull(const TrackingSystem *ts);
+// À appeler après une modification directe de 'points', 'count' ou 'startFrame'.
+void Tracking_MarkEdited(TrackingSystem *ts);
 #ifdef __cplusplus
 }
 #endif
@@ -6,12 +6,13 @@
 struct TrackingSystem;
 struct VideoEngine;
 struct AutoTracker;
+struct DerivedSet;
 
 
-void Action_ExportCSV(struct TrackingSystem *ts, const char* videoName);
-void Action_ExportRegressi(struct TrackingSystem *ts, const char* videoName);
-void Action_CopyClipboard(struct TrackingSystem *ts);
-void Action_SaveProject(struct TrackingSystem *ts, const char* videoPath);
-bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, char* outVideoPath);
+void Action_ExportCSV(struct TrackingSystem *ts, const struct DerivedSet *derived, const char* videoName);
+void Action_ExportRegressi(struct TrackingSystem *ts, const struct DerivedSet *derived, const char* videoName);
+void Action_CopyClipboard(struct TrackingSystem *ts, const struct DerivedSet *derived);
+void Action_SaveProject(struct TrackingSystem *ts, struct VideoEngine *v, const struct DerivedSet *derived, const char* videoPath);
+bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, struct DerivedSet *derived, char* outVideoPath);
 
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@ struct AutoTracker;
 struct VideoEngine;
 struct TrackingSystem;
 struct GraphState;
+struct DerivedSet;
 
 typedef enum { TOOL_SELECT, TOOL_POINT, TOOL_LOOP, TOOL_TRACK } ToolMode;
 typedef enum { TAB_MEASURES, TAB_CALIB, TAB_INFO } PanelTab;
@@ -33,6 +34,7 @@ typedef struct UIState {
     Rectangle windowBoundsStart;
     Vector2 mouseStartGlobal;
     bool isMaximized;
+    bool requestQuit;        // Fichier > Quitter : main sort de la boucle et libère tout
     Rectangle oldWindowPos;
     Font appFont;
     Texture2D iconClose;
@@ -45,6 +47,8 @@ typedef struct UIState {
     Texture2D iconPrev;
     Texture2D axisIcons[4];
     bool isEditingDist;
+    bool isEditingText;
+    float *distEditTarget;
     char distInputBuf[64];
     int distCursorIndex;
     int distSelectStart;
@@ -52,11 +56,22 @@ typedef struct UIState {
     float tableScrollOffset;
     int tableHoveredRow;
     bool isDraggingTableScroll;
+    int tableDerived;           // grandeur dérivée affichée en 4e colonne
+    struct DerivedSet *derived;
     Texture2D iconCheckOn;
     Texture2D iconCheckOff;
     bool isMenuOpen;
     bool showGraphWindow;
+    bool showSpectrumWindow;
+    bool showDerivedWindow;
     bool showHelp;
+    bool isSettingCrop;
+    bool isDraggingCrop;
+    Vector2 cropAnchor;
+    Rectangle cropDraft;
+    float sequenceFpsEdit;      // cadence saisie pour une suite d'images
+    float calibScrollOffset;
+    Rectangle widgetClip;
 } UIState;
 
 
@@ -69,6 +84,8 @@ void DrawRectangleRoundedCustom(Rectangle rec, float roundness, int segments, Co
 void DrawTextApp(UIState *ui, const char *text, int x, int y, int fontSize, Color color);
 void DrawSidePanels(struct UIState *ui, struct TrackingSystem *ts, struct VideoEngine *v, struct AutoTracker *tracker, const char* filename);
 const char* GetFileNameFromPath(const char* path);
+const unsigned char* GetAppFontData(int *size);
+bool IsMouseInWidgetClip(UIState *ui);
 void HandleWindowResize(UIState *state);
 
 #endif
\ No newline at end of file
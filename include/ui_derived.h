@@ -0,0 +1,21 @@
+#ifndef UI_DERIVED_H
+#define UI_DERIVED_H
+
+#include "raylib.h"
+#include "derived.h"
+#include "ui_core.h"
+#include "ui_input.h"
+
+typedef struct DerivedWindowState {
+    Rectangle bounds;
+    bool isDragging;
+    Vector2 dragOffset;
+    int editIndex;           // grandeur en cours d'édition (count : nouvelle), -1 : aucune
+    char editBuf[DERIVED_SOURCE_LEN];
+    GuiTextState text;
+} DerivedWindowState;
+
+void InitDerivedWindow(DerivedWindowState *state);
+void DrawDerivedWindow(UIState *ui, DerivedWindowState *state, DerivedSet *set);
+
+#endif
@@ -3,6 +3,14 @@
 
 #include "raylib.h"
 #include "tracking.h"
+#include "kinematics.h"
+#include "regression.h"
+#include "fitting.h"
+#include "graph_lod.h"
+#include "graph_pick.h"
+#include "graph_gpu.h"
+#include "graph_export.h"
+#include "derived.h"
 #include "ui_core.h"
 
 
@@ -13,21 +21,115 @@ typedef enum {
     GRAPH_VX_T,
     GRAPH_VY_T,
     GRAPH_AX_T,
-    GRAPH_AY_T
+    GRAPH_AY_T,
+    GRAPH_USER              // GRAPH_USER + j : grandeur dérivée j en fonction de t
 } GraphMode;
 
+#define GRAPH_MODE_COUNT (GRAPH_USER + DERIVED_MAX)
+#define GRAPH_MAX_PANELS 4
+#define GRAPH_MAX_DRAW_INDICES 8192
+#define GRAPH_CURVE_STEPS 200
+
+// Ce qui détermine la position des points à l'écran.
+typedef struct GraphViewKey {
+    int mode;
+    unsigned int dataVersion;
+    int start;
+    float minX, maxX, minY, maxY;
+    float width, height;
+} GraphViewKey;
+
+// Colonnes d'un mode, calculées au plus une fois par image et partagées par
+// tous les panneaux qui l'affichent, avec leur pyramide.
+typedef struct GraphSeries {
+    float *valX;
+    float *valY;
+    unsigned int frame;     // image du dernier calcul
+    bool ready;             // assez de points pour ce mode
+    bool sortedX;
+    int start, end;
+    float minX, maxX, minY, maxY; // axes automatiques (marges comprises)
+    float rawMinX, rawMaxX;
+    // Suivi des ajouts : tant que ts->editRevision ne bouge pas, seuls les points
+    // ajoutés (et, en dérivée, ceux que Kinematics a recalculés) sont relus.
+    bool synced;
+    unsigned int seenEdit;
+    unsigned int kinVersion;    // version de Kinematics, ou de DerivedSet pour GRAPH_USER + j
+    int changedFrom;        // premier indice modifié (relatif à start) à la dernière version de lod
+    GraphLod lod;           // lod.version sert de version à la série
+} GraphSeries;
+
+// Une tuile : son mode, sa vue, ses ajustements (sur sa plage visible) et ses caches de rendu.
+typedef struct GraphPanel {
+    GraphMode mode;
+    bool zoomed;             // axes fixés par l'utilisateur (sinon ajustement automatique)
+    bool viewAutoY;          // y ajusté à la fenêtre visible
+    GraphMode viewMode;
+    float viewMinX, viewMaxX, viewMinY, viewMaxY;
+    bool isPanning;
+    Vector2 panLast;
+    bool isBoxZooming;
+    Vector2 boxStart;
+    GraphPick pick;
+    unsigned int regressionVersion;
+    RegressionTracker regression;
+    FitEngine *fitter;
+    // Dernière demande transmise au fitter : inutile de la recomparer point par point.
+    bool fitSubmitted;
+    unsigned int fitVersion;
+    int fitBegin, fitEnd, fitDegree;
+    FitModel fitModel;
+    BootstrapMode fitBoot;
+    GraphGeometry fillGeometry;
+    GraphGeometry curveGeometry;
+    GraphMarkers markers;   // en unités des données
+    bool markersValid;
+    bool markersAll;        // tous les points de [markerBegin, markerEnd) sont dessinés
+    unsigned int markerVersion;
+    int markerBegin, markerEnd, markerBudget;
+    GraphViewKey viewKey;   // ce qui invalide le calque
+    bool viewValid;
+    GraphViewKey pickKey;
+    bool pickValid;
+    Vector2 curveCache[GRAPH_CURVE_STEPS + 1];
+    Color curveColor;
+    bool curveFill;
+    float curveHeight;
+    bool curveCacheValid;
+    RenderTexture2D layer;
+    bool layerValid;
+    bool layerShowFill;
+    char layerText[512];
+} GraphPanel;
 
 typedef struct GraphState {
     Rectangle bounds;
-    GraphMode mode;
     bool isDragging;
     Vector2 dragOffset;
-    bool requestExport;
+    bool requestExport;      // instantané des panneaux pendant l'image courante
+    GraphExportFormat exportFormat;
+    GraphExport *exporter;
+    GraphExportStatus exportStatus;
+    double exportStatusTime;
     bool showRegression;
     bool showFill;
+    Kinematics *kinematics;
+    DerivedSet *derived;     // grandeurs utilisateur, calculées sur 'kinematics'
+    FitModel fitModel;
+    int fitDegree;
+    BootstrapMode bootstrap;
+    unsigned int frame;
+    GraphSeries series[GRAPH_MODE_COUNT];
+    int *drawIndices;
+    GraphPanel panels[GRAPH_MAX_PANELS];
+    int panelCount;
+    int activePanel;
+    int cursorIdx;           // point survolé, repris par tous les panneaux (-1 : aucun)
+    int nextCursorIdx;
 } GraphState;
 
 void InitGraphSystem(GraphState *state);
+void UnloadGraphSystem(GraphState *state);
 void DrawGraphWindow(UIState *ui, GraphState *state, TrackingSystem *ts);
 
 #endif
\ No newline at end of file
@@ -8,6 +8,16 @@
 
 struct UIState; 
 
+// État d'un champ de texte libre, tenu par l'appelant.
+typedef struct GuiTextState {
+    bool editing;
+    int cursor;
+    float scroll;
+} GuiTextState;
+
 bool GuiFloatInput(struct UIState *ui, Rectangle bounds, float *value, const char* suffix);
+// Édite 'buffer' (ASCII imprimable, 'size' octets). Vrai quand la saisie est validée
+// par Entrée ou par un clic en dehors du champ.
+bool GuiTextInput(struct UIState *ui, Rectangle bounds, char *buffer, int size, GuiTextState *state);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef UI_SPECTRUM_H
+#define UI_SPECTRUM_H
+
+#include "raylib.h"
+#include "tracking.h"
+#include "spectrum.h"
+#include "ui_core.h"
+
+typedef struct SpectrumState {
+    Rectangle bounds;
+    bool isDragging;
+    Vector2 dragOffset;
+    bool useY;               // y(t) analysé, sinon x(t)
+    SpectrumWindow window;
+    int pad;                 // facteur de bourrage de zéros
+    bool logScale;           // amplitude en dB, 0 dB au pic
+    float viewMaxFreq;       // borne haute de l'axe (0 : fréquence de Nyquist)
+    SpectrumEngine *engine;
+    float *t;                // série envoyée au calcul
+    float *v;
+    bool submitted;
+    unsigned int seenRevision;
+    int seenStart;
+    int seenKey;
+} SpectrumState;
+
+void InitSpectrumSystem(SpectrumState *state);
+void UnloadSpectrumSystem(SpectrumState *state);
+void DrawSpectrumWindow(UIState *ui, SpectrumState *state, TrackingSystem *ts);
+
+#endif
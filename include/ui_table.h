@@ -10,6 +10,7 @@ struct TrackingSystem;
 struct VideoEngine;
 
 void DrawMeasurementTable(struct UIState *ui, struct TrackingSystem *ts, struct VideoEngine *v, Rectangle bounds);
+void DrawCheckbox(struct UIState *ui, const char* label, bool *value, int x, int y);
 void DrawCommonSettingsWithTS(struct UIState *ui, struct TrackingSystem *ts, struct AutoTracker *tracker, Rectangle bounds);
 
 #endif
\ No newline at end of file
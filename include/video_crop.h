@@ -0,0 +1,23 @@
+#ifndef VIDEO_CROP_H
+#define VIDEO_CROP_H
+
+#include <stdbool.h>
+#include <libavutil/frame.h>
+
+// Zone d'analyse en pixels de l'image complète. Les bords sont pairs pour rester
+// alignés sur les plans de chrominance sous-échantillonnés (yuv420...).
+typedef struct VideoCrop {
+    int x;
+    int y;
+    int width;
+    int height;
+} VideoCrop;
+
+// Une largeur ou hauteur nulle désigne l'image entière.
+VideoCrop VideoCrop_Make(float x, float y, float width, float height, int frameW, int frameH);
+bool VideoCrop_IsFull(const VideoCrop *crop, int frameW, int frameH);
+
+// Restreint l'image décodée à la zone (sans copie : seuls les pointeurs de plans bougent).
+bool VideoCrop_Apply(const VideoCrop *crop, AVFrame *frame);
+
+#endif
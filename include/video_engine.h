@@ -6,13 +6,34 @@
 #include <libavformat/avformat.h>
 #include <libswscale/swscale.h>
 #include <libavutil/imgutils.h>
+#include "frame_cache.h"
+#include "image_sequence.h"
+#include "video_crop.h"
 
+#define VIDEO_SPEED_MIN (1.0 / 16.0)
+#define VIDEO_SPEED_MAX 8.0
+#define VIDEO_MAX_CATCHUP_FRAMES 64
+#define VIDEO_UPLOAD_TEXTURES 2
 
+typedef enum {
+    VIDEO_QUALITY_FULL,
+    VIDEO_QUALITY_SCRUB
+} VideoDecodeQuality;
+
+typedef enum {
+    VIDEO_LOAD_IDLE,
+    VIDEO_LOAD_OPENING,
+    VIDEO_LOAD_METADATA,
+    VIDEO_LOAD_READY,
+    VIDEO_LOAD_FAILED
+} VideoLoadState;
 
 typedef struct VideoEngine {
     bool isLoaded;
     int width;
     int height;
+    VideoCrop crop;
+    Rectangle cropRequest;
     double fps;
     double durationSec;
     long long frameCount;
@@ -20,9 +41,18 @@ typedef struct VideoEngine {
     char codecName[32];
     char pixelFormat[32];
     Texture2D texture;
+    Texture2D uploadTextures[VIDEO_UPLOAD_TEXTURES];
+    int uploadIndex;
+    bool directUpload;
+    double uploadLastMs;
+    double uploadAvgMs;
+    double uploadMaxMs;
     bool isPlaying;
+    bool isReversing;
+    bool needsResync;
     double currentTime;
     double accumulator;
+    double playbackSpeed;
     uint8_t *buffer;
     AVFrame *frame;
     AVFrame *frameRGB;
@@ -31,16 +61,34 @@ typedef struct VideoEngine {
     AVCodecContext *codecCtx;
     struct SwsContext *swsCtx;
     int videoStreamIndex;
+    long long discardedPackets;
+    long long discardedBytes;
+    int64_t skipScanPos;     // fin du dernier paquet vidéo lu, -1 après un seek
+    VideoDecodeQuality quality;
+    char filePath[512];
+    FrameCache *cache;
+    struct ReversePlayer *reverse;
+    ImageSequence *sequence;
+    double sequenceFps;
+    struct VideoLoader *loader;
+    VideoLoadState loadState;
 
 } VideoEngine;
 
 void Video_TogglePlay(VideoEngine *v);
+void Video_TogglePlayReverse(VideoEngine *v);
 void Video_Seek(VideoEngine *v, double timestamp);
 void Video_NextFrame(VideoEngine *v);
 void Video_PrevFrame(VideoEngine *v);
 bool Video_Load(VideoEngine *v, const char *filename);
 void Video_Update(VideoEngine *v);
 void Video_Unload(VideoEngine *v);
+void Video_SetDecodeQuality(VideoEngine *v, VideoDecodeQuality quality);
+void Video_SetPlaybackSpeed(VideoEngine *v, double speed);
+void Video_StepPlaybackSpeed(VideoEngine *v, int direction);
+void Video_SetSequenceFps(VideoEngine *v, double fps);
+void Video_SetDirectUpload(VideoEngine *v, bool direct);
+void Video_SetCrop(VideoEngine *v, Rectangle crop);
 
 
 #endif
\ No newline at end of file
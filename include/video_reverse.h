@@ -0,0 +1,24 @@
+#ifndef VIDEO_REVERSE_H
+#define VIDEO_REVERSE_H
+
+#include <stdbool.h>
+#include "frame_cache.h"
+#include "video_crop.h"
+
+// Décodeur secondaire qui décode un GOP en avant dans le FrameCache pour que la
+// lecture arrière n'ait plus qu'à présenter les images à l'envers.
+typedef struct ReversePlayer ReversePlayer;
+
+ReversePlayer* ReversePlayer_Create(const char *path, double fps, double baseTimeOffset, const VideoCrop *crop, FrameCache *cache);
+void ReversePlayer_Destroy(ReversePlayer *rp);
+bool ReversePlayer_IsBusy(ReversePlayer *rp);
+void ReversePlayer_Wait(ReversePlayer *rp);
+// Décode toute la fenêtre qui se termine en lastIdx sur le thread appelant.
+void ReversePlayer_DecodeWindow(ReversePlayer *rp, long long lastIdx);
+// Ne décode sur le thread appelant que le GOP de frameIdx ; le reste de la fenêtre suit sur un worker.
+void ReversePlayer_DecodeGop(ReversePlayer *rp, long long frameIdx);
+void ReversePlayer_Anticipate(ReversePlayer *rp, long long currentIdx);
+// Testé entre deux paquets : un retour non nul interrompt le décodage en cours.
+void ReversePlayer_SetInterrupt(ReversePlayer *rp, int (*callback)(void *), void *opaque);
+
+#endif
@@ -87,8 +87,9 @@ void AutoTracker_ConfirmSelection(AutoTracker *tracker, VideoEngine *video) {
         if (targetW < 10) { targetW = 20; tracker->targetRect.x -= 5; }
         if (targetH < 10) { targetH = 20; tracker->targetRect.y -= 5; }
 
-        int scaledX = (int)((tracker->targetRect.x - padding) * scale);
-        int scaledY = (int)((tracker->targetRect.y - padding) * scale);
+        // La texture ne couvre que la zone d'analyse : on passe en coordonnées locales.
+        int scaledX = (int)((tracker->targetRect.x - video->crop.x - padding) * scale);
+        int scaledY = (int)((tracker->targetRect.y - video->crop.y - padding) * scale);
         int scaledW = (int)((targetW + padding*2) * scale);
         int scaledH = (int)((targetH + padding*2) * scale);
 
@@ -150,8 +151,8 @@ void AutoTracker_Update(AutoTracker *tracker, VideoEngine *video, TrackingSystem
         bool ok = wrapper->cvTracker->update(frame, bbox);
         
         if (!ok && wrapper->lostFrameCount < 3) {
-            float predX = (tracker->centerPos.x + tracker->velocity.x) * scale;
-            float predY = (tracker->centerPos.y + tracker->velocity.y) * scale;
+            float predX = (tracker->centerPos.x - video->crop.x + tracker->velocity.x) * scale;
+            float predY = (tracker->centerPos.y - video->crop.y + tracker->velocity.y) * scale;
             float w = tracker->targetRect.width * scale;
             float h = tracker->targetRect.height * scale;
             
@@ -175,8 +176,8 @@ void AutoTracker_Update(AutoTracker *tracker, VideoEngine *video, TrackingSystem
         if (ok) {
             float invScale = 1.0f / scale;
             
-            float realX = bbox.x * invScale;
-            float realY = bbox.y * invScale;
+            float realX = bbox.x * invScale + video->crop.x;
+            float realY = bbox.y * invScale + video->crop.y;
             float realW = bbox.width * invScale;
             float realH = bbox.height * invScale;
 
@@ -186,8 +187,9 @@ void AutoTracker_Update(AutoTracker *tracker, VideoEngine *video, TrackingSystem
             };
 
             float margin = 10.0f;
-            if (newCenter.x < margin || newCenter.x > video->width - margin ||
-                newCenter.y < margin || newCenter.y > video->height - margin) {
+            float minX = video->crop.x + margin, maxX = video->crop.x + video->crop.width - margin;
+            float minY = video->crop.y + margin, maxY = video->crop.y + video->crop.height - margin;
+            if (newCenter.x < minX || newCenter.x > maxX || newCenter.y < minY || newCenter.y > maxY) {
                 tracker->state = TRACKER_IDLE;
                 tracker->needsToAdvance = false;
                 printf("[OpenCV] Bord ecran atteint.\n");
@@ -197,7 +199,7 @@ void AutoTracker_Update(AutoTracker *tracker, VideoEngine *video, TrackingSystem
             float dx = newCenter.x - tracker->centerPos.x;
             float dy = newCenter.y - tracker->centerPos.y;
             float dist = sqrtf(dx*dx + dy*dy);
-            float maxJump = (float)video->width * 0.15f; 
+            float maxJump = (float)video->crop.width * 0.15f; 
             if (maxJump < 150.0f) maxJump = 150.0f;
 
             if (dist > maxJump && wrapper->lostFrameCount == 0) {
@@ -214,7 +216,12 @@ void AutoTracker_Update(AutoTracker *tracker, VideoEngine *video, TrackingSystem
             tracker->targetRect.width = realW;
             tracker->targetRect.height = realH;
             
-            Tracking_AddPoint(ts, video->currentTime, tracker->centerPos);
+            if (!Tracking_AddPoint(ts, video->currentTime, tracker->centerPos)) {
+                tracker->state = TRACKER_IDLE;
+                tracker->needsToAdvance = false;
+                printf("[OpenCV] Limite de %d points atteinte.\n", MAX_POINTS);
+                return;
+            }
             
             double timePerFrame = 1.0 / video->fps;
             
@@ -0,0 +1,199 @@
+#include "derived.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const baseNames[KIN_COLUMN_COUNT] = { "t", "x", "y", "vx", "vy", "ax", "ay" };
+static const char *const paramNames[DERIVED_PARAM_COUNT] = { "m", "g" };
+
+static const struct { const char *name; const char *source; } derivedPresets[] = {
+    { "Ec", "Ec = 0.5*m*(vx^2 + vy^2)" },
+    { "Ep", "Ep = m*g*y" },
+    { "Em", "Em = Ec + Ep" },
+    { "p", "p = m*sqrt(vx^2 + vy^2)" },
+    { "theta", "theta = atan2(y, x)" },
+};
+
+void Derived_Init(DerivedSet *set, Kinematics *kinematics) {
+    *set = (DerivedSet){ 0 };
+    set->kinematics = kinematics;
+    set->params[DERIVED_MASS] = 1.0f;
+    set->params[DERIVED_GRAVITY] = 9.81f;
+    for (int j = 0; j < DERIVED_MAX; j++) {
+        set->columns[j].values = (float *)malloc(MAX_POINTS * sizeof(float));
+    }
+}
+
+void Derived_Free(DerivedSet *set) {
+    for (int j = 0; j < DERIVED_MAX; j++) {
+        free(set->columns[j].values);
+        set->columns[j].values = NULL;
+    }
+    set->count = 0;
+}
+
+static bool DerivedFail(DerivedColumn *col, ExprError error, int pos) {
+    col->error = error;
+    col->errorPos = pos;
+    col->program.count = 0;
+    return false;
+}
+
+// "nom = expression" : le nom doit être libre (ni variable, ni paramètre, ni
+// fonction, ni grandeur précédente).
+static bool Derived_CompileColumn(DerivedSet *set, int index, const ExprSymbols *symbols) {
+    DerivedColumn *col = &set->columns[index];
+    col->name[0] = '\0';
+    col->error = EXPR_OK;
+    col->errorPos = 0;
+
+    const char *src = col->source;
+    const char *eq = strchr(src, '=');
+    if (!eq) return DerivedFail(col, EXPR_ERR_NAME, 0);
+    const char *a = src;
+    while (*a == ' ' || *a == '\t') a++;
+    const char *b = eq;
+    while (b > a && (b[-1] == ' ' || b[-1] == '\t')) b--;
+    int len = (int)(b - a);
+    if (len <= 0 || len >= DERIVED_NAME_LEN) return DerivedFail(col, EXPR_ERR_NAME, (int)(a - src));
+    memcpy(col->name, a, (size_t)len);
+    col->name[len] = '\0';
+
+    bool taken = !Expr_IsIdentifier(col->name) || Expr_IsReserved(col->name);
+    for (int c = 0; c < KIN_COLUMN_COUNT && !taken; c++) taken = (strcmp(baseNames[c], col->name) == 0);
+    for (int p = 0; p < DERIVED_PARAM_COUNT && !taken; p++) taken = (strcmp(paramNames[p], col->name) == 0);
+    for (int k = 0; k < index && !taken; k++) taken = (strcmp(set->columns[k].name, col->name) == 0);
+    if (taken) return DerivedFail(col, EXPR_ERR_NAME, (int)(a - src));
+
+    int exprStart = (int)(eq + 1 - src);
+    int pos = 0;
+    if (!Expr_Compile(eq + 1, symbols, &col->program, &col->error, &pos)) {
+        col->errorPos = exprStart + pos;
+        return false;
+    }
+    return true;
+}
+
+// Une grandeur voit les précédentes : toute modification recompile la suite, et
+// une grandeur en erreur rend inconnues celles qui l'utilisent.
+static void Derived_CompileAll(DerivedSet *set) {
+    const char *names[KIN_COLUMN_COUNT + DERIVED_MAX];
+    for (int c = 0; c < KIN_COLUMN_COUNT; c++) names[c] = baseNames[c];
+    ExprSymbols symbols = { names, KIN_COLUMN_COUNT, paramNames, DERIVED_PARAM_COUNT };
+    for (int j = 0; j < set->count; j++) {
+        DerivedColumn *col = &set->columns[j];
+        col->valid = Derived_CompileColumn(set, j, &symbols);
+        names[KIN_COLUMN_COUNT + j] = col->valid ? col->name : "";
+        symbols.columnCount++;
+    }
+    set->synced = false;
+}
+
+bool Derived_Define(DerivedSet *set, int index, const char *source) {
+    if (index < 0 || index > set->count || index >= DERIVED_MAX) return false;
+    if (index == set->count) set->count++;
+    DerivedColumn *col = &set->columns[index];
+    strncpy(col->source, source ? source : "", DERIVED_SOURCE_LEN - 1);
+    col->source[DERIVED_SOURCE_LEN - 1] = '\0';
+    Derived_CompileAll(set);
+    return col->valid;
+}
+
+void Derived_Remove(DerivedSet *set, int index) {
+    if (index < 0 || index >= set->count) return;
+    // Les tableaux de valeurs restent attribués : celui de la grandeur retirée passe en fin de liste.
+    DerivedColumn removed = set->columns[index];
+    memmove(&set->columns[index], &set->columns[index + 1], (size_t)(set->count - index - 1) * sizeof(DerivedColumn));
+    set->count--;
+    set->columns[set->count] = (DerivedColumn){ 0 };
+    set->columns[set->count].values = removed.values;
+    Derived_CompileAll(set);
+}
+
+void Derived_AddPresets(DerivedSet *set) {
+    for (size_t i = 0; i < sizeof(derivedPresets) / sizeof(derivedPresets[0]); i++) {
+        if (set->count >= DERIVED_MAX) break;
+        if (Derived_Find(set, derivedPresets[i].name) >= 0) continue;
+        Derived_Define(set, set->count, derivedPresets[i].source);
+    }
+}
+
+int Derived_Find(const DerivedSet *set, const char *name) {
+    for (int j = 0; j < set->count; j++) {
+        if (strcmp(set->columns[j].name, name) == 0) return j;
+    }
+    return -1;
+}
+
+void Derived_Update(DerivedSet *set, TrackingSystem *ts) {
+    Kinematics *kin = set->kinematics;
+    if (!kin) return;
+    if (ts->count > 0) Tracking_UpdatePhysical(ts);
+    Kinematics_Update(kin, ts);
+
+    int first = Kinematics_First(kin);
+    int count = Kinematics_Count(kin);
+    bool ready = count > first && count - first >= KINEMATICS_MIN_SPAN;
+
+    // Lignes à réévaluer : celles que Kinematics a recalculées et les ajouts. Un
+    // changement de paramètre, de définition ou de première image reprend tout.
+    int from = first;
+    int kinFrom;
+    bool sameParams = memcmp(set->params, set->evalParams, sizeof(set->params)) == 0;
+    if (set->synced && set->first == first && set->ready == ready && sameParams &&
+        Kinematics_ChangedSince(kin, set->kinVersion, &kinFrom)) {
+        from = (set->end < count) ? set->end : count;
+        if (kinFrom < from) from = kinFrom;
+        if (from < first) from = first;
+        if (from >= count && set->end == count) {
+            set->kinVersion = Kinematics_Version(kin);
+            return;
+        }
+    }
+
+    if (ready) {
+        const float *inputs[KIN_COLUMN_COUNT + DERIVED_MAX];
+        bool haveInputs = true;
+        for (int c = 0; c < KIN_COLUMN_COUNT; c++) {
+            inputs[c] = Kinematics_Column(kin, (KinematicsColumn)c);
+            if (!inputs[c]) haveInputs = false;
+        }
+        for (int j = 0; j < DERIVED_MAX; j++) inputs[KIN_COLUMN_COUNT + j] = set->columns[j].values;
+        if (!haveInputs) ready = false;
+        // Dans l'ordre de définition : une grandeur peut lire celles qui la précèdent.
+        for (int j = 0; j < set->count && ready; j++) {
+            DerivedColumn *col = &set->columns[j];
+            if (col->valid && col->values) Expr_Eval(&col->program, inputs, set->params, from, count, col->values);
+        }
+    }
+
+    set->first = first;
+    set->end = count;
+    set->ready = ready;
+    memcpy(set->evalParams, set->params, sizeof(set->params));
+    set->kinVersion = Kinematics_Version(kin);
+    set->synced = true;
+    set->version++;
+    set->changedFrom[set->version % DERIVED_HISTORY] = from;
+}
+
+const float* Derived_Values(const DerivedSet *set, int column) {
+    if (column < 0 || column >= set->count || !set->ready) return NULL;
+    const DerivedColumn *col = &set->columns[column];
+    return col->valid ? col->values : NULL;
+}
+
+unsigned int Derived_Version(const DerivedSet *set) {
+    return set->version;
+}
+
+bool Derived_ChangedSince(const DerivedSet *set, unsigned int version, int *from) {
+    unsigned int behind = set->version - version;
+    if (behind >= DERIVED_HISTORY) return false;
+    int lo = set->end;
+    for (unsigned int v = version + 1; v != set->version + 1; v++) {
+        int f = set->changedFrom[v % DERIVED_HISTORY];
+        if (f < lo) lo = f;
+    }
+    *from = lo;
+    return true;
+}
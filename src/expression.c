@@ -0,0 +1,375 @@
+#include "expression.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#define EXPR_MAX_NESTING 64
+#define EXPR_PI 3.14159265358979323846
+
+enum {
+    OP_COLUMN = 0, OP_PARAM, OP_CONST,
+    OP_NEG, OP_SQR,
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,
+    OP_FUNC
+};
+
+enum {
+    FN_SQRT = 0, FN_ABS, FN_EXP, FN_LN, FN_LOG, FN_SIN, FN_COS, FN_TAN, FN_ASIN, FN_ACOS, FN_ATAN,
+    FN_ATAN2, FN_HYPOT, FN_MIN, FN_MAX,
+    FN_COUNT
+};
+
+static const struct { const char *name; int args; } exprFunctions[FN_COUNT] = {
+    [FN_SQRT] = { "sqrt", 1 }, [FN_ABS] = { "abs", 1 }, [FN_EXP] = { "exp", 1 },
+    [FN_LN] = { "ln", 1 }, [FN_LOG] = { "log", 1 },
+    [FN_SIN] = { "sin", 1 }, [FN_COS] = { "cos", 1 }, [FN_TAN] = { "tan", 1 },
+    [FN_ASIN] = { "asin", 1 }, [FN_ACOS] = { "acos", 1 }, [FN_ATAN] = { "atan", 1 },
+    [FN_ATAN2] = { "atan2", 2 }, [FN_HYPOT] = { "hypot", 2 }, [FN_MIN] = { "min", 2 }, [FN_MAX] = { "max", 2 },
+};
+
+typedef struct ExprParser {
+    const char *src;
+    int pos;
+    int nesting;
+    int sp;
+    const ExprSymbols *symbols;
+    ExprProgram *prog;
+    ExprError error;
+    int errorPos;
+} ExprParser;
+
+// --- Évaluation scalaire (repli des constantes) ---
+
+static float ExprFunc1(int fn, float a) {
+    switch (fn) {
+        case FN_SQRT: return sqrtf(a);
+        case FN_ABS: return fabsf(a);
+        case FN_EXP: return expf(a);
+        case FN_LN: return logf(a);
+        case FN_LOG: return log10f(a);
+        case FN_SIN: return sinf(a);
+        case FN_COS: return cosf(a);
+        case FN_TAN: return tanf(a);
+        case FN_ASIN: return asinf(a);
+        case FN_ACOS: return acosf(a);
+        case FN_ATAN: return atanf(a);
+        default: return 0.0f;
+    }
+}
+
+static float ExprFunc2(int fn, float a, float b) {
+    switch (fn) {
+        case FN_ATAN2: return atan2f(a, b);
+        case FN_HYPOT: return hypotf(a, b);
+        case FN_MIN: return fminf(a, b);
+        case FN_MAX: return fmaxf(a, b);
+        default: return 0.0f;
+    }
+}
+
+static float ExprBinary(int code, float a, float b) {
+    switch (code) {
+        case OP_ADD: return a + b;
+        case OP_SUB: return a - b;
+        case OP_MUL: return a * b;
+        case OP_DIV: return a / b;
+        case OP_POW: return powf(a, b);
+        default: return 0.0f;
+    }
+}
+
+// --- Compilation ---
+
+static bool ExprFail(ExprParser *p, ExprError error, int pos) {
+    if (p->error == EXPR_OK) { p->error = error; p->errorPos = pos; }
+    return false;
+}
+
+static int ExprArity(const ExprOp *op) {
+    if (op->code <= OP_CONST) return 0;
+    if (op->code == OP_NEG || op->code == OP_SQR) return 1;
+    if (op->code == OP_FUNC) return exprFunctions[op->arg].args;
+    return 2;
+}
+
+// Ajoute une instruction ; celles dont tous les opérandes sont des constantes
+// sont calculées sur place, et x^2 devient une multiplication.
+static bool ExprEmit(ExprParser *p, unsigned char code, unsigned char arg, float value) {
+    ExprProgram *prog = p->prog;
+    ExprOp op = { code, arg, value };
+    int arity = ExprArity(&op);
+    ExprOp *last = (prog->count > 0) ? &prog->ops[prog->count - 1] : NULL;
+
+    if (code == OP_POW && last && last->code == OP_CONST) {
+        if (last->value == 1.0f) { prog->count--; p->sp--; return true; }
+        if (last->value == 2.0f) { prog->count--; p->sp--; return ExprEmit(p, OP_SQR, 0, 0.0f); }
+        if (last->value == 0.5f) { prog->count--; p->sp--; return ExprEmit(p, OP_FUNC, FN_SQRT, 0.0f); }
+    }
+    if (arity == 1 && last && last->code == OP_CONST) {
+        float a = last->value;
+        last->value = (code == OP_NEG) ? -a : (code == OP_SQR) ? a * a : ExprFunc1(arg, a);
+        return true;
+    }
+    if (arity == 2 && prog->count >= 2 && last->code == OP_CONST && prog->ops[prog->count - 2].code == OP_CONST) {
+        ExprOp *left = &prog->ops[prog->count - 2];
+        left->value = (code == OP_FUNC) ? ExprFunc2(arg, left->value, last->value) : ExprBinary(code, left->value, last->value);
+        prog->count--;
+        p->sp--;
+        return true;
+    }
+
+    if (prog->count >= EXPR_MAX_OPS) return ExprFail(p, EXPR_ERR_COMPLEX, p->pos);
+    p->sp += 1 - arity;
+    if (p->sp > EXPR_MAX_STACK) return ExprFail(p, EXPR_ERR_COMPLEX, p->pos);
+    if (p->sp > prog->depth) prog->depth = p->sp;
+    prog->ops[prog->count++] = op;
+    return true;
+}
+
+static char ExprPeek(ExprParser *p) {
+    while (p->src[p->pos] == ' ' || p->src[p->pos] == '\t') p->pos++;
+    return p->src[p->pos];
+}
+
+static int ExprFindName(const char *const *names, int count, const char *name) {
+    if (!names) return -1;
+    for (int i = 0; i < count; i++) {
+        if (names[i] && names[i][0] != '\0' && strcmp(names[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+static int ExprFindFunction(const char *name) {
+    for (int i = 0; i < FN_COUNT; i++) {
+        if (strcmp(exprFunctions[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+static bool ExprParseSum(ExprParser *p);
+static bool ExprParseUnary(ExprParser *p);
+
+static bool ExprParseCall(ExprParser *p, const char *name, int namePos) {
+    int fn = ExprFindFunction(name);
+    if (fn < 0) return ExprFail(p, EXPR_ERR_UNKNOWN, namePos);
+    int open = p->pos++;
+    int args = 0;
+    if (ExprPeek(p) != ')') {
+        do {
+            if (args > 0) p->pos++;
+            if (!ExprParseSum(p)) return false;
+            args++;
+        } while (ExprPeek(p) == ',');
+    }
+    if (ExprPeek(p) != ')') return ExprFail(p, p->src[p->pos] ? EXPR_ERR_SYNTAX : EXPR_ERR_PAREN, p->src[p->pos] ? p->pos : open);
+    p->pos++;
+    if (args != exprFunctions[fn].args) return ExprFail(p, EXPR_ERR_ARGS, namePos);
+    return ExprEmit(p, OP_FUNC, (unsigned char)fn, 0.0f);
+}
+
+static bool ExprParsePrimary(ExprParser *p) {
+    char c = ExprPeek(p);
+    int start = p->pos;
+
+    if (isdigit((unsigned char)c) || (c == '.' && isdigit((unsigned char)p->src[start + 1]))) {
+        char *end = NULL;
+        double v = strtod(p->src + start, &end);
+        p->pos = (int)(end - p->src);
+        return ExprEmit(p, OP_CONST, 0, (float)v);
+    }
+
+    if (isalpha((unsigned char)c) || c == '_') {
+        char name[32];
+        int len = 0;
+        while (isalnum((unsigned char)p->src[p->pos]) || p->src[p->pos] == '_') {
+            if (len < (int)sizeof(name) - 1) name[len] = p->src[p->pos];
+            len++;
+            p->pos++;
+        }
+        if (len >= (int)sizeof(name)) return ExprFail(p, EXPR_ERR_UNKNOWN, start);
+        name[len] = '\0';
+
+        if (ExprPeek(p) == '(') return ExprParseCall(p, name, start);
+        const ExprSymbols *sym = p->symbols;
+        int idx = ExprFindName(sym->columns, sym->columnCount, name);
+        if (idx >= 0) return ExprEmit(p, OP_COLUMN, (unsigned char)idx, 0.0f);
+        idx = ExprFindName(sym->params, sym->paramCount, name);
+        if (idx >= 0) return ExprEmit(p, OP_PARAM, (unsigned char)idx, 0.0f);
+        if (strcmp(name, "pi") == 0) return ExprEmit(p, OP_CONST, 0, (float)EXPR_PI);
+        return ExprFail(p, EXPR_ERR_UNKNOWN, start);
+    }
+
+    if (c == '(') {
+        if (++p->nesting > EXPR_MAX_NESTING) return ExprFail(p, EXPR_ERR_COMPLEX, start);
+        p->pos++;
+        if (!ExprParseSum(p)) return false;
+        if (ExprPeek(p) != ')') return ExprFail(p, p->src[p->pos] ? EXPR_ERR_SYNTAX : EXPR_ERR_PAREN, p->src[p->pos] ? p->pos : start);
+        p->pos++;
+        p->nesting--;
+        return true;
+    }
+
+    return ExprFail(p, EXPR_ERR_SYNTAX, start);
+}
+
+// Puissance associative à droite ; l'exposant peut porter un signe (2^-1).
+static bool ExprParsePower(ExprParser *p) {
+    if (!ExprParsePrimary(p)) return false;
+    if (ExprPeek(p) != '^') return true;
+    p->pos++;
+    if (!ExprParseUnary(p)) return false;
+    return ExprEmit(p, OP_POW, 0, 0.0f);
+}
+
+// -x^2 vaut -(x^2).
+static bool ExprParseUnary(ExprParser *p) {
+    char c = ExprPeek(p);
+    if (c == '-' || c == '+') {
+        if (++p->nesting > EXPR_MAX_NESTING) return ExprFail(p, EXPR_ERR_COMPLEX, p->pos);
+        p->pos++;
+        if (!ExprParseUnary(p)) return false;
+        p->nesting--;
+        return (c == '-') ? ExprEmit(p, OP_NEG, 0, 0.0f) : true;
+    }
+    return ExprParsePower(p);
+}
+
+static bool ExprParseProduct(ExprParser *p) {
+    if (!ExprParseUnary(p)) return false;
+    for (;;) {
+        char c = ExprPeek(p);
+        if (c != '*' && c != '/') return true;
+        p->pos++;
+        if (!ExprParseUnary(p)) return false;
+        if (!ExprEmit(p, (c == '*') ? OP_MUL : OP_DIV, 0, 0.0f)) return false;
+    }
+}
+
+static bool ExprParseSum(ExprParser *p) {
+    if (!ExprParseProduct(p)) return false;
+    for (;;) {
+        char c = ExprPeek(p);
+        if (c != '+' && c != '-') return true;
+        p->pos++;
+        if (!ExprParseProduct(p)) return false;
+        if (!ExprEmit(p, (c == '+') ? OP_ADD : OP_SUB, 0, 0.0f)) return false;
+    }
+}
+
+bool Expr_Compile(const char *source, const ExprSymbols *symbols, ExprProgram *out, ExprError *error, int *errorPos) {
+    ExprParser p = { 0 };
+    p.src = source ? source : "";
+    p.symbols = symbols;
+    p.prog = out;
+    out->count = 0;
+    out->depth = 0;
+
+    if (ExprPeek(&p) == '\0') ExprFail(&p, EXPR_ERR_EMPTY, p.pos);
+    else if (ExprParseSum(&p) && ExprPeek(&p) != '\0') ExprFail(&p, EXPR_ERR_SYNTAX, p.pos);
+
+    if (error) *error = p.error;
+    if (errorPos) *errorPos = p.errorPos;
+    if (p.error != EXPR_OK) out->count = 0;
+    return p.error == EXPR_OK;
+}
+
+// --- Évaluation par blocs ---
+
+#define EXPR_MAP1(f) for (int i = 0; i < n; i++) dst[i] = f(a[i])
+#define EXPR_MAP2(f) for (int i = 0; i < n; i++) dst[i] = f(a[i], b[i])
+
+// Une passe par instruction sur tout le bloc : les boucles n'ont ni branche ni
+// appel indirect et se vectorisent. Les colonnes sont lues en place.
+void Expr_Eval(const ExprProgram *program, const float *const *columns, const float *params, int begin, int end, float *out) {
+    if (program->count == 0 || begin >= end) return;
+    float regs[EXPR_MAX_STACK][EXPR_BLOCK];
+    const float *stack[EXPR_MAX_STACK];
+
+    for (int base = begin; base < end; base += EXPR_BLOCK) {
+        int n = (end - base < EXPR_BLOCK) ? end - base : EXPR_BLOCK;
+        int sp = 0;
+        for (int k = 0; k < program->count; k++) {
+            const ExprOp *op = &program->ops[k];
+            switch (op->code) {
+                case OP_COLUMN:
+                    stack[sp++] = columns[op->arg] + base;
+                    break;
+                case OP_PARAM:
+                case OP_CONST: {
+                    float v = (op->code == OP_PARAM) ? params[op->arg] : op->value;
+                    float *dst = regs[sp];
+                    for (int i = 0; i < n; i++) dst[i] = v;
+                    stack[sp++] = dst;
+                    break;
+                }
+                case OP_NEG: {
+                    const float *a = stack[sp - 1]; float *dst = regs[sp - 1];
+                    for (int i = 0; i < n; i++) dst[i] = -a[i];
+                    stack[sp - 1] = dst;
+                    break;
+                }
+                case OP_SQR: {
+                    const float *a = stack[sp - 1]; float *dst = regs[sp - 1];
+                    for (int i = 0; i < n; i++) dst[i] = a[i] * a[i];
+                    stack[sp - 1] = dst;
+                    break;
+                }
+                case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_POW: {
+                    const float *a = stack[sp - 2], *b = stack[sp - 1]; float *dst = regs[sp - 2];
+                    switch (op->code) {
+                        case OP_ADD: for (int i = 0; i < n; i++) dst[i] = a[i] + b[i]; break;
+                        case OP_SUB: for (int i = 0; i < n; i++) dst[i] = a[i] - b[i]; break;
+                        case OP_MUL: for (int i = 0; i < n; i++) dst[i] = a[i] * b[i]; break;
+                        case OP_DIV: for (int i = 0; i < n; i++) dst[i] = a[i] / b[i]; break;
+                        default: EXPR_MAP2(powf); break;
+                    }
+                    stack[--sp - 1] = dst;
+                    break;
+                }
+                case OP_FUNC: {
+                    if (exprFunctions[op->arg].args == 1) {
+                        const float *a = stack[sp - 1]; float *dst = regs[sp - 1];
+                        switch (op->arg) {
+                            case FN_SQRT: EXPR_MAP1(sqrtf); break;
+                            case FN_ABS: EXPR_MAP1(fabsf); break;
+                            case FN_EXP: EXPR_MAP1(expf); break;
+                            case FN_LN: EXPR_MAP1(logf); break;
+                            case FN_LOG: EXPR_MAP1(log10f); break;
+                            case FN_SIN: EXPR_MAP1(sinf); break;
+                            case FN_COS: EXPR_MAP1(cosf); break;
+                            case FN_TAN: EXPR_MAP1(tanf); break;
+                            case FN_ASIN: EXPR_MAP1(asinf); break;
+                            case FN_ACOS: EXPR_MAP1(acosf); break;
+                            default: EXPR_MAP1(atanf); break;
+                        }
+                        stack[sp - 1] = dst;
+                    } else {
+                        const float *a = stack[sp - 2], *b = stack[sp - 1]; float *dst = regs[sp - 2];
+                        switch (op->arg) {
+                            case FN_ATAN2: EXPR_MAP2(atan2f); break;
+                            case FN_HYPOT: EXPR_MAP2(hypotf); break;
+                            case FN_MIN: EXPR_MAP2(fminf); break;
+                            default: EXPR_MAP2(fmaxf); break;
+                        }
+                        stack[--sp - 1] = dst;
+                    }
+                    break;
+                }
+            }
+        }
+        if (stack[0] != out + base) memcpy(out + base, stack[0], (size_t)n * sizeof(float));
+    }
+}
+
+bool Expr_IsIdentifier(const char *name) {
+    if (!name || !(isalpha((unsigned char)name[0]) || name[0] == '_')) return false;
+    for (const char *c = name; *c; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') return false;
+    }
+    return true;
+}
+
+bool Expr_IsReserved(const char *name) {
+    return strcmp(name, "pi") == 0 || ExprFindFunction(name) >= 0;
+}
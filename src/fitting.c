@@ -0,0 +1,640 @@
+#include "fitting.h"
+#include "job_system.h"
+#include "latest_job.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+#define FIT_LM_MAX_ITERATIONS 200
+#define FIT_OSC_SCAN_STEPS 160
+#define FIT_PI 3.14159265358979323846
+
+static int Fit_ModelParamCount(FitModel model) {
+    switch (model) {
+        case FIT_DAMPED_OSCILLATOR: return 5;
+        case FIT_EXP_DECAY: return 3;
+        case FIT_PROJECTILE_DRAG: return 4;
+        default: return 0;
+    }
+}
+
+const char* Fit_ParamName(FitModel model, int index) {
+    static const char *poly[FIT_MAX_PARAMS] = { "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7", "a8" };
+    static const char *osc[] = { "A", "gamma", "omega", "phi", "c" };
+    static const char *decay[] = { "A", "tau", "c" };
+    static const char *proj[] = { "y0", "v0", "vt", "k" };
+    if (index < 0) return "";
+    switch (model) {
+        case FIT_POLYNOMIAL: return (index < FIT_MAX_PARAMS) ? poly[index] : "";
+        case FIT_DAMPED_OSCILLATOR: return (index < 5) ? osc[index] : "";
+        case FIT_EXP_DECAY: return (index < 3) ? decay[index] : "";
+        case FIT_PROJECTILE_DRAG: return (index < 4) ? proj[index] : "";
+        default: return "";
+    }
+}
+
+static double Fit_ModelEval(FitModel model, const double *p, double t) {
+    switch (model) {
+        case FIT_DAMPED_OSCILLATOR:
+            return p[0] * exp(-p[1] * t) * cos(p[2] * t + p[3]) + p[4];
+        case FIT_EXP_DECAY:
+            return p[0] * exp(-t / p[1]) + p[2];
+        case FIT_PROJECTILE_DRAG: {
+            // (1 - e^(-kt))/k tend vers t sans traînée : développement limité près de 0.
+            double kt = p[3] * t;
+            double g = (fabs(kt) < 1e-8) ? t * (1.0 - 0.5 * kt) : -expm1(-kt) / p[3];
+            return p[0] + p[2] * t + (p[1] - p[2]) * g;
+        }
+        default:
+            return 0.0;
+    }
+}
+
+double Fit_Eval(const FitResult *fit, double x) {
+    if (!fit->valid) return 0.0;
+    if (fit->model == FIT_POLYNOMIAL) {
+        double u = (x - fit->xCenter) / fit->xScale;
+        double v = 0.0;
+        for (int k = fit->degree; k >= 0; k--) v = v * u + fit->basis[k];
+        return v;
+    }
+    return Fit_ModelEval(fit->model, fit->params, x - fit->xCenter);
+}
+
+// Système linéaire n x n par Gauss avec pivot partiel ; 'a' et 'b' sont écrasés.
+static bool SolveLinear(double *a, double *b, double *x, int n) {
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < n; r++) {
+            if (fabs(a[r * n + col]) > fabs(a[pivot * n + col])) pivot = r;
+        }
+        if (fabs(a[pivot * n + col]) < 1e-300) return false;
+        if (pivot != col) {
+            for (int k = 0; k < n; k++) { double t = a[col * n + k]; a[col * n + k] = a[pivot * n + k]; a[pivot * n + k] = t; }
+            double t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+        }
+        for (int r = col + 1; r < n; r++) {
+            double f = a[r * n + col] / a[col * n + col];
+            for (int k = col; k < n; k++) a[r * n + k] -= f * a[col * n + k];
+            b[r] -= f * b[col];
+        }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double s = b[i];
+        for (int k = i + 1; k < n; k++) s -= a[i * n + k] * x[k];
+        x[i] = s / a[i * n + i];
+    }
+    return true;
+}
+
+static bool InvertSymmetric(const double *a, double *inv, int n) {
+    double work[FIT_MAX_PARAMS * FIT_MAX_PARAMS], col[FIT_MAX_PARAMS], res[FIT_MAX_PARAMS];
+    for (int c = 0; c < n; c++) {
+        memcpy(work, a, (size_t)n * n * sizeof(double));
+        for (int i = 0; i < n; i++) col[i] = (i == c) ? 1.0 : 0.0;
+        if (!SolveLinear(work, col, res, n)) return false;
+        for (int i = 0; i < n; i++) inv[i * n + c] = res[i];
+    }
+    return true;
+}
+
+static void Fit_Statistics(FitResult *out, const float *y, int count, double ssRes) {
+    double mean = 0.0;
+    for (int i = 0; i < count; i++) mean += y[i];
+    mean /= count;
+    double ssTot = 0.0;
+    for (int i = 0; i < count; i++) ssTot += (y[i] - mean) * (y[i] - mean);
+    out->rSquared = (ssTot < 1e-300) ? 1.0 : 1.0 - ssRes / ssTot;
+    out->rmse = sqrt(ssRes / count);
+}
+
+// QR de Householder sur la matrice de Vandermonde de u = (x - xc) / xs : le
+// conditionnement ne dépend plus de l'origine des temps, contrairement aux
+// équations normales.
+bool Fit_Polynomial(const float *x, const float *y, int count, int degree, FitResult *out) {
+    memset(out, 0, sizeof(FitResult));
+    out->model = FIT_POLYNOMIAL;
+    if (degree < 1) degree = 1;
+    if (degree > FIT_MAX_DEGREE) degree = FIT_MAX_DEGREE;
+    int m = degree + 1, n = count;
+    out->degree = degree;
+    out->paramCount = m;
+    if (n <= m) return false;
+
+    double xc = 0.0;
+    for (int i = 0; i < n; i++) xc += x[i];
+    xc /= n;
+    double xs = 0.0;
+    for (int i = 0; i < n; i++) if (fabs(x[i] - xc) > xs) xs = fabs(x[i] - xc);
+    if (xs < 1e-12) return false;
+    out->xCenter = xc;
+    out->xScale = xs;
+
+    double *a = (double *)malloc((size_t)n * m * sizeof(double));
+    double *b = (double *)malloc((size_t)n * sizeof(double));
+    if (!a || !b) { free(a); free(b); return false; }
+    for (int i = 0; i < n; i++) {
+        double u = (x[i] - xc) / xs, p = 1.0;
+        for (int j = 0; j < m; j++) { a[i * m + j] = p; p *= u; }
+        b[i] = y[i];
+    }
+
+    double rdiag[FIT_MAX_PARAMS];
+    bool ok = true;
+    for (int k = 0; k < m && ok; k++) {
+        double norm = 0.0;
+        for (int i = k; i < n; i++) norm += a[i * m + k] * a[i * m + k];
+        norm = sqrt(norm);
+        if (norm < 1e-12) { ok = false; break; }
+        double alpha = (a[k * m + k] > 0) ? -norm : norm;
+        a[k * m + k] -= alpha;
+        double vnorm2 = 0.0;
+        for (int i = k; i < n; i++) vnorm2 += a[i * m + k] * a[i * m + k];
+        rdiag[k] = alpha;
+        if (vnorm2 < 1e-300) continue;
+        for (int j = k + 1; j < m; j++) {
+            double s = 0.0;
+            for (int i = k; i < n; i++) s += a[i * m + k] * a[i * m + j];
+            s *= 2.0 / vnorm2;
+            for (int i = k; i < n; i++) a[i * m + j] -= s * a[i * m + k];
+        }
+        double s = 0.0;
+        for (int i = k; i < n; i++) s += a[i * m + k] * b[i];
+        s *= 2.0 / vnorm2;
+        for (int i = k; i < n; i++) b[i] -= s * a[i * m + k];
+    }
+
+    // R⁻¹ (triangulaire supérieure) pour la solution et la covariance.
+    double rinv[FIT_MAX_PARAMS * FIT_MAX_PARAMS] = { 0 };
+    if (ok) {
+        for (int j = m - 1; j >= 0; j--) {
+            rinv[j * m + j] = 1.0 / rdiag[j];
+            for (int i = j - 1; i >= 0; i--) {
+                double s = 0.0;
+                for (int k = i + 1; k <= j; k++) s += a[i * m + k] * rinv[k * m + j];
+                rinv[i * m + j] = -s / rdiag[i];
+            }
+        }
+        for (int i = 0; i < m; i++) {
+            double s = 0.0;
+            for (int k = i; k < m; k++) s += rinv[i * m + k] * b[k];
+            out->basis[i] = s;
+        }
+    }
+    free(a);
+    free(b);
+    if (!ok) return false;
+
+    out->valid = true;
+    double ssRes = 0.0;
+    for (int i = 0; i < n; i++) {
+        double r = y[i] - Fit_Eval(out, x[i]);
+        ssRes += r * r;
+    }
+    Fit_Statistics(out, y, n, ssRes);
+
+    // Covariance s²(RᵀR)⁻¹ en u, puis passage aux coefficients de x^k :
+    // c_k = Σ_j b_j C(j,k) (-xc)^(j-k) / xs^j.
+    double s2 = ssRes / (n - m);
+    double covU[FIT_MAX_PARAMS * FIT_MAX_PARAMS], t[FIT_MAX_PARAMS * FIT_MAX_PARAMS] = { 0 };
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            double s = 0.0;
+            for (int k = (i > j ? i : j); k < m; k++) s += rinv[i * m + k] * rinv[j * m + k];
+            covU[i * m + j] = s2 * s;
+        }
+    }
+    for (int j = 0; j < m; j++) {
+        double binom = 1.0;
+        for (int k = j; k >= 0; k--) {
+            // binom = C(j, k)
+            t[k * m + j] = binom * pow(-xc, j - k) / pow(xs, j);
+            binom = binom * k / (j - k + 1);
+        }
+    }
+    for (int k = 0; k < m; k++) {
+        double c = 0.0;
+        for (int j = 0; j < m; j++) c += t[k * m + j] * out->basis[j];
+        out->params[k] = c;
+        double var = 0.0;
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < m; j++) var += t[k * m + i] * covU[i * m + j] * t[k * m + j];
+        }
+        out->sigma[k] = sqrt(fabs(var));
+    }
+    return true;
+}
+
+static double Fit_Residuals(FitModel model, const double *p, const double *t, const float *y, int n, double *r) {
+    double ss = 0.0;
+    for (int i = 0; i < n; i++) {
+        double v = y[i] - Fit_ModelEval(model, p, t[i]);
+        if (r) r[i] = v;
+        ss += v * v;
+    }
+    return isfinite(ss) ? ss : INFINITY;
+}
+
+// Oscillateur : balayage de ω avec, pour chacun, a cos ωt + b sin ωt + c linéaire.
+static void Fit_GuessOscillator(const double *t, const float *y, int n, double span, double *p) {
+    double wMin = FIT_PI / span, wMax = FIT_PI * (n - 1) / span;
+    double bestSS = INFINITY;
+    p[0] = 0.0; p[1] = 0.0; p[2] = 2.0 * FIT_PI / span; p[3] = 0.0; p[4] = 0.0;
+    for (int s = 0; s < FIT_OSC_SCAN_STEPS; s++) {
+        double w = wMin * pow(wMax / wMin, (double)s / (FIT_OSC_SCAN_STEPS - 1));
+        double ata[9] = { 0 }, atb[3] = { 0 }, coef[3];
+        for (int i = 0; i < n; i++) {
+            double row[3] = { cos(w * t[i]), sin(w * t[i]), 1.0 };
+            for (int a = 0; a < 3; a++) {
+                atb[a] += row[a] * y[i];
+                for (int b = 0; b < 3; b++) ata[a * 3 + b] += row[a] * row[b];
+            }
+        }
+        if (!SolveLinear(ata, atb, coef, 3)) continue;
+        double ss = 0.0;
+        for (int i = 0; i < n; i++) {
+            double r = y[i] - (coef[0] * cos(w * t[i]) + coef[1] * sin(w * t[i]) + coef[2]);
+            ss += r * r;
+        }
+        if (ss < bestSS) {
+            bestSS = ss;
+            p[0] = hypot(coef[0], coef[1]);
+            p[2] = w;
+            p[3] = atan2(-coef[1], coef[0]);
+            p[4] = coef[2];
+        }
+    }
+}
+
+static void Fit_InitialGuess(FitModel model, const double *t, const float *y, int n, double span, double *p) {
+    switch (model) {
+        case FIT_DAMPED_OSCILLATOR:
+            Fit_GuessOscillator(t, y, n, span, p);
+            break;
+        case FIT_EXP_DECAY: {
+            int last = 0, first = 0;
+            for (int i = 1; i < n; i++) {
+                if (t[i] > t[last]) last = i;
+                if (t[i] < t[first]) first = i;
+            }
+            p[2] = y[last];
+            p[0] = y[first] - y[last];
+            if (fabs(p[0]) < 1e-12) p[0] = 1e-3;
+            p[1] = span / 3.0;
+            break;
+        }
+        case FIT_PROJECTILE_DRAG: {
+            // Sans traînée, y ≈ y0 + v0 t + a t² et a = k (vt - v0) / 2.
+            FitResult quad;
+            p[0] = 0.0; p[1] = 0.0; p[3] = 0.1 / span; p[2] = 0.0;
+            float *tf = (float *)malloc((size_t)n * sizeof(float));
+            if (!tf) break;
+            for (int i = 0; i < n; i++) tf[i] = (float)t[i];
+            if (Fit_Polynomial(tf, y, n, 2, &quad)) {
+                p[0] = quad.params[0];
+                p[1] = quad.params[1];
+                p[2] = p[1] + 2.0 * quad.params[2] / p[3];
+            }
+            free(tf);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Valeur du modèle et dérivées partielles analytiques.
+static double Fit_ModelGradient(FitModel model, const double *p, double t, double *grad) {
+    switch (model) {
+        case FIT_DAMPED_OSCILLATOR: {
+            double e = exp(-p[1] * t), c = cos(p[2] * t + p[3]), s = sin(p[2] * t + p[3]);
+            grad[0] = e * c;
+            grad[1] = -t * p[0] * e * c;
+            grad[2] = -t * p[0] * e * s;
+            grad[3] = -p[0] * e * s;
+            grad[4] = 1.0;
+            return p[0] * e * c + p[4];
+        }
+        case FIT_EXP_DECAY: {
+            double e = exp(-t / p[1]);
+            grad[0] = e;
+            grad[1] = p[0] * e * t / (p[1] * p[1]);
+            grad[2] = 1.0;
+            return p[0] * e + p[2];
+        }
+        case FIT_PROJECTILE_DRAG: {
+            double k = p[3], kt = k * t, g, dg;
+            if (fabs(kt) < 1e-4) {
+                g = t * (1.0 - kt / 2.0 + kt * kt / 6.0);
+                dg = t * t * (-0.5 + kt / 3.0);
+            } else {
+                double e = exp(-kt);
+                g = (1.0 - e) / k;
+                dg = (t * e - g) / k;
+            }
+            grad[0] = 1.0;
+            grad[1] = g;
+            grad[2] = t - g;
+            grad[3] = (p[1] - p[2]) * dg;
+            return p[0] + p[2] * t + (p[1] - p[2]) * g;
+        }
+        default:
+            return 0.0;
+    }
+}
+
+// JᵀJ et Jᵀr, avec J = ∂f/∂p ligne par ligne.
+static void Fit_NormalEquations(FitModel model, const double *p, const double *t, const double *r, int n, int np, double *jtj, double *jtr) {
+    for (int a = 0; a < np; a++) {
+        jtr[a] = 0.0;
+        for (int b = 0; b < np; b++) jtj[a * np + b] = 0.0;
+    }
+    double row[FIT_MAX_PARAMS];
+    for (int i = 0; i < n; i++) {
+        Fit_ModelGradient(model, p, t[i], row);
+        for (int a = 0; a < np; a++) {
+            jtr[a] += row[a] * r[i];
+            for (int b = a; b < np; b++) jtj[a * np + b] += row[a] * row[b];
+        }
+    }
+    for (int a = 0; a < np; a++) {
+        for (int b = 0; b < a; b++) jtj[a * np + b] = jtj[b * np + a];
+    }
+}
+
+// 'start' == NULL : estimation initiale tirée des données. Les temps sont
+// comptés depuis 'origin' pour que les paramètres restent comparables entre refits.
+static bool Fit_Levenberg(FitModel model, const float *x, const float *y, int count, double origin, const double *start, bool withCovariance, FitResult *out) {
+    memset(out, 0, sizeof(FitResult));
+    out->model = model;
+    int np = Fit_ModelParamCount(model), n = count;
+    out->paramCount = np;
+    if (np == 0 || n <= np) return false;
+
+    double xMin = x[0], xMax = x[0];
+    for (int i = 1; i < n; i++) { if (x[i] < xMin) xMin = x[i]; if (x[i] > xMax) xMax = x[i]; }
+    double span = xMax - xMin;
+    if (span < 1e-12) return false;
+    out->xCenter = origin;
+    out->xScale = 1.0;
+
+    double *t = (double *)malloc((size_t)n * sizeof(double));
+    double *r = (double *)malloc((size_t)n * sizeof(double));
+    if (!t || !r) { free(t); free(r); return false; }
+    for (int i = 0; i < n; i++) t[i] = x[i] - origin;
+
+    double p[FIT_MAX_PARAMS] = { 0 };
+    if (start) memcpy(p, start, (size_t)np * sizeof(double));
+    else Fit_InitialGuess(model, t, y, n, span, p);
+
+    double jtj[FIT_MAX_PARAMS * FIT_MAX_PARAMS], jtr[FIT_MAX_PARAMS];
+    double ss = Fit_Residuals(model, p, t, y, n, r);
+    double lambda = 1e-3;
+    int iter = 0;
+    bool ok = isfinite(ss);
+
+    while (ok && iter < FIT_LM_MAX_ITERATIONS) {
+        Fit_NormalEquations(model, p, t, r, n, np, jtj, jtr);
+        iter++;
+
+        bool accepted = false, converged = false;
+        while (!accepted && !converged) {
+            double damped[FIT_MAX_PARAMS * FIT_MAX_PARAMS], rhs[FIT_MAX_PARAMS], step[FIT_MAX_PARAMS];
+            memcpy(damped, jtj, (size_t)np * np * sizeof(double));
+            memcpy(rhs, jtr, (size_t)np * sizeof(double));
+            for (int a = 0; a < np; a++) damped[a * np + a] += lambda * (jtj[a * np + a] + 1e-12);
+
+            double trial[FIT_MAX_PARAMS];
+            memcpy(trial, p, sizeof(p));
+            double trialSS = INFINITY;
+            bool tinyStep = true;
+            if (SolveLinear(damped, rhs, step, np)) {
+                for (int a = 0; a < np; a++) {
+                    trial[a] += step[a];
+                    if (fabs(step[a]) > 1e-10 * (fabs(p[a]) + 1e-10)) tinyStep = false;
+                }
+                trialSS = Fit_Residuals(model, trial, t, y, n, NULL);
+            }
+            if (trialSS < ss) {
+                converged = tinyStep || (ss - trialSS) <= 1e-10 * ss;
+                memcpy(p, trial, sizeof(p));
+                ss = Fit_Residuals(model, p, t, y, n, r);
+                lambda = fmax(lambda * 0.1, 1e-12);
+                accepted = true;
+            } else {
+                lambda *= 10.0;
+                converged = tinyStep || (lambda > 1e12);
+            }
+        }
+        if (converged) break;
+    }
+    if (ok) {
+        memcpy(out->params, p, sizeof(p));
+        out->iterations = iter;
+        out->valid = true;
+        Fit_Statistics(out, y, n, ss);
+    }
+    if (ok && withCovariance) {
+        // Jacobienne au point final pour la covariance s²(JᵀJ)⁻¹.
+        double cov[FIT_MAX_PARAMS * FIT_MAX_PARAMS];
+        Fit_NormalEquations(model, p, t, r, n, np, jtj, jtr);
+        double s2 = ss / (n - np);
+        bool hasCov = InvertSymmetric(jtj, cov, np);
+        for (int a = 0; a < np; a++) out->sigma[a] = hasCov ? sqrt(fabs(s2 * cov[a * np + a])) : NAN;
+    }
+    free(t);
+    free(r);
+    return ok;
+}
+
+bool Fit_Nonlinear(FitModel model, const float *x, const float *y, int count, FitResult *out) {
+    if (count < 1) {
+        memset(out, 0, sizeof(FitResult));
+        out->model = model;
+        return false;
+    }
+    double xMin = x[0];
+    for (int i = 1; i < count; i++) if (x[i] < xMin) xMin = x[i];
+    return Fit_Levenberg(model, x, y, count, xMin, NULL, true, out);
+}
+
+bool Fit_Run(FitModel model, int degree, const float *x, const float *y, int count, FitResult *out) {
+    if (model == FIT_POLYNOMIAL) return Fit_Polynomial(x, y, count, degree, out);
+    return Fit_Nonlinear(model, x, y, count, out);
+}
+
+bool Fit_Refit(const FitResult *base, const float *x, const float *y, int count, FitResult *out) {
+    if (base->model == FIT_POLYNOMIAL) return Fit_Polynomial(x, y, count, base->degree, out);
+    return Fit_Levenberg(base->model, x, y, count, base->xCenter, base->params, false, out);
+}
+
+typedef struct {
+    const FitResult *base;
+    BootstrapMode mode;
+    const float *x;
+    const float *y;
+    const float *model;   // valeurs ajustées, pour BOOT_JITTER
+    int count;
+    double *samples;      // [réplique][paramètre], NAN si le refit a échoué
+} BootstrapContext;
+
+// Générateur par réplique (splitmix64) : résultats identiques quel que soit le découpage.
+static uint64_t Boot_Next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static double Boot_Uniform(uint64_t *state) {
+    return ((Boot_Next(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static void Bootstrap_Range(void *ctx, int begin, int end) {
+    BootstrapContext *bc = (BootstrapContext *)ctx;
+    int n = bc->count, np = bc->base->paramCount;
+    float *rx = (float *)malloc((size_t)n * sizeof(float));
+    float *ry = (float *)malloc((size_t)n * sizeof(float));
+
+    for (int rep = begin; rep < end; rep++) {
+        double *dst = bc->samples + (size_t)rep * np;
+        for (int k = 0; k < np; k++) dst[k] = NAN;
+        if (!rx || !ry) continue;
+
+        uint64_t rng = 0x5DEECE66Dull * (uint64_t)(rep + 1);
+        if (bc->mode == BOOT_RESAMPLE) {
+            for (int i = 0; i < n; i++) {
+                int idx = (int)(Boot_Next(&rng) % (uint64_t)n);
+                rx[i] = bc->x[idx];
+                ry[i] = bc->y[idx];
+            }
+        } else {
+            double sigma = bc->base->rmse;
+            for (int i = 0; i < n; i += 2) {
+                // Box-Muller : deux tirages gaussiens par paire d'uniformes.
+                double r = sqrt(-2.0 * log(Boot_Uniform(&rng))), a = 2.0 * FIT_PI * Boot_Uniform(&rng);
+                rx[i] = bc->x[i];
+                ry[i] = (float)(bc->model[i] + sigma * r * cos(a));
+                if (i + 1 < n) {
+                    rx[i + 1] = bc->x[i + 1];
+                    ry[i + 1] = (float)(bc->model[i + 1] + sigma * r * sin(a));
+                }
+            }
+        }
+
+        FitResult refit;
+        if (Fit_Refit(bc->base, rx, ry, n, &refit)) memcpy(dst, refit.params, (size_t)np * sizeof(double));
+    }
+    free(rx);
+    free(ry);
+}
+
+static int CompareDouble(const void *a, const void *b) {
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+bool Fit_Bootstrap(FitResult *base, BootstrapMode mode, int replicates, const float *x, const float *y, int count) {
+    memset(&base->interval, 0, sizeof(FitInterval));
+    int np = base->paramCount;
+    if (!base->valid || mode == BOOT_OFF || replicates < 2 || np <= 0) return false;
+
+    double *samples = (double *)malloc((size_t)replicates * np * sizeof(double));
+    double *column = (double *)malloc((size_t)replicates * sizeof(double));
+    float *fitted = (float *)malloc((size_t)count * sizeof(float));
+    if (!samples || !column || !fitted) { free(samples); free(column); free(fitted); return false; }
+    for (int i = 0; i < count; i++) fitted[i] = (float)Fit_Eval(base, x[i]);
+
+    BootstrapContext ctx = { base, mode, x, y, fitted, count, samples };
+    Job_ParallelFor(replicates, 8, Bootstrap_Range, &ctx);
+
+    FitInterval *iv = &base->interval;
+    for (int k = 0; k < np; k++) {
+        int m = 0;
+        double mean = 0.0;
+        for (int rep = 0; rep < replicates; rep++) {
+            double v = samples[(size_t)rep * np + k];
+            if (isfinite(v)) { column[m++] = v; mean += v; }
+        }
+        if (m < 2) { free(samples); free(column); free(fitted); return false; }
+        mean /= m;
+        double var = 0.0;
+        for (int i = 0; i < m; i++) var += (column[i] - mean) * (column[i] - mean);
+        qsort(column, m, sizeof(double), CompareDouble);
+        iv->lo[k] = column[(int)floor(0.025 * (m - 1))];
+        iv->hi[k] = column[(int)ceil(0.975 * (m - 1))];
+        iv->stdDev[k] = sqrt(var / (m - 1));
+        if (iv->replicates == 0 || m < iv->replicates) iv->replicates = m;
+    }
+    iv->valid = true;
+    free(samples);
+    free(column);
+    free(fitted);
+    return true;
+}
+
+typedef struct {
+    FitModel model;
+    int degree;
+    BootstrapMode boot;
+    FitKey key;
+} FitParams;
+
+struct FitEngine {
+    LatestJob *job;
+    FitResult jobResult;
+    FitResult result;
+    bool hasResult;
+};
+
+static void FitEngine_Run(void *ctx, const void *params, int key, float *x, float *y, int count) {
+    (void)key;
+    FitEngine *engine = (FitEngine *)ctx;
+    const FitParams *p = (const FitParams *)params;
+    if (Fit_Run(p->model, p->degree, x, y, count, &engine->jobResult)) {
+        Fit_Bootstrap(&engine->jobResult, p->boot, FIT_BOOTSTRAP_REPLICATES, x, y, count);
+    }
+    engine->jobResult.key = p->key;
+}
+
+static void FitEngine_Collect(void *ctx) {
+    FitEngine *engine = (FitEngine *)ctx;
+    engine->result = engine->jobResult;
+    engine->hasResult = true;
+}
+
+FitEngine* FitEngine_Create(void) {
+    FitEngine *engine = (FitEngine *)calloc(1, sizeof(FitEngine));
+    if (!engine) return NULL;
+    engine->job = LatestJob_Create(sizeof(FitParams), FitEngine_Run, FitEngine_Collect, engine);
+    if (!engine->job) {
+        free(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void FitEngine_Destroy(FitEngine *engine) {
+    if (!engine) return;
+    LatestJob_Destroy(engine->job);
+    free(engine);
+}
+
+void FitEngine_Submit(FitEngine *engine, FitModel model, int degree, BootstrapMode boot, FitKey key, const float *x, const float *y, int count) {
+    if (!engine) return;
+    FitParams params = { model, degree, boot, key };
+    LatestJob_Submit(engine->job, &params, 0, x, y, count);
+}
+
+bool FitEngine_IsBusy(FitEngine *engine) {
+    return engine && LatestJob_IsBusy(engine->job);
+}
+
+bool FitEngine_Result(FitEngine *engine, FitResult *out) {
+    if (!engine) return false;
+    LatestJob_Pump(engine->job);
+    if (!engine->hasResult) return false;
+    *out = engine->result;
+    return true;
+}
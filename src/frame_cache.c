@@ -0,0 +1,156 @@
+#include "frame_cache.h"
+#include "job_system.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum { SLOT_EMPTY, SLOT_WRITING, SLOT_READY } SlotState;
+
+typedef struct {
+    long long frameIdx;
+    double time;
+    SlotState state;
+    unsigned long long lastUse;
+    unsigned int generation;
+    uint8_t *pixels;
+} FrameSlot;
+
+struct FrameCache {
+    int width;
+    int height;
+    size_t frameBytes;
+    int capacity;
+    FrameSlot *slots;
+    unsigned long long useClock;
+    unsigned int generation;
+    JobMutex *mutex;
+};
+
+static int FindSlot(FrameCache *cache, long long frameIdx) {
+    for (int i = 0; i < cache->capacity; i++) {
+        if (cache->slots[i].state != SLOT_EMPTY && cache->slots[i].frameIdx == frameIdx) return i;
+    }
+    return -1;
+}
+
+FrameCache* FrameCache_Create(int width, int height, size_t budgetBytes) {
+    if (width <= 0 || height <= 0) return NULL;
+
+    FrameCache *cache = (FrameCache *)calloc(1, sizeof(FrameCache));
+    if (!cache) return NULL;
+
+    cache->width = width;
+    cache->height = height;
+    cache->frameBytes = (size_t)width * height * 3;
+
+    size_t count = budgetBytes / cache->frameBytes;
+    if (count < FRAME_CACHE_MIN_FRAMES) count = FRAME_CACHE_MIN_FRAMES;
+    if (count > FRAME_CACHE_MAX_FRAMES) count = FRAME_CACHE_MAX_FRAMES;
+    cache->capacity = (int)count;
+
+    cache->slots = (FrameSlot *)calloc(cache->capacity, sizeof(FrameSlot));
+    cache->mutex = JobMutex_Create();
+    if (!cache->slots || !cache->mutex) {
+        FrameCache_Destroy(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+void FrameCache_Destroy(FrameCache *cache) {
+    if (!cache) return;
+    if (cache->slots) {
+        for (int i = 0; i < cache->capacity; i++) free(cache->slots[i].pixels);
+        free(cache->slots);
+    }
+    if (cache->mutex) JobMutex_Destroy(cache->mutex);
+    free(cache);
+}
+
+void FrameCache_Clear(FrameCache *cache) {
+    if (!cache) return;
+    JobMutex_Lock(cache->mutex);
+    cache->generation++;
+    for (int i = 0; i < cache->capacity; i++) {
+        if (cache->slots[i].state == SLOT_READY) cache->slots[i].state = SLOT_EMPTY;
+    }
+    JobMutex_Unlock(cache->mutex);
+}
+
+int FrameCache_Capacity(const FrameCache *cache) {
+    return cache ? cache->capacity : 0;
+}
+
+bool FrameCache_Contains(FrameCache *cache, long long frameIdx) {
+    if (!cache) return false;
+    JobMutex_Lock(cache->mutex);
+    int idx = FindSlot(cache, frameIdx);
+    bool found = (idx >= 0 && cache->slots[idx].state == SLOT_READY);
+    JobMutex_Unlock(cache->mutex);
+    return found;
+}
+
+bool FrameCache_Fetch(FrameCache *cache, long long frameIdx, uint8_t *dst, double *outTime) {
+    if (!cache) return false;
+    JobMutex_Lock(cache->mutex);
+    int idx = FindSlot(cache, frameIdx);
+    bool found = (idx >= 0 && cache->slots[idx].state == SLOT_READY);
+    if (found) {
+        FrameSlot *slot = &cache->slots[idx];
+        memcpy(dst, slot->pixels, cache->frameBytes);
+        if (outTime) *outTime = slot->time;
+        slot->lastUse = ++cache->useClock;
+    }
+    JobMutex_Unlock(cache->mutex);
+    return found;
+}
+
+uint8_t* FrameCache_BeginWrite(FrameCache *cache, long long frameIdx) {
+    if (!cache) return NULL;
+    JobMutex_Lock(cache->mutex);
+
+    if (FindSlot(cache, frameIdx) >= 0) {
+        JobMutex_Unlock(cache->mutex);
+        return NULL;
+    }
+
+    int victim = -1;
+    for (int i = 0; i < cache->capacity; i++) {
+        FrameSlot *slot = &cache->slots[i];
+        if (slot->state == SLOT_EMPTY) { victim = i; break; }
+        if (slot->state == SLOT_READY && (victim < 0 || slot->lastUse < cache->slots[victim].lastUse)) victim = i;
+    }
+
+    uint8_t *pixels = NULL;
+    if (victim >= 0) {
+        FrameSlot *slot = &cache->slots[victim];
+        if (!slot->pixels) slot->pixels = (uint8_t *)malloc(cache->frameBytes);
+        if (slot->pixels) {
+            slot->frameIdx = frameIdx;
+            slot->state = SLOT_WRITING;
+            slot->generation = cache->generation;
+            pixels = slot->pixels;
+        }
+    }
+
+    JobMutex_Unlock(cache->mutex);
+    return pixels;
+}
+
+void FrameCache_EndWrite(FrameCache *cache, long long frameIdx, double time, bool ok) {
+    if (!cache) return;
+    JobMutex_Lock(cache->mutex);
+    for (int i = 0; i < cache->capacity; i++) {
+        FrameSlot *slot = &cache->slots[i];
+        if (slot->state != SLOT_WRITING || slot->frameIdx != frameIdx) continue;
+
+        if (ok && slot->generation == cache->generation) {
+            slot->state = SLOT_READY;
+            slot->time = time;
+            slot->lastUse = ++cache->useClock;
+        } else {
+            slot->state = SLOT_EMPTY;
+        }
+        break;
+    }
+    JobMutex_Unlock(cache->mutex);
+}
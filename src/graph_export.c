@@ -0,0 +1,490 @@
+#include "graph_export.h"
+#include "job_system.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define EXPORT_GLYPHS 250
+#define EXPORT_GRID_DIVS 6
+#define EXPORT_PANEL_GAP 8.0f
+
+typedef struct ExportPanel {
+    GraphExportPanel desc;
+    float *x;
+    float *y;
+    int count;
+    int capacity;
+} ExportPanel;
+
+struct GraphExport {
+    const unsigned char *fontData;
+    int fontSize;
+    ExportPanel panels[GRAPH_EXPORT_MAX_PANELS];
+    int panelCount;
+    GraphExportFormat format;
+    char path[1024];
+    Job *job;
+    bool ok;
+    GraphExportStatus status;
+};
+
+// Police relue par le thread de travail : glyphes en mémoire seulement, aucune texture.
+typedef struct ExportFont {
+    GlyphInfo *glyphs;
+    float size;
+} ExportFont;
+
+typedef enum { FONT_LABEL, FONT_TITLE, FONT_EQUATION, FONT_COUNT } ExportFontRole;
+static const float fontSizes[FONT_COUNT] = { 10.0f, 15.0f, 20.0f };
+
+static const Color bgColor = { 25, 25, 25, 255 };
+static const Color gapColor = { 35, 35, 35, 255 };
+static const Color gridColor = { 60, 60, 60, 255 };
+static const Color labelColor = { 130, 130, 130, 255 };
+static const Color markerColor = { 200, 200, 200, 150 };
+
+static void ExportFont_Load(ExportFont *font, const GraphExport *ex, float size) {
+    font->size = size;
+    font->glyphs = NULL;
+    if (ex->fontData && ex->fontSize > 0) {
+        font->glyphs = LoadFontData(ex->fontData, ex->fontSize, (int)roundf(size), NULL, EXPORT_GLYPHS, FONT_DEFAULT);
+    }
+}
+
+static void ExportFont_Unload(ExportFont *font) {
+    if (font->glyphs) UnloadFontData(font->glyphs, EXPORT_GLYPHS);
+    font->glyphs = NULL;
+}
+
+// Polices chargées sans codepoints explicites : le glyphe i porte le caractère 32 + i.
+static const GlyphInfo* ExportFont_Glyph(const ExportFont *font, int codepoint) {
+    int index = codepoint - 32;
+    if (index < 0 || index >= EXPORT_GLYPHS) index = '?' - 32;
+    return &font->glyphs[index];
+}
+
+static float ExportFont_Advance(const GlyphInfo *g) {
+    return (float)(g->advanceX ? g->advanceX : g->image.width);
+}
+
+static Vector2 ExportFont_Measure(const ExportFont *font, const char *text, float spacing) {
+    Vector2 size = { 0.0f, 0.0f };
+    if (!font->glyphs || !text || !*text) return size;
+    float lineW = 0.0f;
+    int lines = 1;
+    for (int i = 0; text[i];) {
+        int bytes = 0;
+        int cp = GetCodepointNext(&text[i], &bytes);
+        i += (bytes > 0) ? bytes : 1;
+        if (cp == '\n') { lines++; lineW = 0.0f; continue; }
+        lineW += ExportFont_Advance(ExportFont_Glyph(font, cp)) + spacing;
+        if (lineW > size.x) size.x = lineW;
+    }
+    size.y = lines * font->size + (lines - 1) * 2.0f;
+    return size;
+}
+
+// ---------------------------------------------------------------------------
+// Rastérisation CPU (RGBA8), avec anticrénelage par couverture.
+
+typedef struct Canvas {
+    unsigned char *px;
+    int width;
+    int clipX0, clipY0, clipX1, clipY1;
+    float ox, oy;           // origine du panneau courant
+} Canvas;
+
+static void Canvas_Blend(Canvas *c, int x, int y, Color col, float cover) {
+    if (x < c->clipX0 || y < c->clipY0 || x >= c->clipX1 || y >= c->clipY1) return;
+    float a = cover * col.a / 255.0f;
+    if (a <= 0.0f) return;
+    if (a > 1.0f) a = 1.0f;
+    unsigned char *p = c->px + 4 * ((size_t)y * c->width + x);
+    p[0] = (unsigned char)(col.r * a + p[0] * (1.0f - a) + 0.5f);
+    p[1] = (unsigned char)(col.g * a + p[1] * (1.0f - a) + 0.5f);
+    p[2] = (unsigned char)(col.b * a + p[2] * (1.0f - a) + 0.5f);
+    p[3] = 255;
+}
+
+static void Canvas_Rect(Canvas *c, float x, float y, float w, float h, Color col) {
+    int x0 = (int)floorf(c->ox + x), y0 = (int)floorf(c->oy + y);
+    int x1 = (int)ceilf(c->ox + x + w), y1 = (int)ceilf(c->oy + y + h);
+    for (int py = y0; py < y1; py++) {
+        for (int px = x0; px < x1; px++) Canvas_Blend(c, px, py, col, 1.0f);
+    }
+}
+
+static void Canvas_Segment(Canvas *c, Vector2 a, Vector2 b, float thick, Color col) {
+    a.x += c->ox; a.y += c->oy; b.x += c->ox; b.y += c->oy;
+    float r = thick * 0.5f;
+    int x0 = (int)floorf(fminf(a.x, b.x) - r - 1), x1 = (int)ceilf(fmaxf(a.x, b.x) + r + 1);
+    int y0 = (int)floorf(fminf(a.y, b.y) - r - 1), y1 = (int)ceilf(fmaxf(a.y, b.y) + r + 1);
+    if (x0 < c->clipX0) x0 = c->clipX0;
+    if (y0 < c->clipY0) y0 = c->clipY0;
+    if (x1 > c->clipX1) x1 = c->clipX1;
+    if (y1 > c->clipY1) y1 = c->clipY1;
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float len2 = dx * dx + dy * dy;
+    for (int py = y0; py < y1; py++) {
+        for (int px = x0; px < x1; px++) {
+            float qx = px + 0.5f - a.x, qy = py + 0.5f - a.y;
+            float t = (len2 > 0.0f) ? (qx * dx + qy * dy) / len2 : 0.0f;
+            if (t < 0.0f) t = 0.0f;
+            if (t > 1.0f) t = 1.0f;
+            float ex = qx - t * dx, ey = qy - t * dy;
+            float cover = r + 0.5f - sqrtf(ex * ex + ey * ey);
+            if (cover > 0.0f) Canvas_Blend(c, px, py, col, fminf(cover, 1.0f));
+        }
+    }
+}
+
+static void Canvas_Disc(Canvas *c, float cx, float cy, float r, Color col) {
+    cx += c->ox; cy += c->oy;
+    int x0 = (int)floorf(cx - r - 1), x1 = (int)ceilf(cx + r + 1);
+    int y0 = (int)floorf(cy - r - 1), y1 = (int)ceilf(cy + r + 1);
+    for (int py = y0; py < y1; py++) {
+        for (int px = x0; px < x1; px++) {
+            float dx = px + 0.5f - cx, dy = py + 0.5f - cy;
+            float cover = r + 0.5f - sqrtf(dx * dx + dy * dy);
+            if (cover > 0.0f) Canvas_Blend(c, px, py, col, fminf(cover, 1.0f));
+        }
+    }
+}
+
+static void Canvas_Text(Canvas *c, const ExportFont *font, const char *text, float x, float y, float spacing, Color col) {
+    if (!font->glyphs || !text) return;
+    float penX = c->ox + x, penY = c->oy + y;
+    float lineStart = penX;
+    for (int i = 0; text[i];) {
+        int bytes = 0;
+        int cp = GetCodepointNext(&text[i], &bytes);
+        i += (bytes > 0) ? bytes : 1;
+        if (cp == '\n') { penX = lineStart; penY += font->size + 2.0f; continue; }
+        const GlyphInfo *g = ExportFont_Glyph(font, cp);
+        const unsigned char *src = (const unsigned char *)g->image.data;
+        if (src && cp != ' ') {
+            int gx = (int)roundf(penX) + g->offsetX, gy = (int)roundf(penY) + g->offsetY;
+            for (int row = 0; row < g->image.height; row++) {
+                for (int col2 = 0; col2 < g->image.width; col2++) {
+                    unsigned char v = src[row * g->image.width + col2];
+                    if (v) Canvas_Blend(c, gx + col2, gy + row, col, v / 255.0f);
+                }
+            }
+        }
+        penX += ExportFont_Advance(g) + spacing;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mise en page commune aux deux formats (unités de sortie, s = échelle écran -> sortie).
+
+static float Export_MapX(const GraphExportPanel *p, float v, float w) { return (v - p->minX) / (p->maxX - p->minX) * w; }
+static float Export_MapY(const GraphExportPanel *p, float v, float h) { return h - (v - p->minY) / (p->maxY - p->minY) * h; }
+
+static float Export_Layout(const GraphExport *ex, float s, float *tops) {
+    float y = 0.0f;
+    for (int i = 0; i < ex->panelCount; i++) {
+        if (i > 0) y += EXPORT_PANEL_GAP * s;
+        tops[i] = y;
+        y += ex->panels[i].desc.height * s;
+    }
+    return y;
+}
+
+static void Export_GridLabel(char *buf, size_t size, const GraphExportPanel *p, int i, bool axisX) {
+    float r = (float)i / EXPORT_GRID_DIVS;
+    snprintf(buf, size, "%.2f", axisX ? p->minX + r * (p->maxX - p->minX) : p->minY + r * (p->maxY - p->minY));
+}
+
+static void Export_DrawPanelPng(Canvas *c, const ExportPanel *panel, const ExportFont *fonts, float w, float h, float s) {
+    const GraphExportPanel *p = &panel->desc;
+    Canvas_Rect(c, 0, 0, w, h, bgColor);
+
+    float line = fmaxf(1.0f, s);
+    for (int i = 0; i <= EXPORT_GRID_DIVS; i++) {
+        float r = (float)i / EXPORT_GRID_DIVS;
+        Canvas_Rect(c, r * w - line * 0.5f, 0, line, h, gridColor);
+        Canvas_Rect(c, 0, h - r * h - line * 0.5f, w, line, gridColor);
+    }
+    for (int i = 0; i <= EXPORT_GRID_DIVS; i += 2) {
+        float r = (float)i / EXPORT_GRID_DIVS;
+        char lbl[32];
+        Export_GridLabel(lbl, sizeof(lbl), p, i, true);
+        Canvas_Text(c, &fonts[FONT_LABEL], lbl, r * w + 2 * s, h - 15 * s, s, labelColor);
+        Export_GridLabel(lbl, sizeof(lbl), p, i, false);
+        Canvas_Text(c, &fonts[FONT_LABEL], lbl, 5 * s, h - r * h - 12 * s, s, labelColor);
+    }
+    if (p->label[0]) Canvas_Text(c, &fonts[FONT_TITLE], p->label, 8 * s, 6 * s, s, p->color);
+
+    if (p->hasCurve) {
+        // Remplissage : dégradé vertical colonne par colonne, de la courbe au bas du tracé.
+        if (p->fill) {
+            int cols = (int)ceilf(w);
+            for (int x = 0; x < cols; x++) {
+                float u = (x + 0.5f) / w * GRAPH_EXPORT_CURVE_STEPS;
+                int k = (int)u;
+                if (k >= GRAPH_EXPORT_CURVE_STEPS) k = GRAPH_EXPORT_CURVE_STEPS - 1;
+                float f = u - k;
+                float yv = p->curveY[k] * (1.0f - f) + p->curveY[k + 1] * f;
+                if (!isfinite(yv)) continue;
+                float top = Export_MapY(p, yv, h);
+                if (top >= h) continue;
+                int row0 = (int)fmaxf(0.0f, floorf(top));
+                for (int row = row0; row < (int)ceilf(h); row++) {
+                    float fade = 1.0f - (row + 0.5f - top) / (h - top);
+                    if (fade > 1.0f) fade = 1.0f;
+                    Canvas_Blend(c, (int)c->ox + x, (int)c->oy + row, p->color, fade * 150.0f / 255.0f);
+                }
+            }
+        }
+        float stepX = (p->maxX - p->minX) / GRAPH_EXPORT_CURVE_STEPS;
+        for (int k = 1; k <= GRAPH_EXPORT_CURVE_STEPS; k++) {
+            float y0 = p->curveY[k - 1], y1 = p->curveY[k];
+            if (!isfinite(y0) || !isfinite(y1)) continue;
+            Vector2 a = { Export_MapX(p, p->minX + (k - 1) * stepX, w), Export_MapY(p, y0, h) };
+            Vector2 b = { Export_MapX(p, p->minX + k * stepX, w), Export_MapY(p, y1, h) };
+            Canvas_Segment(c, a, b, 2.5f * s, p->color);
+        }
+    }
+
+    for (int i = 0; i < panel->count; i++) {
+        Canvas_Disc(c, Export_MapX(p, panel->x[i], w), Export_MapY(p, panel->y[i], h), 3.0f * s, markerColor);
+    }
+
+    if (p->equation[0]) {
+        Vector2 sz = ExportFont_Measure(&fonts[FONT_EQUATION], p->equation, s);
+        Canvas_Rect(c, w - sz.x - 10 * s, 5 * s, sz.x + 10 * s, sz.y + 6 * s, bgColor);
+        Canvas_Text(c, &fonts[FONT_EQUATION], p->equation, w - sz.x - 5 * s, 7 * s, s, p->color);
+    }
+}
+
+static bool Export_WritePng(GraphExport *ex) {
+    float w = GRAPH_EXPORT_WIDTH;
+    float s = w / ex->panels[0].desc.width;
+    float tops[GRAPH_EXPORT_MAX_PANELS];
+    int imgH = (int)ceilf(Export_Layout(ex, s, tops));
+    if (imgH < 1) return false;
+
+    Image img = GenImageColor(GRAPH_EXPORT_WIDTH, imgH, gapColor);
+    if (!img.data) return false;
+
+    ExportFont fonts[FONT_COUNT];
+    for (int f = 0; f < FONT_COUNT; f++) ExportFont_Load(&fonts[f], ex, fontSizes[f] * s);
+
+    for (int i = 0; i < ex->panelCount; i++) {
+        float h = ex->panels[i].desc.height * s;
+        Canvas c = { (unsigned char *)img.data, img.width, 0, (int)roundf(tops[i]), img.width, (int)roundf(tops[i] + h), 0.0f, tops[i] };
+        if (c.clipY1 > imgH) c.clipY1 = imgH;
+        Export_DrawPanelPng(&c, &ex->panels[i], fonts, w, h, s);
+    }
+
+    for (int f = 0; f < FONT_COUNT; f++) ExportFont_Unload(&fonts[f]);
+    bool ok = ExportImage(img, ex->path);
+    UnloadImage(img);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// SVG : mêmes éléments en vectoriel, aux dimensions de l'écran.
+
+static void Svg_Text(FILE *f, const char *text) {
+    for (const char *c = text; *c; c++) {
+        switch (*c) {
+            case '&': fputs("&amp;", f); break;
+            case '<': fputs("&lt;", f); break;
+            case '>': fputs("&gt;", f); break;
+            case '"': fputs("&quot;", f); break;
+            default: fputc(*c, f); break;
+        }
+    }
+}
+
+static void Svg_Label(FILE *f, const char *text, float x, float y, float size, Color col, const char *anchor) {
+    fprintf(f, "<text x=\"%.2f\" y=\"%.2f\" font-size=\"%.1f\" fill=\"rgb(%d,%d,%d)\" text-anchor=\"%s\">",
+            x, y + size * 0.8f, size, col.r, col.g, col.b, anchor);
+    Svg_Text(f, text);
+    fputs("</text>\n", f);
+}
+
+static void Export_DrawPanelSvg(FILE *f, int id, const ExportPanel *panel, const ExportFont *eqFont, float top, float w, float h) {
+    const GraphExportPanel *p = &panel->desc;
+    Color col = p->color;
+    fprintf(f, "<g transform=\"translate(0,%.2f)\">\n", top);
+    fprintf(f, "<clipPath id=\"clip%d\"><rect width=\"%.2f\" height=\"%.2f\"/></clipPath>\n", id, w, h);
+    fprintf(f, "<rect width=\"%.2f\" height=\"%.2f\" fill=\"rgb(%d,%d,%d)\"/>\n", w, h, bgColor.r, bgColor.g, bgColor.b);
+    fprintf(f, "<g clip-path=\"url(#clip%d)\">\n", id);
+
+    fprintf(f, "<path fill=\"none\" stroke=\"rgb(%d,%d,%d)\" stroke-width=\"1\" d=\"", gridColor.r, gridColor.g, gridColor.b);
+    for (int i = 0; i <= EXPORT_GRID_DIVS; i++) {
+        float r = (float)i / EXPORT_GRID_DIVS;
+        fprintf(f, "M%.2f 0V%.2fM0 %.2fH%.2f", r * w, h, h - r * h, w);
+    }
+    fputs("\"/>\n", f);
+    for (int i = 0; i <= EXPORT_GRID_DIVS; i += 2) {
+        float r = (float)i / EXPORT_GRID_DIVS;
+        char lbl[32];
+        Export_GridLabel(lbl, sizeof(lbl), p, i, true);
+        Svg_Label(f, lbl, r * w + 2, h - 15, 10, labelColor, "start");
+        Export_GridLabel(lbl, sizeof(lbl), p, i, false);
+        Svg_Label(f, lbl, 5, h - r * h - 12, 10, labelColor, "start");
+    }
+    if (p->label[0]) Svg_Label(f, p->label, 8, 6, 15, col, "start");
+
+    if (p->hasCurve) {
+        float stepX = (p->maxX - p->minX) / GRAPH_EXPORT_CURVE_STEPS;
+        if (p->fill) {
+            fprintf(f, "<linearGradient id=\"fill%d\" x1=\"0\" y1=\"0\" x2=\"0\" y2=\"1\">"
+                       "<stop offset=\"0\" stop-color=\"rgb(%d,%d,%d)\" stop-opacity=\"0.59\"/>"
+                       "<stop offset=\"1\" stop-color=\"rgb(%d,%d,%d)\" stop-opacity=\"0\"/></linearGradient>\n",
+                    id, col.r, col.g, col.b, col.r, col.g, col.b);
+            fprintf(f, "<path fill=\"url(#fill%d)\" d=\"M0 %.2f", id, h);
+            for (int k = 0; k <= GRAPH_EXPORT_CURVE_STEPS; k++) {
+                if (!isfinite(p->curveY[k])) continue;
+                fprintf(f, "L%.2f %.2f", Export_MapX(p, p->minX + k * stepX, w), Export_MapY(p, p->curveY[k], h));
+            }
+            fprintf(f, "L%.2f %.2fZ\"/>\n", w, h);
+        }
+        fprintf(f, "<polyline fill=\"none\" stroke=\"rgb(%d,%d,%d)\" stroke-width=\"2.5\" stroke-linejoin=\"round\" points=\"", col.r, col.g, col.b);
+        for (int k = 0; k <= GRAPH_EXPORT_CURVE_STEPS; k++) {
+            if (!isfinite(p->curveY[k])) continue;
+            fprintf(f, "%.2f,%.2f ", Export_MapX(p, p->minX + k * stepX, w), Export_MapY(p, p->curveY[k], h));
+        }
+        fputs("\"/>\n", f);
+    }
+
+    fprintf(f, "<g fill=\"rgb(%d,%d,%d)\" fill-opacity=\"%.2f\">\n", markerColor.r, markerColor.g, markerColor.b, markerColor.a / 255.0f);
+    for (int i = 0; i < panel->count; i++) {
+        fprintf(f, "<circle cx=\"%.2f\" cy=\"%.2f\" r=\"3\"/>\n", Export_MapX(p, panel->x[i], w), Export_MapY(p, panel->y[i], h));
+    }
+    fputs("</g>\n", f);
+
+    if (p->equation[0]) {
+        Vector2 sz = ExportFont_Measure(eqFont, p->equation, 1.0f);
+        fprintf(f, "<rect x=\"%.2f\" y=\"5\" width=\"%.2f\" height=\"%.2f\" fill=\"rgb(%d,%d,%d)\"/>\n",
+                w - sz.x - 10, sz.x + 10, sz.y + 6, bgColor.r, bgColor.g, bgColor.b);
+        fprintf(f, "<text font-size=\"20\" fill=\"rgb(%d,%d,%d)\">", col.r, col.g, col.b);
+        const char *line = p->equation;
+        for (int row = 0; ; row++) {
+            const char *end = strchr(line, '\n');
+            size_t len = end ? (size_t)(end - line) : strlen(line);
+            char buf[512];
+            if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+            memcpy(buf, line, len);
+            buf[len] = '\0';
+            fprintf(f, "<tspan x=\"%.2f\" y=\"%.2f\">", w - sz.x - 5, 7 + row * 22 + 16.0f);
+            Svg_Text(f, buf);
+            fputs("</tspan>", f);
+            if (!end) break;
+            line = end + 1;
+        }
+        fputs("</text>\n", f);
+    }
+    fputs("</g>\n</g>\n", f);
+}
+
+static bool Export_WriteSvg(GraphExport *ex) {
+    FILE *f = fopen(ex->path, "w");
+    if (!f) return false;
+
+    float tops[GRAPH_EXPORT_MAX_PANELS];
+    float w = ex->panels[0].desc.width;
+    float h = Export_Layout(ex, 1.0f, tops);
+    ExportFont eqFont;
+    ExportFont_Load(&eqFont, ex, fontSizes[FONT_EQUATION]);
+
+    fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" viewBox=\"0 0 %.2f %.2f\" font-family=\"Inter, sans-serif\">\n",
+            ceilf(w), ceilf(h), w, h);
+    fprintf(f, "<rect width=\"100%%\" height=\"100%%\" fill=\"rgb(%d,%d,%d)\"/>\n", gapColor.r, gapColor.g, gapColor.b);
+    for (int i = 0; i < ex->panelCount; i++) {
+        Export_DrawPanelSvg(f, i, &ex->panels[i], &eqFont, tops[i], w, ex->panels[i].desc.height);
+    }
+    fputs("</svg>\n", f);
+
+    ExportFont_Unload(&eqFont);
+    bool ok = !ferror(f);
+    return (fclose(f) == 0) && ok;
+}
+
+static void GraphExport_Job(void *arg) {
+    GraphExport *ex = (GraphExport *)arg;
+    ex->ok = (ex->format == GRAPH_EXPORT_SVG) ? Export_WriteSvg(ex) : Export_WritePng(ex);
+}
+
+// ---------------------------------------------------------------------------
+
+GraphExport* GraphExport_Create(const unsigned char *fontData, int fontSize) {
+    GraphExport *ex = (GraphExport *)calloc(1, sizeof(GraphExport));
+    if (!ex) return NULL;
+    ex->fontData = fontData;
+    ex->fontSize = fontSize;
+    ex->status = GRAPH_EXPORT_IDLE;
+    return ex;
+}
+
+void GraphExport_Destroy(GraphExport *ex) {
+    if (!ex) return;
+    if (ex->job) Job_Wait(ex->job);
+    for (int i = 0; i < GRAPH_EXPORT_MAX_PANELS; i++) {
+        free(ex->panels[i].x);
+        free(ex->panels[i].y);
+    }
+    free(ex);
+}
+
+bool GraphExport_IsBusy(GraphExport *ex) {
+    return ex && ex->job && !Job_IsDone(ex->job);
+}
+
+void GraphExport_Begin(GraphExport *ex) {
+    if (!ex || ex->job) return;
+    ex->panelCount = 0;
+}
+
+void GraphExport_AddPanel(GraphExport *ex, const GraphExportPanel *desc, const float *x, const float *y, const int *indices, int count) {
+    if (!ex || ex->job || ex->panelCount >= GRAPH_EXPORT_MAX_PANELS || desc->width <= 0 || desc->height <= 0) return;
+    if (desc->maxX <= desc->minX || desc->maxY <= desc->minY) return;
+
+    ExportPanel *panel = &ex->panels[ex->panelCount];
+    if (count > panel->capacity) {
+        float *nx = (float *)realloc(panel->x, count * sizeof(float));
+        if (nx) panel->x = nx;
+        float *ny = (float *)realloc(panel->y, count * sizeof(float));
+        if (ny) panel->y = ny;
+        if (!nx || !ny) return;
+        panel->capacity = count;
+    }
+    panel->desc = *desc;
+    for (int k = 0; k < count; k++) {
+        panel->x[k] = x[indices[k]];
+        panel->y[k] = y[indices[k]];
+    }
+    panel->count = count;
+    ex->panelCount++;
+}
+
+int GraphExport_PanelCount(GraphExport *ex) {
+    return ex ? ex->panelCount : 0;
+}
+
+bool GraphExport_Start(GraphExport *ex, GraphExportFormat format, const char *path) {
+    if (!ex || ex->job || ex->panelCount == 0 || !path || !*path) return false;
+    ex->format = format;
+    snprintf(ex->path, sizeof(ex->path), "%s", path);
+    ex->ok = false;
+    ex->status = GRAPH_EXPORT_RUNNING;
+    ex->job = Job_Submit(GraphExport_Job, ex);
+    if (!ex->job) ex->status = GRAPH_EXPORT_FAILED;
+    return ex->job != NULL;
+}
+
+GraphExportStatus GraphExport_Status(GraphExport *ex) {
+    if (!ex) return GRAPH_EXPORT_IDLE;
+    if (ex->job && Job_IsDone(ex->job)) {
+        Job_Wait(ex->job);
+        ex->job = NULL;
+        ex->status = ex->ok ? GRAPH_EXPORT_DONE : GRAPH_EXPORT_FAILED;
+    }
+    return ex->status;
+}
@@ -0,0 +1,291 @@
+#include "graph_gpu.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MARKER_SEGMENTS 10
+
+static const char *geometryVS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec4 vertexColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec4 fragColor;\n"
+    "void main() { fragColor = vertexColor; gl_Position = mvp * vec4(vertexPosition.xy, 0.0, 1.0); }\n";
+
+static const char *markerVS =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 instanceCenter;\n"
+    "uniform mat4 mvp;\n"
+    "uniform vec4 markerColor;\n"
+    "uniform float radius;\n"
+    "uniform vec4 mapping;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    vec2 center = (instanceCenter - mapping.zw) * mapping.xy;\n"
+    "    fragColor = markerColor; gl_Position = mvp * vec4(center + vertexPosition.xy * radius, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *colorFS =
+    "#version 330\n"
+    "in vec4 fragColor;\n"
+    "out vec4 finalColor;\n"
+    "void main() { finalColor = fragColor; }\n";
+
+static struct {
+    bool ready;
+    Shader geometry;
+    Shader marker;
+    int geometryMvp;
+    int markerMvp;
+    int markerColor;
+    int markerRadius;
+    int markerMapping;
+    int instanceCenter;
+} gpu;
+
+void GraphGpu_Init(void) {
+    if (gpu.ready) return;
+    gpu.geometry = LoadShaderFromMemory(geometryVS, colorFS);
+    gpu.marker = LoadShaderFromMemory(markerVS, colorFS);
+    // Un échec de compilation renvoie le shader par défaut : repli en mode immédiat.
+    if (gpu.geometry.id == rlGetShaderIdDefault() || gpu.marker.id == rlGetShaderIdDefault()) {
+        GraphGpu_Shutdown();
+        return;
+    }
+    gpu.geometryMvp = GetShaderLocation(gpu.geometry, "mvp");
+    gpu.markerMvp = GetShaderLocation(gpu.marker, "mvp");
+    gpu.markerColor = GetShaderLocation(gpu.marker, "markerColor");
+    gpu.markerRadius = GetShaderLocation(gpu.marker, "radius");
+    gpu.markerMapping = GetShaderLocation(gpu.marker, "mapping");
+    gpu.instanceCenter = GetShaderLocationAttrib(gpu.marker, "instanceCenter");
+    gpu.ready = (gpu.instanceCenter >= 0);
+}
+
+void GraphGpu_Shutdown(void) {
+    if (gpu.geometry.id != 0 && gpu.geometry.id != rlGetShaderIdDefault()) UnloadShader(gpu.geometry);
+    if (gpu.marker.id != 0 && gpu.marker.id != rlGetShaderIdDefault()) UnloadShader(gpu.marker);
+    memset(&gpu, 0, sizeof(gpu));
+}
+
+static void GraphGeometry_ReleaseGpu(GraphGeometry *g);
+static void GraphMarkers_ReleaseGpu(GraphMarkers *m);
+
+// Même chaîne que rlVertex : les rlTranslatef/rlPushMatrix en cours vont dans la matrice
+// de transformation, que rlGetMatrixModelview ne contient pas.
+static Matrix GraphGpu_Mvp(Vector2 origin) {
+    Matrix model = MatrixMultiply(MatrixTranslate(origin.x, origin.y, 0.0f), rlGetMatrixTransform());
+    return MatrixMultiply(MatrixMultiply(model, rlGetMatrixModelview()), rlGetMatrixProjection());
+}
+
+void GraphGeometry_Clear(GraphGeometry *g) {
+    g->count = 0;
+    g->dirty = true;
+}
+
+static bool GraphGeometry_Reserve(GraphGeometry *g, int count) {
+    if (count <= g->capacity) return true;
+    int cap = (g->capacity > 0) ? g->capacity : 1536;
+    while (cap < count) cap *= 2;
+    float *v = (float *)realloc(g->vertices, (size_t)cap * 2 * sizeof(float));
+    if (!v) return false;
+    g->vertices = v;
+    unsigned char *c = (unsigned char *)realloc(g->colors, (size_t)cap * 4);
+    if (!c) return false;
+    g->colors = c;
+    g->capacity = cap;
+    return true;
+}
+
+static void GraphGeometry_Vertex(GraphGeometry *g, Vector2 p, Color c) {
+    g->vertices[g->count * 2] = p.x;
+    g->vertices[g->count * 2 + 1] = p.y;
+    memcpy(g->colors + g->count * 4, &c, 4);
+    g->count++;
+}
+
+void GraphGeometry_Triangle(GraphGeometry *g, Vector2 a, Color ca, Vector2 b, Color cb, Vector2 c, Color cc) {
+    if (!GraphGeometry_Reserve(g, g->count + 3)) return;
+    GraphGeometry_Vertex(g, a, ca);
+    GraphGeometry_Vertex(g, b, cb);
+    GraphGeometry_Vertex(g, c, cc);
+    g->dirty = true;
+}
+
+// Même découpage que DrawLineEx : un quadrilatère par segment.
+void GraphGeometry_Segment(GraphGeometry *g, Vector2 a, Vector2 b, float thick, Color color) {
+    float dx = b.x - a.x, dy = b.y - a.y, len = sqrtf(dx * dx + dy * dy);
+    if (len < 1e-6f) return;
+    Vector2 n = { -dy / len * thick * 0.5f, dx / len * thick * 0.5f };
+    Vector2 a0 = { a.x - n.x, a.y - n.y }, a1 = { a.x + n.x, a.y + n.y };
+    Vector2 b0 = { b.x - n.x, b.y - n.y }, b1 = { b.x + n.x, b.y + n.y };
+    GraphGeometry_Triangle(g, a0, color, a1, color, b1, color);
+    GraphGeometry_Triangle(g, a0, color, b1, color, b0, color);
+}
+
+static void GraphGeometry_UploadBuffers(GraphGeometry *g) {
+    if (g->gpuCapacity < g->capacity) {
+        GraphGeometry_ReleaseGpu(g);
+        g->vao = rlLoadVertexArray();
+        rlEnableVertexArray(g->vao);
+        g->vboPosition = rlLoadVertexBuffer(g->vertices, g->capacity * 2 * (int)sizeof(float), true);
+        rlSetVertexAttribute(0, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute(0);
+        g->vboColor = rlLoadVertexBuffer(g->colors, g->capacity * 4, true);
+        rlSetVertexAttribute(3, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+        rlEnableVertexAttribute(3);
+        rlDisableVertexArray();
+        g->gpuCapacity = g->capacity;
+    } else if (g->count > 0) {
+        rlUpdateVertexBuffer(g->vboPosition, g->vertices, g->count * 2 * (int)sizeof(float), 0);
+        rlUpdateVertexBuffer(g->vboColor, g->colors, g->count * 4, 0);
+    }
+    g->dirty = false;
+}
+
+void GraphGeometry_Draw(GraphGeometry *g, Vector2 origin) {
+    if (g->count == 0) return;
+
+    if (!gpu.ready) {
+        rlBegin(RL_TRIANGLES);
+        for (int i = 0; i < g->count; i++) {
+            const unsigned char *c = g->colors + i * 4;
+            rlColor4ub(c[0], c[1], c[2], c[3]);
+            rlVertex2f(origin.x + g->vertices[i * 2], origin.y + g->vertices[i * 2 + 1]);
+        }
+        rlEnd();
+        return;
+    }
+
+    rlDrawRenderBatchActive();
+    if (g->dirty) GraphGeometry_UploadBuffers(g);
+    rlDisableBackfaceCulling();
+    rlEnableShader(gpu.geometry.id);
+    rlSetUniformMatrix(gpu.geometryMvp, GraphGpu_Mvp(origin));
+    rlEnableVertexArray(g->vao);
+    rlDrawVertexArray(0, g->count);
+    rlDisableVertexArray();
+    rlDisableShader();
+    rlEnableBackfaceCulling();
+}
+
+static void GraphGeometry_ReleaseGpu(GraphGeometry *g) {
+    if (g->vao) rlUnloadVertexArray(g->vao);
+    if (g->vboPosition) rlUnloadVertexBuffer(g->vboPosition);
+    if (g->vboColor) rlUnloadVertexBuffer(g->vboColor);
+    g->vao = g->vboPosition = g->vboColor = 0;
+    g->gpuCapacity = 0;
+    g->dirty = true;
+}
+
+void GraphGeometry_Unload(GraphGeometry *g) {
+    GraphGeometry_ReleaseGpu(g);
+    free(g->vertices);
+    free(g->colors);
+    memset(g, 0, sizeof(GraphGeometry));
+}
+
+void GraphMarkers_Clear(GraphMarkers *m) {
+    GraphMarkers_Truncate(m, 0);
+}
+
+void GraphMarkers_Truncate(GraphMarkers *m, int count) {
+    if (count < 0) count = 0;
+    if (count > m->count) return;
+    m->count = count;
+    if (count < m->dirtyFrom) m->dirtyFrom = count;
+    m->dirty = true;
+}
+
+void GraphMarkers_Add(GraphMarkers *m, Vector2 center) {
+    if (m->count >= m->capacity) {
+        int cap = (m->capacity > 0) ? m->capacity * 2 : 1024;
+        float *grown = (float *)realloc(m->centers, (size_t)cap * 2 * sizeof(float));
+        if (!grown) return;
+        m->centers = grown;
+        m->capacity = cap;
+    }
+    m->centers[m->count * 2] = center.x;
+    m->centers[m->count * 2 + 1] = center.y;
+    if (m->count < m->dirtyFrom) m->dirtyFrom = m->count;
+    m->count++;
+    m->dirty = true;
+}
+
+static void GraphMarkers_UploadBuffers(GraphMarkers *m) {
+    if (m->gpuCapacity < m->capacity) {
+        GraphMarkers_ReleaseGpu(m);
+        // Disque unité en triangles, partagé par toutes les instances.
+        float disc[MARKER_SEGMENTS * 3 * 2];
+        for (int i = 0; i < MARKER_SEGMENTS; i++) {
+            float a0 = 2.0f * PI * i / MARKER_SEGMENTS, a1 = 2.0f * PI * (i + 1) / MARKER_SEGMENTS;
+            float *t = disc + i * 6;
+            t[0] = 0.0f; t[1] = 0.0f;
+            t[2] = cosf(a0); t[3] = sinf(a0);
+            t[4] = cosf(a1); t[5] = sinf(a1);
+        }
+        m->vao = rlLoadVertexArray();
+        rlEnableVertexArray(m->vao);
+        m->vboDisc = rlLoadVertexBuffer(disc, (int)sizeof(disc), false);
+        rlSetVertexAttribute(0, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute(0);
+        m->vboCenters = rlLoadVertexBuffer(m->centers, m->capacity * 2 * (int)sizeof(float), true);
+        rlSetVertexAttribute(gpu.instanceCenter, 2, RL_FLOAT, false, 0, 0);
+        rlSetVertexAttributeDivisor(gpu.instanceCenter, 1);
+        rlEnableVertexAttribute(gpu.instanceCenter);
+        rlDisableVertexArray();
+        m->gpuCapacity = m->capacity;
+    } else if (m->count > m->dirtyFrom) {
+        int offset = m->dirtyFrom * 2 * (int)sizeof(float);
+        rlUpdateVertexBuffer(m->vboCenters, m->centers + m->dirtyFrom * 2, (m->count - m->dirtyFrom) * 2 * (int)sizeof(float), offset);
+    }
+    m->dirty = false;
+    m->dirtyFrom = m->count;
+}
+
+void GraphMarkers_Draw(GraphMarkers *m, Vector2 origin, GraphMapping mapping, float radius, Color color) {
+    if (m->count == 0) return;
+
+    if (!gpu.ready) {
+        for (int i = 0; i < m->count; i++) {
+            Vector2 c = { (m->centers[i * 2] - mapping.offsetX) * mapping.scaleX, (m->centers[i * 2 + 1] - mapping.offsetY) * mapping.scaleY };
+            DrawCircleV((Vector2){ origin.x + c.x, origin.y + c.y }, radius, color);
+        }
+        return;
+    }
+
+    rlDrawRenderBatchActive();
+    if (m->dirty) GraphMarkers_UploadBuffers(m);
+    float col[4] = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+    rlDisableBackfaceCulling();
+    rlEnableShader(gpu.marker.id);
+    rlSetUniformMatrix(gpu.markerMvp, GraphGpu_Mvp(origin));
+    rlSetUniform(gpu.markerColor, col, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(gpu.markerRadius, &radius, RL_SHADER_UNIFORM_FLOAT, 1);
+    float map[4] = { mapping.scaleX, mapping.scaleY, mapping.offsetX, mapping.offsetY };
+    rlSetUniform(gpu.markerMapping, map, RL_SHADER_UNIFORM_VEC4, 1);
+    rlEnableVertexArray(m->vao);
+    rlDrawVertexArrayInstanced(0, MARKER_SEGMENTS * 3, m->count);
+    rlDisableVertexArray();
+    rlDisableShader();
+    rlEnableBackfaceCulling();
+}
+
+static void GraphMarkers_ReleaseGpu(GraphMarkers *m) {
+    if (m->vao) rlUnloadVertexArray(m->vao);
+    if (m->vboDisc) rlUnloadVertexBuffer(m->vboDisc);
+    if (m->vboCenters) rlUnloadVertexBuffer(m->vboCenters);
+    m->vao = m->vboDisc = m->vboCenters = 0;
+    m->gpuCapacity = 0;
+    m->dirty = true;
+    m->dirtyFrom = 0;
+}
+
+void GraphMarkers_Unload(GraphMarkers *m) {
+    GraphMarkers_ReleaseGpu(m);
+    free(m->centers);
+    memset(m, 0, sizeof(GraphMarkers));
+}
@@ -0,0 +1,174 @@
+#include "graph_lod.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool GraphLod_Reserve(GraphLod *lod, int count) {
+    if (count <= lod->capacity) return true;
+    int cap = (lod->capacity > 0) ? lod->capacity : 1024;
+    while (cap < count) cap *= 2;
+
+    float *gx = (float *)realloc(lod->x, (size_t)cap * sizeof(float));
+    if (!gx) return false;
+    lod->x = gx;
+    float *gy = (float *)realloc(lod->y, (size_t)cap * sizeof(float));
+    if (!gy) return false;
+    lod->y = gy;
+
+    int levelCount = 1;
+    while (levelCount < GRAPH_LOD_MAX_LEVELS && (cap >> levelCount) > 0) levelCount++;
+    for (int l = 1; l < levelCount; l++) {
+        GraphLodNode *grown = (GraphLodNode *)realloc(lod->levels[l], (size_t)(cap >> l) * sizeof(GraphLodNode));
+        if (!grown) return false;
+        lod->levels[l] = grown;
+    }
+    lod->levelCount = levelCount;
+    lod->capacity = cap;
+    return true;
+}
+
+static GraphLodNode GraphLod_Merge(const GraphLod *lod, GraphLodNode a, GraphLodNode b) {
+    GraphLodNode n;
+    n.iMin = (lod->y[b.iMin] < lod->y[a.iMin]) ? b.iMin : a.iMin;
+    n.iMax = (lod->y[b.iMax] > lod->y[a.iMax]) ? b.iMax : a.iMax;
+    return n;
+}
+
+static GraphLodNode GraphLod_Leaf(int i) {
+    return (GraphLodNode){ i, i };
+}
+
+static void GraphLod_Rebuild(GraphLod *lod, const float *x, const float *y, int count, int lo, int hi) {
+    if (count != lod->count || lo < hi) lod->version++;
+    lod->count = count;
+    if (lo >= hi) return;
+
+    memcpy(lod->x + lo, x + lo, (size_t)(hi - lo) * sizeof(float));
+    memcpy(lod->y + lo, y + lo, (size_t)(hi - lo) * sizeof(float));
+
+    for (int l = 1; l < lod->levelCount; l++) {
+        int full = count >> l;
+        int first = lo >> l, last = (hi - 1) >> l;
+        if (last >= full) last = full - 1;
+        for (int j = first; j <= last; j++) {
+            if (l == 1) {
+                lod->levels[1][j] = GraphLod_Merge(lod, GraphLod_Leaf(2 * j), GraphLod_Leaf(2 * j + 1));
+            } else {
+                lod->levels[l][j] = GraphLod_Merge(lod, lod->levels[l - 1][2 * j], lod->levels[l - 1][2 * j + 1]);
+            }
+        }
+    }
+}
+
+void GraphLod_Sync(GraphLod *lod, const float *x, const float *y, int count) {
+    if (count < 0) count = 0;
+    if (!GraphLod_Reserve(lod, count)) {
+        lod->count = 0;
+        return;
+    }
+
+    // Plage modifiée : points différents ou ajoutés depuis la synchro précédente.
+    int common = (lod->count < count) ? lod->count : count;
+    int lo = count, hi = 0;
+    for (int i = 0; i < common; i++) {
+        if (lod->x[i] != x[i] || lod->y[i] != y[i]) {
+            if (i < lo) lo = i;
+            hi = i + 1;
+        }
+    }
+    if (count > common) {
+        if (common < lo) lo = common;
+        hi = count;
+    }
+    GraphLod_Rebuild(lod, x, y, count, lo, hi);
+}
+
+void GraphLod_Update(GraphLod *lod, const float *x, const float *y, int count, int from) {
+    if (count < 0) count = 0;
+    if (from < 0) from = 0;
+    if (from > lod->count) from = lod->count;
+    if (!GraphLod_Reserve(lod, count)) {
+        lod->count = 0;
+        return;
+    }
+    GraphLod_Rebuild(lod, x, y, count, (from < count) ? from : count, count);
+}
+
+bool GraphLod_Range(const GraphLod *lod, int begin, int end, int *iMin, int *iMax) {
+    if (begin < 0) begin = 0;
+    if (end > lod->count) end = lod->count;
+    if (begin >= end) return false;
+
+    // Plus grands blocs alignés contenus dans [begin, end) : O(log n) noeuds.
+    GraphLodNode acc = GraphLod_Leaf(begin);
+    int i = begin + 1;
+    while (i < end) {
+        int level = 0;
+        while (level + 1 < lod->levelCount && (i & ((2 << level) - 1)) == 0 &&
+               i + (2 << level) <= end && (i >> (level + 1)) < (lod->count >> (level + 1))) level++;
+        GraphLodNode node = (level == 0) ? GraphLod_Leaf(i) : lod->levels[level][i >> level];
+        acc = GraphLod_Merge(lod, acc, node);
+        i += 1 << level;
+    }
+    *iMin = acc.iMin;
+    *iMax = acc.iMax;
+    return true;
+}
+
+int GraphLod_LowerBound(const GraphLod *lod, float value) {
+    int lo = 0, hi = lod->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (lod->x[mid] < value) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static int GraphLod_Emit(int *out, int n, int maxOut, int a, int b) {
+    if (a > b) { int t = a; a = b; b = t; }
+    if (n < maxOut && (n == 0 || out[n - 1] != a)) out[n++] = a;
+    if (b != a && n < maxOut) out[n++] = b;
+    return n;
+}
+
+int GraphLod_Select(const GraphLod *lod, int begin, int end, int budget, int *out, int maxOut) {
+    if (begin < 0) begin = 0;
+    if (end > lod->count) end = lod->count;
+    if (begin >= end || maxOut <= 0) return 0;
+    if (budget < 1) budget = 1;
+
+    int span = end - begin, n = 0;
+    if (span <= 2 * budget) {
+        for (int i = begin; i < end && n < maxOut; i++) out[n++] = i;
+        return n;
+    }
+
+    int level = 1;
+    while (level + 1 < lod->levelCount && (span >> level) > budget) level++;
+    int block = 1 << level, full = lod->count >> level;
+
+    int i = begin;
+    while (i < end && n < maxOut) {
+        int j = i >> level;
+        if ((i & (block - 1)) == 0 && i + block <= end && j < full) {
+            GraphLodNode node = lod->levels[level][j];
+            n = GraphLod_Emit(out, n, maxOut, node.iMin, node.iMax);
+            i += block;
+        } else {
+            // Bloc coupé par les bornes : extrêmes de la partie visible.
+            int segEnd = (j + 1) * block;
+            if (segEnd > end) segEnd = end;
+            int iMin, iMax;
+            GraphLod_Range(lod, i, segEnd, &iMin, &iMax);
+            n = GraphLod_Emit(out, n, maxOut, iMin, iMax);
+            i = segEnd;
+        }
+    }
+    return n;
+}
+
+void GraphLod_Free(GraphLod *lod) {
+    free(lod->x);
+    free(lod->y);
+    for (int l = 0; l < GRAPH_LOD_MAX_LEVELS; l++) free(lod->levels[l]);
+    memset(lod, 0, sizeof(GraphLod));
+}
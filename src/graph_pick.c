@@ -0,0 +1,108 @@
+#include "graph_pick.h"
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+static bool GraphPick_Reserve(GraphPick *pick, int count, int cells) {
+    if (count > pick->capacity) {
+        int cap = (pick->capacity > 0) ? pick->capacity : 1024;
+        while (cap < count) cap *= 2;
+        int *items = (int *)realloc(pick->items, (size_t)cap * sizeof(int));
+        if (!items) return false;
+        pick->items = items;
+        float *px = (float *)realloc(pick->px, (size_t)cap * sizeof(float));
+        if (!px) return false;
+        pick->px = px;
+        float *py = (float *)realloc(pick->py, (size_t)cap * sizeof(float));
+        if (!py) return false;
+        pick->py = py;
+        pick->capacity = cap;
+    }
+    if (cells + 1 > pick->cellCapacity) {
+        int *grown = (int *)realloc(pick->cellStart, (size_t)(cells + 1) * sizeof(int));
+        if (!grown) return false;
+        pick->cellStart = grown;
+        pick->cellCapacity = cells + 1;
+    }
+    return true;
+}
+
+static int GraphPick_Cell(float v, int n) {
+    int c = (int)floorf(v / GRAPH_PICK_CELL);
+    if (c < 0) return 0;
+    if (c >= n) return n - 1;
+    return c;
+}
+
+// Tri par dénombrement : un passage pour compter, un pour placer.
+void GraphPick_Build(GraphPick *pick, const float *x, const float *y, int count,
+                     float minX, float maxX, float minY, float maxY, float width, float height) {
+    pick->count = 0;
+    pick->cols = (int)ceilf(width / GRAPH_PICK_CELL);
+    pick->rows = (int)ceilf(height / GRAPH_PICK_CELL);
+    if (pick->cols < 1) pick->cols = 1;
+    if (pick->rows < 1) pick->rows = 1;
+    int cells = pick->cols * pick->rows;
+    if (count <= 0 || !GraphPick_Reserve(pick, count, cells)) return;
+
+    float sx = width / (maxX - minX), sy = height / (maxY - minY);
+    for (int c = 0; c <= cells; c++) pick->cellStart[c] = 0;
+    for (int i = 0; i < count; i++) {
+        float lx = (x[i] - minX) * sx, ly = height - (y[i] - minY) * sy;
+        pick->cellStart[GraphPick_Cell(ly, pick->rows) * pick->cols + GraphPick_Cell(lx, pick->cols) + 1]++;
+    }
+    for (int c = 0; c < cells; c++) pick->cellStart[c + 1] += pick->cellStart[c];
+
+    // cellStart[c] sert de curseur d'écriture puis retrouve sa valeur en fin de passe.
+    for (int i = 0; i < count; i++) {
+        float lx = (x[i] - minX) * sx, ly = height - (y[i] - minY) * sy;
+        int c = GraphPick_Cell(ly, pick->rows) * pick->cols + GraphPick_Cell(lx, pick->cols);
+        int slot = pick->cellStart[c]++;
+        pick->items[slot] = i;
+        pick->px[slot] = lx;
+        pick->py[slot] = ly;
+    }
+    for (int c = cells; c > 0; c--) pick->cellStart[c] = pick->cellStart[c - 1];
+    pick->cellStart[0] = 0;
+    pick->count = count;
+}
+
+int GraphPick_Nearest(const GraphPick *pick, float qx, float qy, float maxDist) {
+    if (pick->count == 0) return -1;
+    int c0 = GraphPick_Cell(qx - maxDist, pick->cols), c1 = GraphPick_Cell(qx + maxDist, pick->cols);
+    int r0 = GraphPick_Cell(qy - maxDist, pick->rows), r1 = GraphPick_Cell(qy + maxDist, pick->rows);
+
+    int best = -1;
+    float bestDist = maxDist * maxDist;
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cell = r * pick->cols + c;
+            for (int k = pick->cellStart[cell]; k < pick->cellStart[cell + 1]; k++) {
+                float dx = pick->px[k] - qx, dy = pick->py[k] - qy;
+                float d = dx * dx + dy * dy;
+                if (d <= bestDist) { bestDist = d; best = pick->items[k]; }
+            }
+        }
+    }
+    return best;
+}
+
+int GraphPick_NearestSorted(const float *x, int count, float value) {
+    if (count <= 0) return -1;
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (x[mid] < value) lo = mid + 1; else hi = mid;
+    }
+    if (lo == count) return count - 1;
+    if (lo > 0 && value - x[lo - 1] <= x[lo] - value) return lo - 1;
+    return lo;
+}
+
+void GraphPick_Free(GraphPick *pick) {
+    free(pick->cellStart);
+    free(pick->items);
+    free(pick->px);
+    free(pick->py);
+    *pick = (GraphPick){ 0 };
+}
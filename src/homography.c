@@ -0,0 +1,79 @@
+#include "homography.h"
+#include <math.h>
+
+// Aire minimale de chaque triangle de coins consécutifs, relative au rectangle englobant.
+#define HOMOGRAPHY_MIN_AREA_RATIO 0.01
+
+// Sens de parcours d'un quadrilatère convexe non dégénéré (+1 ou -1), 0 sinon :
+// les produits vectoriels des arêtes consécutives doivent tous avoir le même signe
+// (ni croisement, ni coin rentrant) et aucun triangle de coins ne doit être aplati.
+static int Homography_QuadWinding(const Vector2 q[4]) {
+    double minX = q[0].x, maxX = q[0].x, minY = q[0].y, maxY = q[0].y;
+    for (int i = 1; i < 4; i++) {
+        minX = fmin(minX, q[i].x); maxX = fmax(maxX, q[i].x);
+        minY = fmin(minY, q[i].y); maxY = fmax(maxY, q[i].y);
+    }
+    double minArea = HOMOGRAPHY_MIN_AREA_RATIO * 2.0 * (maxX - minX) * (maxY - minY);
+    if (minArea <= 0) return 0;
+
+    int sign = 0;
+    for (int i = 0; i < 4; i++) {
+        Vector2 a = q[i], b = q[(i + 1) % 4], c = q[(i + 2) % 4];
+        double cross = ((double)b.x - a.x) * ((double)c.y - b.y) - ((double)b.y - a.y) * ((double)c.x - b.x);
+        if (fabs(cross) < minArea) return 0;
+        int s = (cross > 0) ? 1 : -1;
+        if (sign != 0 && s != sign) return 0;
+        sign = s;
+    }
+    return sign;
+}
+
+// Système 8x8 de la DLT, résolu par élimination de Gauss avec pivot partiel.
+bool Homography_FromQuad(const Vector2 src[4], const Vector2 dst[4], float H[9]) {
+    int winding = Homography_QuadWinding(src);
+    if (winding == 0 || winding != Homography_QuadWinding(dst)) return false;
+
+    double a[8][9];
+    for (int i = 0; i < 4; i++) {
+        double x = src[i].x, y = src[i].y, u = dst[i].x, v = dst[i].y;
+        double *r0 = a[2 * i], *r1 = a[2 * i + 1];
+        r0[0] = x; r0[1] = y; r0[2] = 1; r0[3] = 0; r0[4] = 0; r0[5] = 0; r0[6] = -u * x; r0[7] = -u * y; r0[8] = u;
+        r1[0] = 0; r1[1] = 0; r1[2] = 0; r1[3] = x; r1[4] = y; r1[5] = 1; r1[6] = -v * x; r1[7] = -v * y; r1[8] = v;
+    }
+
+    for (int col = 0; col < 8; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < 8; r++) {
+            if (fabs(a[r][col]) > fabs(a[pivot][col])) pivot = r;
+        }
+        if (fabs(a[pivot][col]) < 1e-12) return false;
+        if (pivot != col) {
+            for (int k = 0; k < 9; k++) { double tmp = a[col][k]; a[col][k] = a[pivot][k]; a[pivot][k] = tmp; }
+        }
+        for (int r = 0; r < 8; r++) {
+            if (r == col) continue;
+            double f = a[r][col] / a[col][col];
+            for (int k = col; k < 9; k++) a[r][k] -= f * a[col][k];
+        }
+    }
+
+    for (int i = 0; i < 8; i++) H[i] = (float)(a[i][8] / a[i][i]);
+    H[8] = 1.0f;
+    return true;
+}
+
+Vector2 Homography_Apply(const float H[9], Vector2 p) {
+    float w = H[6] * p.x + H[7] * p.y + H[8];
+    if (fabsf(w) < 1e-12f) return (Vector2){ 0, 0 };
+    return (Vector2){ (H[0] * p.x + H[1] * p.y + H[2]) / w, (H[3] * p.x + H[4] * p.y + H[5]) / w };
+}
+
+void Homography_Multiply(const float A[9], const float B[9], float out[9]) {
+    float r[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i * 3 + j] = A[i * 3] * B[j] + A[i * 3 + 1] * B[3 + j] + A[i * 3 + 2] * B[6 + j];
+        }
+    }
+    for (int i = 0; i < 9; i++) out[i] = r[i];
+}
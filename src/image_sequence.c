@@ -0,0 +1,393 @@
+#include "image_sequence.h"
+#include "job_system.h"
+#include "raylib.h"
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libswscale/swscale.h>
+#include <libavutil/imgutils.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+
+#define SEQUENCE_EXTENSIONS ".png;.tif;.tiff;.jpg;.jpeg;.bmp;.dpx"
+
+typedef struct {
+    Job *job;
+    ImageSequence *seq;
+    FrameCache *cache;
+    VideoCrop crop;
+    long long frameIdx;
+    double time;
+} PrefetchTask;
+
+struct ImageSequence {
+    char **paths;
+    int count;
+    int width;
+    int height;
+    char codecName[32];
+    char pixelFormat[32];
+    PrefetchTask tasks[SEQUENCE_MAX_INFLIGHT];
+};
+
+// Tri naturel : "img_2" avant "img_10" même sans zéros de remplissage.
+static int NaturalCompare(const char *a, const char *b) {
+    while (*a && *b) {
+        if (isdigit((unsigned char)*a) && isdigit((unsigned char)*b)) {
+            while (*a == '0') a++;
+            while (*b == '0') b++;
+            const char *ea = a, *eb = b;
+            while (isdigit((unsigned char)*ea)) ea++;
+            while (isdigit((unsigned char)*eb)) eb++;
+            if (ea - a != eb - b) return (int)((ea - a) - (eb - b));
+            int cmp = strncmp(a, b, ea - a);
+            if (cmp != 0) return cmp;
+            a = ea;
+            b = eb;
+        } else {
+            int ca = tolower((unsigned char)*a), cb = tolower((unsigned char)*b);
+            if (ca != cb) return ca - cb;
+            a++;
+            b++;
+        }
+    }
+    return (unsigned char)*a - (unsigned char)*b;
+}
+
+static int ComparePaths(const void *pa, const void *pb) {
+    return NaturalCompare(*(const char *const *)pa, *(const char *const *)pb);
+}
+
+// Motif "img_%05d.tif" découpé à la main : le chemin vient de l'utilisateur et ne
+// doit jamais servir de format à printf.
+typedef struct {
+    char prefix[1024];
+    char suffix[256];
+    int width;
+    bool zeroPad;
+} SequencePattern;
+
+static bool AppendChar(char *dst, size_t size, size_t *len, char c) {
+    if (*len + 1 >= size) return false;
+    dst[(*len)++] = c;
+    dst[*len] = '\0';
+    return true;
+}
+
+// Exactement une conversion %d (avec éventuellement 0 et une largeur), "%%" pour un
+// '%' littéral, toute autre conversion est refusée.
+static bool ParsePattern(const char *source, SequencePattern *pat) {
+    memset(pat, 0, sizeof(*pat));
+    bool found = false;
+    size_t len = 0;
+    for (const char *p = source; *p; p++) {
+        char *part = found ? pat->suffix : pat->prefix;
+        size_t size = found ? sizeof(pat->suffix) : sizeof(pat->prefix);
+        if (*p != '%') {
+            if (!AppendChar(part, size, &len, *p)) return false;
+            continue;
+        }
+        p++;
+        if (*p == '%') {
+            if (!AppendChar(part, size, &len, '%')) return false;
+            continue;
+        }
+        if (found) return false;
+        if (*p == '0') { pat->zeroPad = true; p++; }
+        while (isdigit((unsigned char)*p)) {
+            pat->width = pat->width * 10 + (*p - '0');
+            if (pat->width > 32) return false;
+            p++;
+        }
+        if (*p != 'd') return false;
+        found = true;
+        len = 0;
+    }
+    // Le numéro doit être dans le nom de fichier pour pouvoir parcourir le dossier.
+    return found && !strchr(pat->suffix, '/') && !strchr(pat->suffix, '\\');
+}
+
+static bool FormatPattern(const SequencePattern *pat, int index, char *dst, size_t size) {
+    int n = pat->zeroPad ? snprintf(dst, size, "%s%0*d%s", pat->prefix, pat->width, index, pat->suffix)
+                         : snprintf(dst, size, "%s%*d%s", pat->prefix, pat->width, index, pat->suffix);
+    return n > 0 && (size_t)n < size;
+}
+
+static bool IsPattern(const char *source) {
+    SequencePattern pat;
+    return ParsePattern(source, &pat);
+}
+
+static bool AppendPath(ImageSequence *seq, int *capacity, const char *path) {
+    if (seq->count >= *capacity) {
+        int newCap = (*capacity > 0) ? *capacity * 2 : 256;
+        char **grown = (char **)realloc(seq->paths, newCap * sizeof(char *));
+        if (!grown) return false;
+        seq->paths = grown;
+        *capacity = newCap;
+    }
+    size_t len = strlen(path);
+    char *copy = (char *)malloc(len + 1);
+    if (!copy) return false;
+    memcpy(copy, path, len + 1);
+    seq->paths[seq->count++] = copy;
+    return true;
+}
+
+// Plus petit numéro présent dans le dossier dont le nom correspond exactement au motif.
+static int FirstPatternIndex(const SequencePattern *pat) {
+    const char *sep = NULL;
+    for (const char *p = pat->prefix; *p; p++) {
+        if (*p == '/' || *p == '\\') sep = p;
+    }
+    char dir[1024] = ".";
+    const char *namePrefix = pat->prefix;
+    if (sep) {
+        size_t dirLen = (sep == pat->prefix) ? 1 : (size_t)(sep - pat->prefix);
+        memcpy(dir, pat->prefix, dirLen);
+        dir[dirLen] = '\0';
+        namePrefix = sep + 1;
+    }
+    size_t prefixLen = strlen(namePrefix);
+
+    int first = -1;
+    char expected[1024];
+    FilePathList files = LoadDirectoryFiles(dir);
+    for (unsigned int i = 0; i < files.count; i++) {
+        const char *name = GetFileName(files.paths[i]);
+        if (strncmp(name, namePrefix, prefixLen) != 0) continue;
+        const char *digits = name + prefixLen;
+        while (*digits == ' ') digits++;
+        if (!isdigit((unsigned char)*digits)) continue;
+        long value = strtol(digits, NULL, 10);
+        if (value > 999999999) continue;
+        // Reformater le numéro vérifie d'un coup largeur, remplissage et suffixe.
+        if (!FormatPattern(pat, (int)value, expected, sizeof(expected))) continue;
+        if (strcmp(GetFileName(expected), name) != 0) continue;
+        if (first < 0 || value < first) first = (int)value;
+    }
+    UnloadDirectoryFiles(files);
+    return first;
+}
+
+static void ListPattern(ImageSequence *seq, const char *source) {
+    SequencePattern pat;
+    if (!ParsePattern(source, &pat)) return;
+
+    int start = FirstPatternIndex(&pat);
+    if (start < 0) return;
+
+    int capacity = 0;
+    char path[1024];
+    for (int i = start; ; i++) {
+        if (!FormatPattern(&pat, i, path, sizeof(path))) break;
+        if (!FileExists(path) || !AppendPath(seq, &capacity, path)) break;
+    }
+}
+
+// Toutes les images du dossier qui portent l'extension demandée (ou celle de la
+// première image trouvée si extension == NULL).
+static void ListDirectory(ImageSequence *seq, const char *dir, const char *extension) {
+    FilePathList files = LoadDirectoryFiles(dir);
+    qsort(files.paths, files.count, sizeof(char *), ComparePaths);
+
+    char ext[16] = { 0 };
+    if (extension) strncpy(ext, extension, sizeof(ext) - 1);
+
+    int capacity = 0;
+    for (unsigned int i = 0; i < files.count; i++) {
+        const char *path = files.paths[i];
+        if (!IsPathFile(path) || !IsFileExtension(path, SEQUENCE_EXTENSIONS)) continue;
+        if (ext[0] == '\0') strncpy(ext, GetFileExtension(path), sizeof(ext) - 1);
+        if (!IsFileExtension(path, ext)) continue;
+        if (!AppendPath(seq, &capacity, path)) break;
+    }
+    UnloadDirectoryFiles(files);
+}
+
+// Ouvre un fichier image avec FFmpeg et renvoie sa première image décodée.
+static AVFrame* LoadImageFrame(const char *path, enum AVCodecID *outCodec) {
+    AVFormatContext *formatCtx = NULL;
+    AVCodecContext *codecCtx = NULL;
+    AVPacket *packet = NULL;
+    AVFrame *frame = NULL;
+    bool ok = false;
+
+    if (avformat_open_input(&formatCtx, path, NULL, NULL) != 0) return NULL;
+    if (avformat_find_stream_info(formatCtx, NULL) < 0) goto end;
+
+    int streamIndex = av_find_best_stream(formatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
+    if (streamIndex < 0) goto end;
+
+    AVCodecParameters *codecParams = formatCtx->streams[streamIndex]->codecpar;
+    const AVCodec *codec = avcodec_find_decoder(codecParams->codec_id);
+    codecCtx = avcodec_alloc_context3(codec);
+    if (!codecCtx) goto end;
+    avcodec_parameters_to_context(codecCtx, codecParams);
+    codecCtx->thread_count = 1;
+    if (avcodec_open2(codecCtx, codec, NULL) < 0) goto end;
+    if (outCodec) *outCodec = codecParams->codec_id;
+
+    packet = av_packet_alloc();
+    frame = av_frame_alloc();
+    if (!packet || !frame) goto end;
+
+    while (!ok && av_read_frame(formatCtx, packet) >= 0) {
+        if (packet->stream_index == streamIndex && avcodec_send_packet(codecCtx, packet) == 0) {
+            ok = (avcodec_receive_frame(codecCtx, frame) == 0);
+        }
+        av_packet_unref(packet);
+    }
+    if (!ok && avcodec_send_packet(codecCtx, NULL) == 0) {
+        ok = (avcodec_receive_frame(codecCtx, frame) == 0);
+    }
+
+end:
+    if (!ok && frame) av_frame_free(&frame);
+    if (packet) av_packet_free(&packet);
+    if (codecCtx) avcodec_free_context(&codecCtx);
+    avformat_close_input(&formatCtx);
+    return frame;
+}
+
+static bool ConvertFrame(AVFrame *frame, uint8_t *dst, const VideoCrop *crop) {
+    int width = crop->width;
+    int height = crop->height;
+    VideoCrop_Apply(crop, frame);
+    struct SwsContext *sws = sws_getContext(frame->width, frame->height, frame->format,
+                                            width, height, AV_PIX_FMT_RGB24,
+                                            SWS_BILINEAR, NULL, NULL, NULL);
+    if (!sws) return false;
+
+    uint8_t *dstData[4] = { dst, NULL, NULL, NULL };
+    int dstLinesize[4] = { width * 3, 0, 0, 0 };
+    sws_scale(sws, (const uint8_t *const *)frame->data, frame->linesize, 0, frame->height, dstData, dstLinesize);
+    sws_freeContext(sws);
+    return true;
+}
+
+bool ImageSequence_IsSource(const char *source) {
+    if (!source || !*source) return false;
+    if (IsPattern(source)) return true;
+    if (DirectoryExists(source)) return true;
+    return IsFileExtension(source, SEQUENCE_EXTENSIONS);
+}
+
+ImageSequence* ImageSequence_Open(const char *source) {
+    if (!ImageSequence_IsSource(source)) return NULL;
+
+    ImageSequence *seq = (ImageSequence *)calloc(1, sizeof(ImageSequence));
+    if (!seq) return NULL;
+
+    if (IsPattern(source)) {
+        ListPattern(seq, source);
+    } else if (DirectoryExists(source)) {
+        ListDirectory(seq, source, NULL);
+    } else {
+        char dir[1024];
+        strncpy(dir, GetDirectoryPath(source), sizeof(dir) - 1);
+        dir[sizeof(dir) - 1] = '\0';
+        char ext[16] = { 0 };
+        strncpy(ext, GetFileExtension(source), sizeof(ext) - 1);
+        ListDirectory(seq, dir, ext);
+    }
+    if (seq->count == 0) {
+        ImageSequence_Close(seq);
+        return NULL;
+    }
+
+    enum AVCodecID codecId = AV_CODEC_ID_NONE;
+    AVFrame *first = LoadImageFrame(seq->paths[0], &codecId);
+    if (!first) {
+        ImageSequence_Close(seq);
+        return NULL;
+    }
+    seq->width = first->width;
+    seq->height = first->height;
+    const char *cName = avcodec_get_name(codecId);
+    if (cName) strncpy(seq->codecName, cName, sizeof(seq->codecName) - 1);
+    const char *pName = av_get_pix_fmt_name(first->format);
+    if (pName) strncpy(seq->pixelFormat, pName, sizeof(seq->pixelFormat) - 1);
+    av_frame_free(&first);
+
+    return seq;
+}
+
+void ImageSequence_Wait(ImageSequence *seq) {
+    if (!seq) return;
+    for (int i = 0; i < SEQUENCE_MAX_INFLIGHT; i++) {
+        if (seq->tasks[i].job) Job_Wait(seq->tasks[i].job);
+        seq->tasks[i].job = NULL;
+    }
+}
+
+void ImageSequence_Close(ImageSequence *seq) {
+    if (!seq) return;
+    ImageSequence_Wait(seq);
+    for (int i = 0; i < seq->count; i++) free(seq->paths[i]);
+    free(seq->paths);
+    free(seq);
+}
+
+int ImageSequence_Count(const ImageSequence *seq) { return seq ? seq->count : 0; }
+int ImageSequence_Width(const ImageSequence *seq) { return seq ? seq->width : 0; }
+int ImageSequence_Height(const ImageSequence *seq) { return seq ? seq->height : 0; }
+const char* ImageSequence_CodecName(const ImageSequence *seq) { return seq ? seq->codecName : ""; }
+const char* ImageSequence_PixelFormat(const ImageSequence *seq) { return seq ? seq->pixelFormat : ""; }
+
+bool ImageSequence_Decode(ImageSequence *seq, long long frameIdx, const VideoCrop *crop, uint8_t *dst) {
+    if (!seq || frameIdx < 0 || frameIdx >= seq->count) return false;
+
+    AVFrame *frame = LoadImageFrame(seq->paths[frameIdx], NULL);
+    if (!frame) return false;
+    bool ok = ConvertFrame(frame, dst, crop);
+    av_frame_free(&frame);
+    return ok;
+}
+
+static void PrefetchJob(void *arg) {
+    PrefetchTask *task = (PrefetchTask *)arg;
+    uint8_t *dst = FrameCache_BeginWrite(task->cache, task->frameIdx);
+    if (!dst) return;
+    bool ok = ImageSequence_Decode(task->seq, task->frameIdx, &task->crop, dst);
+    FrameCache_EndWrite(task->cache, task->frameIdx, task->time, ok);
+}
+
+void ImageSequence_Prefetch(ImageSequence *seq, FrameCache *cache, const VideoCrop *crop, long long fromIdx, int direction, int count, double fps) {
+    if (!seq || !cache || !crop || fps <= 0) return;
+    if (count > SEQUENCE_MAX_INFLIGHT) count = SEQUENCE_MAX_INFLIGHT;
+    direction = (direction < 0) ? -1 : 1;
+
+    for (int i = 0; i < SEQUENCE_MAX_INFLIGHT; i++) {
+        PrefetchTask *task = &seq->tasks[i];
+        if (task->job && Job_IsDone(task->job)) {
+            Job_Wait(task->job);
+            task->job = NULL;
+        }
+    }
+
+    int freeSlot = 0;
+    for (int k = 1; k <= count; k++) {
+        long long idx = fromIdx + (long long)k * direction;
+        if (idx < 0 || idx >= seq->count) break;
+        if (FrameCache_Contains(cache, idx)) continue;
+
+        bool inFlight = false;
+        for (int i = 0; i < SEQUENCE_MAX_INFLIGHT; i++) {
+            if (seq->tasks[i].job && seq->tasks[i].frameIdx == idx) { inFlight = true; break; }
+        }
+        if (inFlight) continue;
+
+        while (freeSlot < SEQUENCE_MAX_INFLIGHT && seq->tasks[freeSlot].job) freeSlot++;
+        if (freeSlot >= SEQUENCE_MAX_INFLIGHT) break;
+
+        PrefetchTask *task = &seq->tasks[freeSlot];
+        task->seq = seq;
+        task->cache = cache;
+        task->crop = *crop;
+        task->frameIdx = idx;
+        task->time = idx / fps;
+        task->job = Job_Submit(PrefetchJob, task);
+    }
+}
@@ -0,0 +1,176 @@
+#include "job_system.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+struct Job {
+    JobFunc func;
+    void *arg;
+    bool done;
+    std::mutex m;
+    std::condition_variable cv;
+};
+
+struct JobMutex {
+    std::mutex m;
+};
+
+struct RangeTask {
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+    int count;
+    int chunk;
+    JobRangeFunc func;
+    void *ctx;
+    std::mutex m;
+    std::condition_variable cv;
+};
+
+static std::vector<std::thread> workers;
+static std::deque<std::function<void()>> queue;
+static std::mutex queueMutex;
+static std::condition_variable queueCv;
+static bool stopping = false;
+
+static void WorkerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCv.wait(lock, [] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
+
+static void Enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(std::move(task));
+    }
+    queueCv.notify_one();
+}
+
+// Chaque participant (workers et appelant) prend des tranches jusqu'à épuisement.
+// Un worker qui démarre après la fin ne touche plus ctx : il ne trouve plus de tranche.
+static void RunRanges(const std::shared_ptr<RangeTask> &task) {
+    int begin;
+    while ((begin = task->next.fetch_add(task->chunk)) < task->count) {
+        int end = begin + task->chunk;
+        if (end > task->count) end = task->count;
+        task->func(task->ctx, begin, end);
+        if (task->done.fetch_add(end - begin) + (end - begin) == task->count) {
+            std::lock_guard<std::mutex> lock(task->m);
+            task->cv.notify_all();
+        }
+    }
+}
+
+extern "C" {
+
+void JobSystem_Init(int workerCount) {
+    if (!workers.empty()) return;
+    if (workerCount <= 0) {
+        workerCount = (int)std::thread::hardware_concurrency();
+        if (workerCount <= 0) workerCount = 2;
+    }
+    stopping = false;
+    for (int i = 0; i < workerCount; i++) workers.emplace_back(WorkerLoop);
+}
+
+void JobSystem_Shutdown(void) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCv.notify_all();
+    for (auto &t : workers) t.join();
+    workers.clear();
+}
+
+int JobSystem_WorkerCount(void) {
+    return (int)workers.size();
+}
+
+Job* Job_Submit(JobFunc func, void *arg) {
+    Job *job = new Job();
+    job->func = func;
+    job->arg = arg;
+    job->done = false;
+
+    auto run = [job] {
+        job->func(job->arg);
+        std::lock_guard<std::mutex> lock(job->m);
+        job->done = true;
+        job->cv.notify_all();
+    };
+
+    if (workers.empty()) run();
+    else Enqueue(run);
+    return job;
+}
+
+bool Job_IsDone(Job *job) {
+    if (!job) return true;
+    std::lock_guard<std::mutex> lock(job->m);
+    return job->done;
+}
+
+void Job_Wait(Job *job) {
+    if (!job) return;
+    {
+        std::unique_lock<std::mutex> lock(job->m);
+        job->cv.wait(lock, [job] { return job->done; });
+    }
+    delete job;
+}
+
+void Job_ParallelFor(int count, int minChunk, JobRangeFunc func, void *ctx) {
+    if (count <= 0) return;
+    if (minChunk < 1) minChunk = 1;
+
+    int participants = (int)workers.size() + 1;
+    int chunk = (count + participants * 4 - 1) / (participants * 4);
+    if (chunk < minChunk) chunk = minChunk;
+
+    auto task = std::make_shared<RangeTask>();
+    task->count = count;
+    task->chunk = chunk;
+    task->func = func;
+    task->ctx = ctx;
+
+    int helpers = (count + chunk - 1) / chunk - 1;
+    if (helpers > (int)workers.size()) helpers = (int)workers.size();
+    for (int i = 0; i < helpers; i++) Enqueue([task] { RunRanges(task); });
+
+    RunRanges(task);
+
+    std::unique_lock<std::mutex> lock(task->m);
+    task->cv.wait(lock, [&task] { return task->done.load() >= task->count; });
+}
+
+JobMutex* JobMutex_Create(void) {
+    return new JobMutex();
+}
+
+void JobMutex_Destroy(JobMutex *mutex) {
+    delete mutex;
+}
+
+void JobMutex_Lock(JobMutex *mutex) {
+    mutex->m.lock();
+}
+
+void JobMutex_Unlock(JobMutex *mutex) {
+    mutex->m.unlock();
+}
+
+}
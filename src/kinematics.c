@@ -0,0 +1,448 @@
+#include "kinematics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define KINEMATICS_MAX_ORDER 6
+#define KINEMATICS_HISTORY 16
+// Écart toléré entre un pas de la fenêtre et le pas médian avant de quitter les noyaux.
+#define KINEMATICS_STEP_TOLERANCE 1.5f
+
+struct Kinematics {
+    DiffSettings settings;
+    int half;
+    int size;
+    // [dérivée 1 ou 2][position dans la fenêtre][coefficient], pour un pas unitaire.
+    float *kernels;
+    // Mêmes noyaux sur 2*shortHalf+1 points, pour une série plus courte que la fenêtre.
+    float *shortKernels;
+    int shortHalf;
+
+    int first;
+    int count;
+    int capacity;
+    float *t, *x, *y;
+    float *vx, *vy, *ax, *ay;
+
+    unsigned int seenEdit;  // ts->editRevision au dernier appel
+    bool seenValid;
+    // Premier indice recalculé pour chacune des dernières versions.
+    unsigned int version;
+    int changedFrom[KINEMATICS_HISTORY];
+};
+
+DiffSettings Kinematics_DefaultSettings(void) {
+    return (DiffSettings){ DIFF_SAVGOL, 3, 2, 4.0f };
+}
+
+// Inversion de Gauss-Jordan en double (matrices de quelques dizaines de lignes au plus).
+static bool InvertMatrix(double *a, double *inv, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) inv[i * n + j] = (i == j) ? 1.0 : 0.0;
+    }
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < n; r++) {
+            if (fabs(a[r * n + col]) > fabs(a[pivot * n + col])) pivot = r;
+        }
+        if (fabs(a[pivot * n + col]) < 1e-14) return false;
+        if (pivot != col) {
+            for (int k = 0; k < n; k++) {
+                double t = a[col * n + k]; a[col * n + k] = a[pivot * n + k]; a[pivot * n + k] = t;
+                t = inv[col * n + k]; inv[col * n + k] = inv[pivot * n + k]; inv[pivot * n + k] = t;
+            }
+        }
+        double d = a[col * n + col];
+        for (int k = 0; k < n; k++) { a[col * n + k] /= d; inv[col * n + k] /= d; }
+        for (int r = 0; r < n; r++) {
+            if (r == col) continue;
+            double f = a[r * n + col];
+            if (f == 0.0) continue;
+            for (int k = 0; k < n; k++) { a[r * n + k] -= f * a[col * n + k]; inv[r * n + k] -= f * inv[col * n + k]; }
+        }
+    }
+    return true;
+}
+
+// Savitzky-Golay : dérivée en z_s du polynôme des moindres carrés sur z_j = j - half.
+// Les lignes s != half servent aux bords de la série.
+static bool BuildSavGol(float *kernels, int half, int order) {
+    int n = 2 * half + 1, p = order + 1;
+    double ata[KINEMATICS_MAX_ORDER * KINEMATICS_MAX_ORDER], inv[KINEMATICS_MAX_ORDER * KINEMATICS_MAX_ORDER];
+    for (int a = 0; a < p; a++) {
+        for (int b = 0; b < p; b++) {
+            double s = 0;
+            for (int j = 0; j < n; j++) s += pow(j - half, a + b);
+            ata[a * p + b] = s;
+        }
+    }
+    if (!InvertMatrix(ata, inv, p)) return false;
+
+    for (int d = 1; d <= 2; d++) {
+        for (int s = 0; s < n; s++) {
+            double z = s - half;
+            double e[KINEMATICS_MAX_ORDER] = { 0 };
+            for (int k = d; k < p; k++) e[k] = (d == 1) ? k * pow(z, k - 1) : k * (k - 1) * pow(z, k - 2);
+            double row[KINEMATICS_MAX_ORDER] = { 0 };
+            for (int b = 0; b < p; b++) {
+                for (int a = 0; a < p; a++) row[b] += e[a] * inv[a * p + b];
+            }
+            float *w = kernels + ((d - 1) * n + s) * n;
+            for (int j = 0; j < n; j++) {
+                double v = 0, zj = j - half, pw = 1.0;
+                for (int b = 0; b < p; b++) { v += row[b] * pw; pw *= zj; }
+                w[j] = (float)v;
+            }
+        }
+    }
+    return true;
+}
+
+// Lisseur de Whittaker (équivalent discret d'une spline de lissage) :
+// S = (I + lambda D'D)^-1, puis différences sur la série lissée. La pénalité
+// porte sur les différences d'ordre 3 pour que l'accélération ne soit pas
+// forcée à zéro aux extrémités comme avec une spline cubique naturelle.
+static bool BuildSpline(float *kernels, int half, float lambda) {
+    int n = 2 * half + 1;
+    double *a = (double *)calloc((size_t)n * n, sizeof(double));
+    double *smooth = (double *)malloc((size_t)n * n * sizeof(double));
+    if (!a || !smooth) { free(a); free(smooth); return false; }
+
+    for (int i = 0; i < n; i++) a[i * n + i] = 1.0;
+    for (int r = 0; r + 3 < n; r++) {
+        const double d[4] = { -1.0, 3.0, -3.0, 1.0 };
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) a[(r + i) * n + (r + j)] += lambda * d[i] * d[j];
+        }
+    }
+    bool ok = InvertMatrix(a, smooth, n);
+
+    for (int s = 0; ok && s < n; s++) {
+        int lo = (s > 0) ? s - 1 : 0, hi = (s < n - 1) ? s + 1 : n - 1;
+        int c = s;
+        if (c == 0) c = 1;
+        if (c == n - 1) c = n - 2;
+        float *w1 = kernels + s * n;
+        float *w2 = kernels + (n + s) * n;
+        for (int j = 0; j < n; j++) {
+            w1[j] = (float)((smooth[hi * n + j] - smooth[lo * n + j]) / (hi - lo));
+            w2[j] = (float)(smooth[(c + 1) * n + j] - 2.0 * smooth[c * n + j] + smooth[(c - 1) * n + j]);
+        }
+    }
+    free(a);
+    free(smooth);
+    return ok;
+}
+
+static DiffSettings ClampSettings(DiffSettings s) {
+    if (s.method < 0 || s.method >= DIFF_METHOD_COUNT) s.method = DIFF_SAVGOL;
+    if (s.order < 2) s.order = 2;
+    if (s.order > KINEMATICS_MAX_ORDER - 1) s.order = KINEMATICS_MAX_ORDER - 1;
+    if (s.half < 1) s.half = 1;
+    if (s.half > KINEMATICS_MAX_HALF) s.half = KINEMATICS_MAX_HALF;
+    if (s.order > 2 * s.half) s.half = (s.order + 1) / 2;
+    if (s.lambda < 0.01f) s.lambda = 0.01f;
+    if (s.lambda > 1e6f) s.lambda = 1e6f;
+    return s;
+}
+
+Kinematics* Kinematics_Create(void) {
+    Kinematics *k = (Kinematics *)calloc(1, sizeof(Kinematics));
+    if (!k) return NULL;
+    Kinematics_Configure(k, Kinematics_DefaultSettings());
+    return k;
+}
+
+void Kinematics_Destroy(Kinematics *k) {
+    if (!k) return;
+    free(k->kernels);
+    free(k->shortKernels);
+    free(k->t); free(k->x); free(k->y);
+    free(k->vx); free(k->vy); free(k->ax); free(k->ay);
+    free(k);
+}
+
+void Kinematics_Configure(Kinematics *k, DiffSettings settings) {
+    settings = ClampSettings(settings);
+    if (k->kernels && memcmp(&settings, &k->settings, sizeof(DiffSettings)) == 0) return;
+
+    int half = settings.half;
+    if (settings.method == DIFF_CENTRAL) half = 1;
+    // Largeur du noyau équivalent du lisseur : ~ lambda^(1/6).
+    if (settings.method == DIFF_SPLINE) half = (int)ceilf(4.0f * powf(settings.lambda, 1.0f / 6.0f)) + 2;
+    if (half > KINEMATICS_MAX_HALF) half = KINEMATICS_MAX_HALF;
+
+    int size = 2 * half + 1;
+    float *kernels = (float *)malloc((size_t)2 * size * size * sizeof(float));
+    if (!kernels) return;
+    bool ok = (settings.method == DIFF_SPLINE) ? BuildSpline(kernels, half, settings.lambda)
+                                               : BuildSavGol(kernels, half, (settings.method == DIFF_CENTRAL) ? 2 : settings.order);
+    if (!ok) {
+        free(kernels);
+        return;
+    }
+
+    free(k->kernels);
+    k->kernels = kernels;
+    k->settings = settings;
+    k->half = half;
+    k->size = size;
+    k->shortHalf = 0;
+    k->count = 0;
+}
+
+DiffSettings Kinematics_Settings(const Kinematics *k) {
+    return k->settings;
+}
+
+int Kinematics_WindowSize(const Kinematics *k) {
+    return k->size;
+}
+
+static bool Kinematics_Reserve(Kinematics *k, int count) {
+    if (count <= k->capacity) return true;
+    int cap = (k->capacity > 0) ? k->capacity : 256;
+    while (cap < count) cap *= 2;
+    float **arrays[] = { &k->t, &k->x, &k->y, &k->vx, &k->vy, &k->ax, &k->ay };
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        float *grown = (float *)realloc(*arrays[i], (size_t)cap * sizeof(float));
+        if (!grown) return false;
+        *arrays[i] = grown;
+    }
+    k->capacity = cap;
+    return true;
+}
+
+// Série plus courte que la fenêtre : plus grande fenêtre impaire qu'elle remplit,
+// degré ramené à ce que cette fenêtre peut porter.
+static const float* Kinematics_ShortKernels(Kinematics *k, int span) {
+    int half = (span - 1) / 2;
+    if (half == k->shortHalf) return k->shortKernels;
+
+    int n = 2 * half + 1;
+    float *kernels = (float *)realloc(k->shortKernels, (size_t)2 * n * n * sizeof(float));
+    if (!kernels) return NULL;
+    k->shortKernels = kernels;
+    int order = (k->settings.method == DIFF_CENTRAL) ? 2 : k->settings.order;
+    if (order > n - 1) order = n - 1;
+    bool ok = (k->settings.method == DIFF_SPLINE) ? BuildSpline(kernels, half, k->settings.lambda)
+                                                  : BuildSavGol(kernels, half, order);
+    k->shortHalf = ok ? half : 0;
+    return ok ? kernels : NULL;
+}
+
+// Les noyaux supposent un pas constant : une image manquante ou des temps dans le
+// désordre (pas nul ou de signe changeant) rendent la fenêtre irrégulière.
+static bool Kinematics_IsUniform(const float *t, int n) {
+    float steps[2 * KINEMATICS_MAX_HALF];
+    int m = n - 1;
+    float dir = t[n - 1] - t[0];
+    for (int j = 0; j < m; j++) {
+        float d = t[j + 1] - t[j];
+        if (d * dir <= 0.0f) return false;
+        float a = fabsf(d);
+        int r = j;
+        while (r > 0 && steps[r - 1] > a) { steps[r] = steps[r - 1]; r--; }
+        steps[r] = a;
+    }
+    float median = steps[m / 2];
+    return steps[m - 1] <= KINEMATICS_STEP_TOLERANCE * median && steps[0] * KINEMATICS_STEP_TOLERANCE >= median;
+}
+
+// Fenêtre irrégulière : polynôme des moindres carrés sur les temps réels, centré sur
+// l'image i (degré de Savitzky-Golay, 2 pour les autres méthodes), dérivé en t_i.
+static void Kinematics_LocalFit(Kinematics *k, int i, int start, int n) {
+    const float *ts = k->t + start, *xs = k->x + start, *ys = k->y + start;
+    float tMin = ts[0], tMax = ts[0];
+    for (int j = 1; j < n; j++) { tMin = fminf(tMin, ts[j]); tMax = fmaxf(tMax, ts[j]); }
+    double scale = ((double)tMax - tMin) / (n - 1);
+    k->vx[i] = k->vy[i] = k->ax[i] = k->ay[i] = 0.0f;
+    if (scale < 1e-9) return;
+
+    int order = (k->settings.method == DIFF_SAVGOL) ? k->settings.order : 2;
+    if (order > n - 1) order = n - 1;
+    // Des temps confondus peuvent ne pas porter le degré demandé : on le réduit.
+    for (int p = order + 1; p >= 2; p--) {
+        double ata[KINEMATICS_MAX_ORDER * KINEMATICS_MAX_ORDER] = { 0 }, inv[KINEMATICS_MAX_ORDER * KINEMATICS_MAX_ORDER];
+        double atx[KINEMATICS_MAX_ORDER] = { 0 }, aty[KINEMATICS_MAX_ORDER] = { 0 };
+        for (int j = 0; j < n; j++) {
+            double z = ((double)ts[j] - ts[i - start]) / scale;
+            double dx = (double)xs[j] - xs[i - start], dy = (double)ys[j] - ys[i - start];
+            double pa = 1.0;
+            for (int a = 0; a < p; a++) {
+                double pb = pa * pa;
+                for (int b = a; b < p; b++) { ata[a * p + b] += pb; pb *= z; }
+                atx[a] += pa * dx;
+                aty[a] += pa * dy;
+                pa *= z;
+            }
+        }
+        for (int a = 0; a < p; a++) {
+            for (int b = 0; b < a; b++) ata[a * p + b] = ata[b * p + a];
+        }
+        if (!InvertMatrix(ata, inv, p)) continue;
+
+        double c[2][3] = { { 0 } };
+        for (int d = 1; d < p && d <= 2; d++) {
+            for (int b = 0; b < p; b++) {
+                c[0][d] += inv[d * p + b] * atx[b];
+                c[1][d] += inv[d * p + b] * aty[b];
+            }
+        }
+        k->vx[i] = (float)(c[0][1] / scale);
+        k->vy[i] = (float)(c[1][1] / scale);
+        k->ax[i] = (float)(2.0 * c[0][2] / (scale * scale));
+        k->ay[i] = (float)(2.0 * c[1][2] / (scale * scale));
+        return;
+    }
+}
+
+// Convolution sur [from, to) : chaque image choisit la ligne de noyau qui
+// correspond à sa place dans la fenêtre, le pas est celui de la fenêtre.
+static void Kinematics_Compute(Kinematics *k, int from, int to) {
+    int half = k->half, n = k->size, first = k->first, last = k->count;
+    int span = last - first;
+    const float *kernels = k->kernels;
+    if (span < n) {
+        kernels = (span >= KINEMATICS_MIN_SPAN) ? Kinematics_ShortKernels(k, span) : NULL;
+        if (!kernels) {
+            for (int i = from; i < to; i++) k->vx[i] = k->vy[i] = k->ax[i] = k->ay[i] = 0.0f;
+            return;
+        }
+        half = k->shortHalf;
+        n = 2 * half + 1;
+    }
+    for (int i = from; i < to; i++) {
+        int start = i - half;
+        if (start < first) start = first;
+        if (start > last - n) start = last - n;
+        int s = i - start;
+
+        if (!Kinematics_IsUniform(k->t + start, n)) {
+            Kinematics_LocalFit(k, i, start, n);
+            continue;
+        }
+        float h = (k->t[start + n - 1] - k->t[start]) / (float)(n - 1);
+        if (fabsf(h) < 1e-9f) {
+            k->vx[i] = k->vy[i] = k->ax[i] = k->ay[i] = 0.0f;
+            continue;
+        }
+
+        const float *w1 = kernels + s * n;
+        const float *w2 = kernels + (n + s) * n;
+        const float *xs = k->x + start, *ys = k->y + start;
+        // Les noyaux de dérivée sont de somme nulle : centrer sur le point évalué
+        // évite de perdre la précision des flottants sur de grandes positions.
+        float xr = xs[s], yr = ys[s];
+        float vx = 0, vy = 0, ax = 0, ay = 0;
+        for (int j = 0; j < n; j++) {
+            float dx = xs[j] - xr, dy = ys[j] - yr;
+            vx += w1[j] * dx; vy += w1[j] * dy;
+            ax += w2[j] * dx; ay += w2[j] * dy;
+        }
+        float invH = 1.0f / h;
+        k->vx[i] = vx * invH;
+        k->vy[i] = vy * invH;
+        k->ax[i] = ax * invH * invH;
+        k->ay[i] = ay * invH * invH;
+    }
+}
+
+void Kinematics_Update(Kinematics *k, const TrackingSystem *ts) {
+    if (!k->kernels) return;
+    int count = ts->count;
+    int first = ts->startFrame;
+    if (first < 0) first = 0;
+    if (first > count) first = count;
+    if (!Kinematics_Reserve(k, count)) return;
+
+    // Plage des points modifiés depuis le dernier appel : si la série n'a fait
+    // que s'allonger, seuls les nouveaux points sont lus.
+    int dirtyLo = count, dirtyHi = -1;
+    bool full = (first != k->first);
+    int common = (k->count < count) ? k->count : count;
+    bool appendOnly = k->seenValid && k->seenEdit == ts->editRevision && k->count <= count;
+    for (int i = appendOnly ? common : 0; i < count; i++) {
+        float t = (float)ts->points[i].time, x = ts->physX[i], y = ts->physY[i];
+        if (i >= common || k->t[i] != t || k->x[i] != x || k->y[i] != y) {
+            k->t[i] = t; k->x[i] = x; k->y[i] = y;
+            if (i < dirtyLo) dirtyLo = i;
+            dirtyHi = i;
+        }
+    }
+    k->seenEdit = ts->editRevision;
+    k->seenValid = true;
+    // Série raccourcie : les fenêtres de fin changent.
+    if (count < k->count) {
+        if (count - 1 < dirtyLo) dirtyLo = count - 1;
+        dirtyHi = count - 1;
+    }
+    int oldSpan = k->count - k->first;
+    k->count = count;
+    k->first = first;
+    // Sous la taille de fenêtre, la fenêtre réduite suit la longueur de la série : tout change.
+    if ((oldSpan < k->size || count - first < k->size) && oldSpan != count - first) full = true;
+
+    if (full) {
+        dirtyLo = first;
+        dirtyHi = count - 1;
+    }
+    if (dirtyHi < dirtyLo) return;
+
+    // Une image dépend de la fenêtre [start, start + size) : on élargit de 'size'
+    // pour couvrir aussi les bords, où la fenêtre est décalée.
+    int from = dirtyLo - k->size;
+    int to = dirtyHi + k->size + 1;
+    if (from < first) from = first;
+    if (to > count) to = count;
+    Kinematics_Compute(k, from, to);
+    k->version++;
+    k->changedFrom[k->version % KINEMATICS_HISTORY] = from;
+}
+
+const float* Kinematics_Column(const Kinematics *k, KinematicsColumn column) {
+    switch (column) {
+        case KIN_T: return k->t;
+        case KIN_X: return k->x;
+        case KIN_Y: return k->y;
+        case KIN_VX: return k->vx;
+        case KIN_VY: return k->vy;
+        case KIN_AX: return k->ax;
+        case KIN_AY: return k->ay;
+        default: return NULL;
+    }
+}
+
+int Kinematics_First(const Kinematics *k) {
+    return k->first;
+}
+
+int Kinematics_Count(const Kinematics *k) {
+    return k->count;
+}
+
+unsigned int Kinematics_Version(const Kinematics *k) {
+    return k->version;
+}
+
+bool Kinematics_ChangedSince(const Kinematics *k, unsigned int version, int *from) {
+    unsigned int behind = k->version - version;
+    if (behind >= KINEMATICS_HISTORY) return false;
+    int lo = k->count;
+    for (unsigned int v = version + 1; v != k->version + 1; v++) {
+        int f = k->changedFrom[v % KINEMATICS_HISTORY];
+        if (f < lo) lo = f;
+    }
+    *from = lo;
+    return true;
+}
+
+float Kinematics_Velocity(const Kinematics *k, int index, bool isX) {
+    if (index < k->first || index >= k->count) return 0.0f;
+    return isX ? k->vx[index] : k->vy[index];
+}
+
+float Kinematics_Accel(const Kinematics *k, int index, bool isX) {
+    if (index < k->first || index >= k->count) return 0.0f;
+    return isX ? k->ax[index] : k->ay[index];
+}
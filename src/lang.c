@@ -43,6 +43,8 @@ static const char* dictionary[STR_COUNT][LANG_COUNT] = {
     [T_TO_EXCEL]      = {"Vers Excel (.csv)", "To Excel (.csv)"},
     [T_COPY_CLIPBOARD]= {"Copier presse-papier", "Copy to Clipboard"},
     [T_VIEW_CURVES]   = {"Visualiser les courbes", "View Curves"},
+    [T_VIEW_SPECTRUM] = {"Analyse spectrale", "Spectral Analysis"},
+    [T_VIEW_DERIVED]  = {"Grandeurs dérivées", "Derived Quantities"},
     [T_USER_GUIDE]    = {"Guide utilisateur", "User Guide"},
     [T_LANGUAGE]      = {"Langue : FR", "Language: EN"},
     [T_MSG_LOADED]    = {"Projet chargé", "Project loaded"},
@@ -51,6 +53,8 @@ static const char* dictionary[STR_COUNT][LANG_COUNT] = {
     [T_FILTER_CSV]    = {"Fichier CSV\0*.csv\0", "CSV File\0*.csv\0"},
     [T_FILTER_TXT]    = {"Fichier Regressi\0*.txt\0", "Regressi File\0*.txt\0"},
     [T_FILTER_LAB]    = {"Projet MotionLab\0*.lab\0", "MotionLab Project\0*.lab\0"},
+    [T_FILTER_PNG]    = {"Image PNG\0*.png\0", "PNG Image\0*.png\0"},
+    [T_FILTER_SVG]    = {"Image SVG\0*.svg\0", "SVG Image\0*.svg\0"},
 
     // En-têtes
     [T_HEADER_TIME]   = {"Temps", "Time"},
@@ -63,6 +67,9 @@ static const char* dictionary[STR_COUNT][LANG_COUNT] = {
     [T_MAGNIFIER]     = {"Loupe", "Magnifier"},
     [T_OUT_OF_ZONE]   = {"Hors zone", "Out of area"},
     [T_DRAG_VIDEO]    = {"Glissez une vidéo ici", "Drag a video here"},
+    [T_VIDEO_OPENING] = {"Ouverture de la vidéo...", "Opening video..."},
+    [T_VIDEO_OPEN_FAILED] = {"Impossible d'ouvrir le fichier", "Unable to open the file"},
+    [T_POINTS_FULL]   = {"Limite de %d points atteinte", "Limit of %d points reached"},
     [T_INITIALIZING]  = {"INITIALISATION...", "INITIALIZING..."},
     [T_READY_SPACE]   = {"PRÊT : ESPACE", "READY: SPACE"},
     [T_TRACKING_MSG]  = {"Tracking...", "Tracking..."},
@@ -81,11 +88,61 @@ static const char* dictionary[STR_COUNT][LANG_COUNT] = {
 
     // Graphiques
     [T_GRAPH_WINDOW_TITLE] = {"Visualisation des courbes", "Curves Visualization"},
+    [T_GRAPH_PANELS] = {"Panneaux : %d", "Panels: %d"},
+    [T_GRAPH_EXPORTING]     = {"Export en cours...", "Exporting..."},
+    [T_GRAPH_EXPORTED]      = {"Graphique exporté", "Graph exported"},
+    [T_GRAPH_EXPORT_FAILED] = {"Échec de l'export", "Export failed"},
     [T_SHOW_FIT]           = {"Show Fit", "Show Fit"},
     [T_HIDE_FIT]           = {"Hide Fit", "Hide Fit"},
     [T_SHOW_FILL]          = {"Show Fill", "Show Fill"},
     [T_HIDE_FILL]          = {"Hide Fill", "Hide Fill"},
     [T_FIT_NA]             = {"Fit: N/A", "Fit: N/A"},
+    [T_DIFF_CENTRAL]       = {"Dérivée : diff. finies", "Derivative: finite diff."},
+    [T_DIFF_SAVGOL]        = {"Dérivée : Savitzky-Golay", "Derivative: Savitzky-Golay"},
+    [T_DIFF_SPLINE]        = {"Dérivée : spline lissante", "Derivative: smoothing spline"},
+    [T_DIFF_WINDOW]        = {"Fenêtre %d", "Window %d"},
+    [T_DIFF_ORDER]         = {"Degré %d", "Degree %d"},
+    [T_DIFF_SMOOTHING]     = {"Lissage %g", "Smoothing %g"},
+    [T_FIT_AUTO]           = {"Modèle : droite / parabole", "Model: line / parabola"},
+    [T_FIT_POLYNOMIAL]     = {"Modèle : polynôme", "Model: polynomial"},
+    [T_FIT_OSCILLATOR]     = {"Modèle : oscillateur amorti", "Model: damped oscillator"},
+    [T_FIT_DECAY]          = {"Modèle : décroissance exp.", "Model: exponential decay"},
+    [T_FIT_DRAG]           = {"Modèle : chute avec frottement", "Model: projectile with drag"},
+    [T_FIT_PENDING]        = {"Ajustement en cours...", "Fitting..."},
+    [T_BOOT_OFF]           = {"Incertitudes : aucune", "Uncertainty: off"},
+    [T_BOOT_RESAMPLE]      = {"Incertitudes : bootstrap", "Uncertainty: bootstrap"},
+    [T_BOOT_JITTER]        = {"Incertitudes : Monte-Carlo", "Uncertainty: Monte Carlo"},
+    [T_BOOT_PENDING]       = {"Calcul des intervalles...", "Computing intervals..."},
+
+    // Spectre
+    [T_SPEC_WINDOW_TITLE]  = {"Analyse spectrale", "Spectral Analysis"},
+    [T_SPEC_RECT]          = {"Fenêtre : rectangulaire", "Window: rectangular"},
+    [T_SPEC_HANN]          = {"Fenêtre : Hann", "Window: Hann"},
+    [T_SPEC_HAMMING]       = {"Fenêtre : Hamming", "Window: Hamming"},
+    [T_SPEC_BLACKMAN]      = {"Fenêtre : Blackman", "Window: Blackman"},
+    [T_SPEC_PADDING]       = {"Zéros ×%d", "Zero-pad ×%d"},
+    [T_SPEC_SCALE_LIN]     = {"Échelle : linéaire", "Scale: linear"},
+    [T_SPEC_SCALE_DB]      = {"Échelle : dB", "Scale: dB"},
+    [T_SPEC_NO_DATA]       = {"Pas assez de points", "Not enough points"},
+    [T_SPEC_PEAK]          = {"Pic : %.4f Hz   Période : %.4f s   Amplitude : %.4g m", "Peak: %.4f Hz   Period: %.4f s   Amplitude: %.4g m"},
+    [T_SPEC_GRID]          = {"fe = %.2f Hz   N = %d   FFT = %d   df = %.4f Hz", "fs = %.2f Hz   N = %d   FFT = %d   df = %.4f Hz"},
+
+    // Grandeurs dérivées
+    [T_DERIVED_TITLE]      = {"Grandeurs dérivées", "Derived Quantities"},
+    [T_DERIVED_MASS]       = {"Masse m", "Mass m"},
+    [T_DERIVED_GRAVITY]    = {"Pesanteur g", "Gravity g"},
+    [T_DERIVED_PRESETS]    = {"Énergies et quantité de mvt", "Energy and momentum"},
+    [T_DERIVED_ADD]        = {"+ Nouvelle grandeur", "+ New quantity"},
+    [T_DERIVED_HELP_VARS]  = {"nom = expression   Variables : t x y vx vy ax ay m g pi et les grandeurs au-dessus", "name = expression   Variables: t x y vx vy ax ay m g pi and the quantities above"},
+    [T_DERIVED_HELP_FUNCS] = {"Fonctions : sqrt abs exp ln log sin cos tan asin acos atan atan2 hypot min max", "Functions: sqrt abs exp ln log sin cos tan asin acos atan atan2 hypot min max"},
+    [T_DERIVED_ERR_AT]     = {"%s (car. %d)", "%s (char %d)"},
+    [T_EXPR_ERR_EMPTY]     = {"Expression vide", "Empty expression"},
+    [T_EXPR_ERR_SYNTAX]    = {"Syntaxe incorrecte", "Syntax error"},
+    [T_EXPR_ERR_PAREN]     = {"Parenthèse non fermée", "Unclosed parenthesis"},
+    [T_EXPR_ERR_UNKNOWN]   = {"Nom inconnu", "Unknown name"},
+    [T_EXPR_ERR_ARGS]      = {"Nombre d'arguments incorrect", "Wrong number of arguments"},
+    [T_EXPR_ERR_COMPLEX]   = {"Expression trop longue", "Expression too long"},
+    [T_EXPR_ERR_NAME]      = {"Écrire nom = expression avec un nom libre", "Write name = expression with an unused name"},
 
     // Onglets & Panneaux
     [T_TAB_MEASURES]    = {"Mesures", "Measures"},
@@ -100,6 +157,21 @@ static const char* dictionary[STR_COUNT][LANG_COUNT] = {
     [T_DEFINE_SCALE]    = {"Définir l'échelle", "Define scale"},
     [T_REAL_DIST]       = {"Distance réelle :", "Real distance:"},
     [T_PX_PER_METER]    = {"1 m = %.1f pixels", "1 m = %.1f pixels"},
+    [T_PLANE]           = {"PERSPECTIVE (4 POINTS)", "PERSPECTIVE (4 POINTS)"},
+    [T_PLANE_DEFINE]    = {"Placer les 4 coins du rectangle", "Place the 4 rectangle corners"},
+    [T_PLANE_CLICK]     = {"Cliquez le coin %d / 4", "Click corner %d / 4"},
+    [T_PLANE_WIDTH]     = {"Largeur (coins 1-2) :", "Width (corners 1-2):"},
+    [T_PLANE_HEIGHT]    = {"Hauteur (coins 1-4) :", "Height (corners 1-4):"},
+    [T_PLANE_ACTIVE]    = {"Correction de perspective active", "Perspective correction on"},
+    [T_PLANE_INVALID]   = {"Coins alignés ou dans le désordre : plan invalide", "Collinear or out-of-order corners: invalid plane"},
+    [T_PLANE_NONE]      = {"Aucun plan défini", "No plane defined"},
+    [T_LENS]            = {"DISTORSION OBJECTIF", "LENS DISTORTION"},
+    [T_LENS_TRACE]      = {"Tracer des lignes droites", "Trace straight lines"},
+    [T_LENS_TRACING]    = {"Clic : point, clic droit : ligne suivante", "Click: point, right click: next line"},
+    [T_LENS_FIT]        = {"Corriger", "Correct"},
+    [T_LENS_RESET]      = {"Effacer", "Clear"},
+    [T_LENS_NONE]       = {"Aucune correction", "No correction"},
+    [T_LENS_LINES]      = {"%d ligne(s), %d point(s)", "%d line(s), %d point(s)"},
 
     // Détails Vidéo
     [T_FILE_SECTION]    = {"FICHIER", "FILE"},
@@ -111,6 +183,12 @@ static const char* dictionary[STR_COUNT][LANG_COUNT] = {
     [T_TOTAL_FRAMES]    = {"Total Images", "Total Frames"},
     [T_CODEC]           = {"Codec", "Codec"},
     [T_PIXELS]          = {"Format Pixels", "Pixel Format"},
+    [T_DISCARDED]       = {"Paquets ignorés", "Skipped packets"},
+    [T_GPU_UPLOAD]      = {"Envoi GPU", "GPU upload"},
+    [T_DOUBLE_BUFFER]   = {"Texture double tampon", "Double-buffered texture"},
+    [T_CROP_ZONE]       = {"Zone d'analyse", "Analysis region"},
+    [T_CROP_DEFINE]     = {"Définir la zone", "Set region"},
+    [T_CROP_RESET]      = {"Image entière", "Full frame"},
 
     // Guide Utilisateur
     [T_HELP_TITLE]      = {"Guide Utilisateur", "User Guide"},
@@ -0,0 +1,115 @@
+#include "latest_job.h"
+#include "job_system.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    void *params;
+    int key;
+    int count;
+    int capacity;
+    float *x;
+    float *y;
+} LatestJobInput;
+
+struct LatestJob {
+    Job *job;
+    LatestJobInput submitted;   // dernière série reçue (thread principal)
+    LatestJobInput working;     // série en cours de calcul (thread de travail)
+    bool pending;
+    bool hasInput;
+    size_t paramsSize;
+    LatestJobRun run;
+    LatestJobCollect collect;
+    void *ctx;
+};
+
+static bool LatestJobInput_Reserve(LatestJobInput *in, int count) {
+    if (count <= in->capacity) return true;
+    int cap = (in->capacity > 0) ? in->capacity : 256;
+    while (cap < count) cap *= 2;
+    float *gx = (float *)realloc(in->x, (size_t)cap * sizeof(float));
+    if (!gx) return false;
+    in->x = gx;
+    float *gy = (float *)realloc(in->y, (size_t)cap * sizeof(float));
+    if (!gy) return false;
+    in->y = gy;
+    in->capacity = cap;
+    return true;
+}
+
+static void LatestJob_Work(void *arg) {
+    LatestJob *lj = (LatestJob *)arg;
+    LatestJobInput *in = &lj->working;
+    lj->run(lj->ctx, in->params, in->key, in->x, in->y, in->count);
+}
+
+LatestJob* LatestJob_Create(size_t paramsSize, LatestJobRun run, LatestJobCollect collect, void *ctx) {
+    LatestJob *lj = (LatestJob *)calloc(1, sizeof(LatestJob));
+    if (!lj) return NULL;
+    lj->submitted.params = calloc(1, paramsSize ? paramsSize : 1);
+    lj->working.params = calloc(1, paramsSize ? paramsSize : 1);
+    if (!lj->submitted.params || !lj->working.params) {
+        LatestJob_Destroy(lj);
+        return NULL;
+    }
+    lj->paramsSize = paramsSize;
+    lj->run = run;
+    lj->collect = collect;
+    lj->ctx = ctx;
+    return lj;
+}
+
+void LatestJob_Destroy(LatestJob *lj) {
+    if (!lj) return;
+    if (lj->job) Job_Wait(lj->job);
+    LatestJobInput *inputs[2] = { &lj->submitted, &lj->working };
+    for (int i = 0; i < 2; i++) {
+        free(inputs[i]->params);
+        free(inputs[i]->x);
+        free(inputs[i]->y);
+    }
+    free(lj);
+}
+
+void LatestJob_Pump(LatestJob *lj) {
+    if (lj->job && Job_IsDone(lj->job)) {
+        Job_Wait(lj->job);
+        lj->job = NULL;
+        lj->collect(lj->ctx);
+    }
+    if (lj->job || !lj->pending) return;
+
+    LatestJobInput *src = &lj->submitted, *dst = &lj->working;
+    if (!LatestJobInput_Reserve(dst, src->count)) return;
+    memcpy(dst->x, src->x, (size_t)src->count * sizeof(float));
+    memcpy(dst->y, src->y, (size_t)src->count * sizeof(float));
+    memcpy(dst->params, src->params, lj->paramsSize);
+    dst->key = src->key;
+    dst->count = src->count;
+    lj->pending = false;
+    lj->job = Job_Submit(LatestJob_Work, lj);
+}
+
+void LatestJob_Submit(LatestJob *lj, const void *params, int key, const float *x, const float *y, int count) {
+    if (!lj || count < 0) return;
+    LatestJobInput *in = &lj->submitted;
+    bool same = lj->hasInput && in->key == key && in->count == count &&
+                memcmp(in->params, params, lj->paramsSize) == 0 &&
+                memcmp(in->x, x, (size_t)count * sizeof(float)) == 0 &&
+                memcmp(in->y, y, (size_t)count * sizeof(float)) == 0;
+    if (!same && LatestJobInput_Reserve(in, count)) {
+        memcpy(in->x, x, (size_t)count * sizeof(float));
+        memcpy(in->y, y, (size_t)count * sizeof(float));
+        memcpy(in->params, params, lj->paramsSize);
+        in->key = key;
+        in->count = count;
+        lj->hasInput = true;
+        lj->pending = true;
+    }
+    LatestJob_Pump(lj);
+}
+
+bool LatestJob_IsBusy(const LatestJob *lj) {
+    return lj && (lj->job || lj->pending);
+}
@@ -0,0 +1,202 @@
+#include "lens.h"
+#include <math.h>
+#include <string.h>
+
+#define LENS_FIT_MAX_PARAMS 4
+#define LENS_FIT_ITERATIONS 400
+
+void Lens_Reset(LensModel *lens) {
+    memset(lens, 0, sizeof(LensModel));
+    lens->focal = 1.0f;
+}
+
+bool Lens_Equals(const LensModel *a, const LensModel *b) {
+    return a->enabled == b->enabled && a->k1 == b->k1 && a->k2 == b->k2 && a->p1 == b->p1 && a->p2 == b->p2 &&
+           a->center.x == b->center.x && a->center.y == b->center.y && a->focal == b->focal;
+}
+
+void Lens_UndistortBatch(const LensModel *lens, const float *srcX, const float *srcY, float *dstX, float *dstY, int count) {
+    if (!lens->enabled || lens->focal <= 0.0f) {
+        if (dstX != srcX) memmove(dstX, srcX, count * sizeof(float));
+        if (dstY != srcY) memmove(dstY, srcY, count * sizeof(float));
+        return;
+    }
+
+    const float cx = lens->center.x, cy = lens->center.y;
+    const float f = lens->focal, invF = 1.0f / lens->focal;
+    const float k1 = lens->k1, k2 = lens->k2;
+    const float p1 = lens->p1, p2 = lens->p2;
+
+    // Inversion par point fixe (même schéma que cv::undistortPoints) :
+    // nombre d'itérations constant pour garder la boucle vectorisable.
+    for (int i = 0; i < count; i++) {
+        float xd = (srcX[i] - cx) * invF;
+        float yd = (srcY[i] - cy) * invF;
+        float x = xd, y = yd;
+        for (int it = 0; it < LENS_ITERATIONS; it++) {
+            float r2 = x * x + y * y;
+            float invRadial = 1.0f / (1.0f + r2 * (k1 + r2 * k2));
+            float dx = 2.0f * p1 * x * y + p2 * (r2 + 2.0f * x * x);
+            float dy = p1 * (r2 + 2.0f * y * y) + 2.0f * p2 * x * y;
+            x = (xd - dx) * invRadial;
+            y = (yd - dy) * invRadial;
+        }
+        dstX[i] = x * f + cx;
+        dstY[i] = y * f + cy;
+    }
+}
+
+Vector2 Lens_Undistort(const LensModel *lens, Vector2 p) {
+    Lens_UndistortBatch(lens, &p.x, &p.y, &p.x, &p.y, 1);
+    return p;
+}
+
+void LensLines_Clear(LensLines *lines) {
+    lines->count = 0;
+    lines->lineCount = 0;
+}
+
+void LensLines_Add(LensLines *lines, Vector2 p) {
+    if (lines->count >= LENS_MAX_POINTS) return;
+    if (lines->lineCount == 0) lines->lineCount = 1;
+    lines->points[lines->count] = p;
+    lines->lineIds[lines->count] = lines->lineCount - 1;
+    lines->count++;
+}
+
+void LensLines_NextLine(LensLines *lines) {
+    if (lines->lineCount >= LENS_MAX_LINES) return;
+    // Une ligne vide est réutilisée plutôt que d'en ouvrir une autre.
+    if (lines->count == 0 || lines->lineIds[lines->count - 1] != lines->lineCount - 1) return;
+    lines->lineCount++;
+}
+
+// Somme, sur chaque ligne, du rapport entre la dispersion perpendiculaire et la
+// dispersion le long de la ligne : nul pour des lignes parfaitement droites et
+// insensible au changement d'échelle global introduit par la correction.
+static float Lens_Straightness(const LensModel *lens, const LensLines *lines) {
+    float ux[LENS_MAX_POINTS], uy[LENS_MAX_POINTS];
+    for (int i = 0; i < lines->count; i++) {
+        ux[i] = lines->points[i].x;
+        uy[i] = lines->points[i].y;
+    }
+    Lens_UndistortBatch(lens, ux, uy, ux, uy, lines->count);
+
+    float error = 0.0f;
+    for (int l = 0; l < lines->lineCount; l++) {
+        double sx = 0, sy = 0;
+        int n = 0;
+        for (int i = 0; i < lines->count; i++) {
+            if (lines->lineIds[i] != l) continue;
+            sx += ux[i]; sy += uy[i]; n++;
+        }
+        if (n < 3) continue;
+        double mx = sx / n, my = sy / n;
+        double sxx = 0, syy = 0, sxy = 0;
+        for (int i = 0; i < lines->count; i++) {
+            if (lines->lineIds[i] != l) continue;
+            double dx = ux[i] - mx, dy = uy[i] - my;
+            sxx += dx * dx; syy += dy * dy; sxy += dx * dy;
+        }
+        double half = (sxx + syy) * 0.5;
+        double spread = sqrt((sxx - syy) * (sxx - syy) * 0.25 + sxy * sxy);
+        double lMax = half + spread, lMin = half - spread;
+        if (lMax > 0) error += (float)(lMin / lMax);
+    }
+    return error;
+}
+
+static float Lens_Evaluate(LensModel *lens, const LensLines *lines, const float *params, int nParams) {
+    lens->k1 = params[0];
+    lens->k2 = params[1];
+    lens->p1 = (nParams > 2) ? params[2] : 0.0f;
+    lens->p2 = (nParams > 3) ? params[3] : 0.0f;
+    // Au-delà, le rayon corrigé n'est plus monotone : la solution n'a pas de sens.
+    if (fabsf(lens->k1) > 1.0f || fabsf(lens->k2) > 1.0f) return 1e9f;
+    return Lens_Straightness(lens, lines);
+}
+
+bool Lens_Fit(LensModel *lens, const LensLines *lines, int frameW, int frameH) {
+    if (frameW <= 0 || frameH <= 0) return false;
+
+    int usableLines = 0;
+    for (int l = 0; l < lines->lineCount; l++) {
+        int n = 0;
+        for (int i = 0; i < lines->count; i++) if (lines->lineIds[i] == l) n++;
+        if (n >= 3) usableLines++;
+    }
+    if (usableLines == 0) return false;
+
+    LensModel model;
+    Lens_Reset(&model);
+    model.enabled = true;
+    model.center = (Vector2){ frameW * 0.5f, frameH * 0.5f };
+    model.focal = 0.5f * sqrtf((float)frameW * frameW + (float)frameH * frameH);
+
+    // Les termes tangentiels ne sont observables qu'avec plusieurs orientations.
+    int nParams = (usableLines >= 3) ? 4 : 2;
+
+    // Nelder-Mead : peu de paramètres, pas de dérivées.
+    float simplex[LENS_FIT_MAX_PARAMS + 1][LENS_FIT_MAX_PARAMS];
+    float values[LENS_FIT_MAX_PARAMS + 1];
+    memset(simplex, 0, sizeof(simplex));
+    for (int v = 1; v <= nParams; v++) simplex[v][v - 1] = (v - 1 < 2) ? 0.05f : 0.005f;
+    for (int v = 0; v <= nParams; v++) values[v] = Lens_Evaluate(&model, lines, simplex[v], nParams);
+
+    for (int iter = 0; iter < LENS_FIT_ITERATIONS; iter++) {
+        int best = 0, worst = 0, second = 0;
+        for (int v = 1; v <= nParams; v++) {
+            if (values[v] < values[best]) best = v;
+            if (values[v] > values[worst]) worst = v;
+        }
+        second = best;
+        for (int v = 0; v <= nParams; v++) {
+            if (v != worst && values[v] > values[second]) second = v;
+        }
+        if (values[worst] - values[best] < 1e-9f) break;
+
+        float centroid[LENS_FIT_MAX_PARAMS] = { 0 };
+        for (int v = 0; v <= nParams; v++) {
+            if (v == worst) continue;
+            for (int p = 0; p < nParams; p++) centroid[p] += simplex[v][p] / nParams;
+        }
+
+        float trial[LENS_FIT_MAX_PARAMS], expanded[LENS_FIT_MAX_PARAMS];
+        for (int p = 0; p < nParams; p++) trial[p] = 2.0f * centroid[p] - simplex[worst][p];
+        float trialValue = Lens_Evaluate(&model, lines, trial, nParams);
+
+        if (trialValue < values[best]) {
+            for (int p = 0; p < nParams; p++) expanded[p] = 3.0f * centroid[p] - 2.0f * simplex[worst][p];
+            float expandedValue = Lens_Evaluate(&model, lines, expanded, nParams);
+            if (expandedValue < trialValue) {
+                memcpy(simplex[worst], expanded, sizeof(expanded));
+                values[worst] = expandedValue;
+            } else {
+                memcpy(simplex[worst], trial, sizeof(trial));
+                values[worst] = trialValue;
+            }
+        } else if (trialValue < values[second]) {
+            memcpy(simplex[worst], trial, sizeof(trial));
+            values[worst] = trialValue;
+        } else {
+            for (int p = 0; p < nParams; p++) trial[p] = 0.5f * (centroid[p] + simplex[worst][p]);
+            trialValue = Lens_Evaluate(&model, lines, trial, nParams);
+            if (trialValue < values[worst]) {
+                memcpy(simplex[worst], trial, sizeof(trial));
+                values[worst] = trialValue;
+            } else {
+                for (int v = 0; v <= nParams; v++) {
+                    if (v == best) continue;
+                    for (int p = 0; p < nParams; p++) simplex[v][p] = 0.5f * (simplex[v][p] + simplex[best][p]);
+                    values[v] = Lens_Evaluate(&model, lines, simplex[v], nParams);
+                }
+            }
+        }
+    }
+
+    int best = 0;
+    for (int v = 1; v <= nParams; v++) if (values[v] < values[best]) best = v;
+    Lens_Evaluate(&model, lines, simplex[best], nParams);
+    *lens = model;
+    return true;
+}
@@ -8,9 +8,13 @@
 #include <string.h>
 #include "auto_tracker.h"
 #include "ui_graph.h"
+#include "ui_spectrum.h"
+#include "ui_derived.h"
+#include "derived.h"
 #include "resources.h"
 #include "ui_menu.h"
 #include "lang.h"
+#include "job_system.h"
 
 char currentFilePath[512] = { 0 };
 
@@ -19,6 +23,7 @@ int main(void) {
     InitWindow(1280, 800, "MotionLab");
     SetTargetFPS(60);
     InitLanguage();
+    JobSystem_Init(0);
 
     Image icon = LoadImageFromMemory(".png", logo_png_data, logo_png_size);
     if (icon.data != NULL) {
@@ -33,11 +38,19 @@ int main(void) {
     TrackingSystem ts = { 0 };
     AutoTracker autoTracker;
     GraphState graphState;
+    SpectrumState spectrumState;
+    DerivedSet derived;
+    DerivedWindowState derivedWindow;
 
     ts.scale = 100.0f;
     InitUI(&ui);
     AutoTracker_Init(&autoTracker);
     InitGraphSystem(&graphState);
+    InitSpectrumSystem(&spectrumState);
+    Derived_Init(&derived, graphState.kinematics);
+    InitDerivedWindow(&derivedWindow);
+    graphState.derived = &derived;
+    ui.derived = &derived;
 
     while (!WindowShouldClose()) {
         Rectangle videoArea = { 
@@ -48,10 +61,12 @@ int main(void) {
         };
 
         HandleWindowResize(&ui);
-        if (video.isLoaded) Video_Update(&video);
+        Video_Update(&video);
         UpdateVideoCanvas(&video, &ui, &ts, &autoTracker, videoArea);
         HandleShortcuts(&ui, &video, &ts,&autoTracker);
         AutoTracker_Update(&autoTracker, &video, &ts);
+        // Grandeurs dérivées à jour pour le tableau, les graphiques et les exports.
+        Derived_Update(&derived, &ts);
         
         BeginDrawing();
         ClearBackground(BLANK);
@@ -67,6 +82,8 @@ int main(void) {
         DrawBottomBar(&ui, &video, videoArea);
         DrawMagnifierWindow(&video, &ui, videoArea);    
         DrawGraphWindow(&ui, &graphState, &ts);
+        DrawSpectrumWindow(&ui, &spectrumState, &ts);
+        DrawDerivedWindow(&ui, &derivedWindow, &derived);
         DrawHelpWindow(&ui);
         if (DrawTitleBar(&ui, currentFilePath, &video, &ts, &autoTracker)) break;
 
@@ -74,8 +91,12 @@ int main(void) {
     }
 
     Video_Unload(&video);
+    JobSystem_Shutdown();
     UnloadUI(&ui);
     AutoTracker_Free(&autoTracker);
+    UnloadGraphSystem(&graphState);
+    UnloadSpectrumSystem(&spectrumState);
+    Derived_Free(&derived);
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "regression.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static void Regression_Accumulate(RegressionStats *s, double x, double y, double w) {
+    if (s->n <= 0 && w > 0) {
+        *s = (RegressionStats){ 0 };
+        s->origin = x;
+    }
+    x -= s->origin;
+    double x2 = x * x;
+    s->n += w;
+    s->sx += w * x; s->sx2 += w * x2; s->sx3 += w * x2 * x; s->sx4 += w * x2 * x2;
+    s->sy += w * y; s->sxy += w * x * y; s->sx2y += w * x2 * y; s->sy2 += w * y * y;
+}
+
+void Regression_Add(RegressionStats *s, double x, double y) {
+    Regression_Accumulate(s, x, y, 1.0);
+}
+
+void Regression_Remove(RegressionStats *s, double x, double y) {
+    Regression_Accumulate(s, x, y, -1.0);
+}
+
+// Somme de Neumaier : la compensation récupère les bits perdus à chaque addition.
+typedef struct { double sum, comp; } CompensatedSum;
+
+static void Compensated_Add(CompensatedSum *c, double v) {
+    double t = c->sum + v;
+    if (fabs(c->sum) >= fabs(v)) c->comp += (c->sum - t) + v;
+    else c->comp += (v - t) + c->sum;
+    c->sum = t;
+}
+
+void Regression_Recompute(RegressionStats *s, const float *x, const float *y, int count) {
+    CompensatedSum sums[8];
+    memset(sums, 0, sizeof(sums));
+    double origin = (count > 0) ? x[0] : 0.0;
+    for (int i = 0; i < count; i++) {
+        double xi = x[i] - origin, yi = y[i], x2 = xi * xi;
+        Compensated_Add(&sums[0], xi);
+        Compensated_Add(&sums[1], x2);
+        Compensated_Add(&sums[2], x2 * xi);
+        Compensated_Add(&sums[3], x2 * x2);
+        Compensated_Add(&sums[4], yi);
+        Compensated_Add(&sums[5], xi * yi);
+        Compensated_Add(&sums[6], x2 * yi);
+        Compensated_Add(&sums[7], yi * yi);
+    }
+    s->n = count;
+    s->origin = origin;
+    s->sx = sums[0].sum + sums[0].comp;
+    s->sx2 = sums[1].sum + sums[1].comp;
+    s->sx3 = sums[2].sum + sums[2].comp;
+    s->sx4 = sums[3].sum + sums[3].comp;
+    s->sy = sums[4].sum + sums[4].comp;
+    s->sxy = sums[5].sum + sums[5].comp;
+    s->sx2y = sums[6].sum + sums[6].comp;
+    s->sy2 = sums[7].sum + sums[7].comp;
+}
+
+// Pour un ajustement des moindres carrés : SSres = Σy² - β·(Xᵀy).
+static double Regression_RSquared(const RegressionStats *s, double ssExplainedDot) {
+    double ssTot = s->sy2 - s->sy * s->sy / s->n;
+    if (ssTot < 1e-9) return 1.0;
+    double ssRes = s->sy2 - ssExplainedDot;
+    if (ssRes < 0) ssRes = 0;
+    return 1.0 - ssRes / ssTot;
+}
+
+// Coefficients calculés en x - origin, rendus en x.
+RegressionResult Regression_Linear(const RegressionStats *s) {
+    double n = s->n;
+    double denom = n * s->sx2 - s->sx * s->sx;
+    if (n < 2 || fabs(denom) < 1e-9) return (RegressionResult){ REG_LINEAR, 0, 0, 0, 0 };
+
+    double slope = (n * s->sxy - s->sx * s->sy) / denom;
+    double intercept = (s->sy - slope * s->sx) / n;
+    RegressionResult res = { REG_LINEAR, slope, intercept - slope * s->origin, 0, 0 };
+    res.rSquared = Regression_RSquared(s, slope * s->sxy + intercept * s->sy);
+    return res;
+}
+
+// Élimination de Gauss avec pivot partiel sur les équations normales 3x3.
+static bool Regression_Solve3(double m[3][4], double out[3]) {
+    double scale = 0;
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) if (fabs(m[r][c]) > scale) scale = fabs(m[r][c]);
+    }
+    if (scale <= 0) return false;
+    for (int col = 0; col < 3; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < 3; r++) if (fabs(m[r][col]) > fabs(m[pivot][col])) pivot = r;
+        if (fabs(m[pivot][col]) < 1e-12 * scale) return false;
+        if (pivot != col) {
+            for (int k = 0; k < 4; k++) { double t = m[col][k]; m[col][k] = m[pivot][k]; m[pivot][k] = t; }
+        }
+        for (int r = col + 1; r < 3; r++) {
+            double f = m[r][col] / m[col][col];
+            for (int k = col; k < 4; k++) m[r][k] -= f * m[col][k];
+        }
+    }
+    for (int r = 2; r >= 0; r--) {
+        double v = m[r][3];
+        for (int k = r + 1; k < 3; k++) v -= m[r][k] * out[k];
+        out[r] = v / m[r][r];
+    }
+    return true;
+}
+
+RegressionResult Regression_Quadratic(const RegressionStats *s) {
+    double m[3][4] = {
+        { s->sx4, s->sx3, s->sx2, s->sx2y },
+        { s->sx3, s->sx2, s->sx,  s->sxy  },
+        { s->sx2, s->sx,  s->n,   s->sy   },
+    };
+    double beta[3];
+    if (s->n < 3 || !Regression_Solve3(m, beta)) return (RegressionResult){ REG_QUADRATIC, 0, 0, 0, 0 };
+
+    double a = beta[0], b = beta[1], c = beta[2], o = s->origin;
+    RegressionResult res = { REG_QUADRATIC, a, b - 2.0 * a * o, c - b * o + a * o * o, 0 };
+    res.rSquared = Regression_RSquared(s, a * s->sx2y + b * s->sxy + c * s->sy);
+    return res;
+}
+
+static bool RegressionTracker_Reserve(RegressionTracker *rt, int count) {
+    if (count <= rt->capacity) return true;
+    int cap = (rt->capacity > 0) ? rt->capacity : 256;
+    while (cap < count) cap *= 2;
+    float *gx = (float *)realloc(rt->x, (size_t)cap * sizeof(float));
+    if (!gx) return false;
+    rt->x = gx;
+    float *gy = (float *)realloc(rt->y, (size_t)cap * sizeof(float));
+    if (!gy) return false;
+    rt->y = gy;
+    rt->capacity = cap;
+    return true;
+}
+
+void RegressionTracker_Sync(RegressionTracker *rt, int key, const float *x, const float *y, int begin, int end) {
+    RegressionTracker_SyncFrom(rt, key, x, y, begin, end, begin);
+}
+
+static void RegressionTracker_Set(RegressionTracker *rt, int i, const float *x, const float *y, bool tracked) {
+    if (tracked && rt->x[i] == x[i] && rt->y[i] == y[i]) return;
+    if (tracked) Regression_Remove(&rt->stats, rt->x[i], rt->y[i]);
+    Regression_Add(&rt->stats, x[i], y[i]);
+    rt->x[i] = x[i];
+    rt->y[i] = y[i];
+    rt->updatesSinceRecompute++;
+}
+
+void RegressionTracker_SyncFrom(RegressionTracker *rt, int key, const float *x, const float *y, int begin, int end, int from) {
+    if (end < begin) end = begin;
+    if (!RegressionTracker_Reserve(rt, end)) {
+        rt->valid = false;
+        return;
+    }
+
+    bool full = !rt->valid || rt->key != key || rt->updatesSinceRecompute >= REGRESSION_RECOMPUTE_INTERVAL;
+    if (!full) {
+        // Points sortis de la plage suivie.
+        int keepLo = (begin > rt->begin) ? begin : rt->begin;
+        int keepHi = (end < rt->end) ? end : rt->end;
+        for (int i = rt->begin; i < rt->end; i++) {
+            if (i >= keepLo && i < keepHi) { i = keepHi - 1; continue; }
+            Regression_Remove(&rt->stats, rt->x[i], rt->y[i]);
+            rt->updatesSinceRecompute++;
+        }
+        // Points entrés dans la plage, puis points suivis susceptibles d'avoir changé.
+        for (int i = begin; i < end; i++) {
+            if (i >= keepLo && i < keepHi) { i = keepHi - 1; continue; }
+            RegressionTracker_Set(rt, i, x, y, false);
+        }
+        for (int i = (from > keepLo) ? from : keepLo; i < keepHi; i++) RegressionTracker_Set(rt, i, x, y, true);
+    } else {
+        memcpy(rt->x + begin, x + begin, (size_t)(end - begin) * sizeof(float));
+        memcpy(rt->y + begin, y + begin, (size_t)(end - begin) * sizeof(float));
+        Regression_Recompute(&rt->stats, rt->x + begin, rt->y + begin, end - begin);
+        rt->updatesSinceRecompute = 0;
+    }
+    rt->begin = begin;
+    rt->end = end;
+    rt->key = key;
+    rt->valid = true;
+}
+
+void RegressionTracker_Free(RegressionTracker *rt) {
+    free(rt->x);
+    free(rt->y);
+    memset(rt, 0, sizeof(RegressionTracker));
+}
@@ -0,0 +1,290 @@
+#include "spectrum.h"
+#include "latest_job.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static int CompareDouble(const void *a, const void *b) {
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+double Spectrum_MedianStep(const float *t, int count) {
+    if (count < 2) return 0.0;
+    double *steps = (double *)malloc((size_t)(count - 1) * sizeof(double));
+    if (!steps) return 0.0;
+    int n = 0;
+    for (int i = 1; i < count; i++) {
+        double d = (double)t[i] - t[i - 1];
+        if (d > 0.0) steps[n++] = d;
+    }
+    double median = 0.0;
+    if (n > 0) {
+        qsort(steps, n, sizeof(double), CompareDouble);
+        median = (n % 2) ? steps[n / 2] : 0.5 * (steps[n / 2 - 1] + steps[n / 2]);
+    }
+    free(steps);
+    return median;
+}
+
+int Spectrum_Resample(const float *t, const float *v, int count, double dt, double *out, int maxOut) {
+    if (count < 2 || dt <= 0.0 || maxOut <= 0) return 0;
+    double t0 = t[0], span = (double)t[count - 1] - t0;
+    if (span <= 0.0) return 0;
+    int n = (int)floor(span / dt + 1e-9) + 1;
+    if (n > maxOut) n = maxOut;
+
+    int j = 0;
+    for (int k = 0; k < n; k++) {
+        double tk = t0 + k * dt;
+        while (j < count - 2 && t[j + 1] <= tk) j++;
+        double ta = t[j], tb = t[j + 1];
+        double f = (tb > ta) ? (tk - ta) / (tb - ta) : 0.0;
+        if (f < 0.0) f = 0.0;
+        if (f > 1.0) f = 1.0;
+        out[k] = v[j] + f * ((double)v[j + 1] - v[j]);
+    }
+    return n;
+}
+
+static double Spectrum_WindowValue(SpectrumWindow window, int i, int n) {
+    if (n < 2) return 1.0;
+    double x = 2.0 * M_PI * i / (n - 1);
+    switch (window) {
+        case SPECTRUM_HANN:     return 0.5 - 0.5 * cos(x);
+        case SPECTRUM_HAMMING:  return 0.54 - 0.46 * cos(x);
+        case SPECTRUM_BLACKMAN: return 0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x);
+        default:                return 1.0;
+    }
+}
+
+void Spectrum_FFT(double *re, double *im, int n) {
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            double tr = re[i]; re[i] = re[j]; re[j] = tr;
+            double ti = im[i]; im[i] = im[j]; im[j] = ti;
+        }
+    }
+    // Table des racines de l'unité pour la taille n : chaque étage la lit avec un pas n / len.
+    int halfN = n >> 1;
+    double *twr = (double *)malloc((size_t)(halfN > 0 ? halfN : 1) * sizeof(double));
+    double *twi = (double *)malloc((size_t)(halfN > 0 ? halfN : 1) * sizeof(double));
+    if (!twr || !twi) { free(twr); free(twi); return; }
+    for (int k = 0; k < halfN; k++) { twr[k] = cos(-2.0 * M_PI * k / n); twi[k] = sin(-2.0 * M_PI * k / n); }
+
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len >> 1;
+        int stride = n / len;
+        for (int k = 0; k < half; k++) {
+            double wr = twr[k * stride], wi = twi[k * stride];
+            for (int i = k; i < n; i += len) {
+                int j = i + half;
+                double xr = re[j] * wr - im[j] * wi;
+                double xi = re[j] * wi + im[j] * wr;
+                re[j] = re[i] - xr; im[j] = im[i] - xi;
+                re[i] += xr;        im[i] += xi;
+            }
+        }
+    }
+    free(twr);
+    free(twi);
+}
+
+void Spectrum_FreeResult(SpectrumResult *r) {
+    free(r->amp);
+    r->amp = NULL;
+    r->capacity = 0;
+    r->valid = false;
+}
+
+static bool Spectrum_Reserve(SpectrumResult *r, int bins) {
+    if (bins <= r->capacity) return true;
+    float *grown = (float *)realloc(r->amp, (size_t)bins * sizeof(float));
+    if (!grown) return false;
+    r->amp = grown;
+    r->capacity = bins;
+    return true;
+}
+
+// Pic principal hors composante continue, affiné par une parabole sur ln(amplitude).
+static void Spectrum_FindPeak(SpectrumResult *r) {
+    int best = -1;
+    for (int k = 1; k < r->bins; k++) {
+        if (best < 0 || r->amp[k] > r->amp[best]) best = k;
+    }
+    r->peakFreq = 0.0;
+    r->peakAmp = 0.0;
+    if (best < 0 || r->amp[best] <= 0.0f) return;
+
+    double delta = 0.0, amp = r->amp[best];
+    if (best + 1 < r->bins && r->amp[best - 1] > 0.0f && r->amp[best + 1] > 0.0f) {
+        double a = log(r->amp[best - 1]), b = log(r->amp[best]), c = log(r->amp[best + 1]);
+        double den = a - 2.0 * b + c;
+        if (den < 0.0) {
+            delta = 0.5 * (a - c) / den;
+            amp = exp(b - 0.25 * (a - c) * delta);
+        }
+    }
+    r->peakFreq = (best + delta) * r->df;
+    r->peakAmp = amp;
+}
+
+bool Spectrum_Compute(const float *t, const float *v, int count, SpectrumWindow window, int pad, SpectrumResult *out) {
+    out->valid = false;
+    double dt = Spectrum_MedianStep(t, count);
+    if (dt <= 0.0) return false;
+    if (pad < 1) pad = 1;
+    if (pad > SPECTRUM_MAX_PAD) pad = SPECTRUM_MAX_PAD;
+
+    double span = (double)t[count - 1] - t[0];
+    if (span <= 0.0) return false;
+    double grid = floor(span / dt + 1e-9) + 1.0;
+    int maxN = (grid < SPECTRUM_MAX_SAMPLES) ? (int)grid : SPECTRUM_MAX_SAMPLES;
+    double *signal = (double *)malloc((size_t)maxN * sizeof(double));
+    if (!signal) return false;
+    int n = Spectrum_Resample(t, v, count, dt, signal, maxN);
+    if (n < 4) { free(signal); return false; }
+
+    // Tendance linéaire retirée : une dérive lente ne déborde pas sur les basses fréquences.
+    double sk = 0.0, skk = 0.0, sv = 0.0, skv = 0.0;
+    for (int k = 0; k < n; k++) { sk += k; skk += (double)k * k; sv += signal[k]; skv += k * signal[k]; }
+    double den = n * skk - sk * sk;
+    double slope = (den != 0.0) ? (n * skv - sk * sv) / den : 0.0;
+    double offset = (sv - slope * sk) / n;
+
+    int fftSize = 2;
+    while (fftSize < n) fftSize <<= 1;
+    fftSize *= pad;
+    int half = fftSize / 2;
+
+    // FFT réelle de taille N par une FFT complexe de taille N/2 (pairs en réel, impairs en imaginaire).
+    double *re = (double *)calloc((size_t)half, sizeof(double));
+    double *im = (double *)calloc((size_t)half, sizeof(double));
+    if (!re || !im || !Spectrum_Reserve(out, half + 1)) {
+        free(signal); free(re); free(im);
+        return false;
+    }
+    double gain = 0.0;
+    for (int k = 0; k < n; k++) {
+        double w = Spectrum_WindowValue(window, k, n);
+        double s = (signal[k] - offset - slope * k) * w;
+        gain += w;
+        if (k & 1) im[k >> 1] = s; else re[k >> 1] = s;
+    }
+    free(signal);
+    Spectrum_FFT(re, im, half);
+
+    for (int k = 0; k <= half; k++) {
+        int a = k % half, b = (half - k) % half;
+        double er = 0.5 * (re[a] + re[b]), ei = 0.5 * (im[a] - im[b]);
+        double orr = 0.5 * (im[a] + im[b]), oi = -0.5 * (re[a] - re[b]);
+        double ang = -2.0 * M_PI * k / fftSize;
+        double wr = cos(ang), wi = sin(ang);
+        double xr = er + wr * orr - wi * oi;
+        double xi = ei + wr * oi + wi * orr;
+        double scale = (k == 0 || k == half) ? 1.0 : 2.0;
+        out->amp[k] = (float)(scale * sqrt(xr * xr + xi * xi) / gain);
+    }
+    free(re);
+    free(im);
+
+    out->samples = n;
+    out->fftSize = fftSize;
+    out->bins = half + 1;
+    out->sampleRate = 1.0 / dt;
+    out->df = out->sampleRate / fftSize;
+    Spectrum_FindPeak(out);
+    out->valid = true;
+    return true;
+}
+
+typedef struct {
+    SpectrumWindow window;
+    int pad;
+} SpectrumParams;
+
+struct SpectrumEngine {
+    LatestJob *job;
+    SpectrumResult jobResult;
+    SpectrumResult result;
+    bool hasResult;
+};
+
+typedef struct { float t, v; } SpectrumSample;
+
+static int CompareSample(const void *a, const void *b) {
+    float ta = ((const SpectrumSample *)a)->t, tb = ((const SpectrumSample *)b)->t;
+    return (ta > tb) - (ta < tb);
+}
+
+// Les points peuvent avoir été pointés dans le désordre : tri par instant si besoin.
+static void Spectrum_SortByTime(float *t, float *v, int count) {
+    int i = 1;
+    while (i < count && t[i - 1] <= t[i]) i++;
+    if (i >= count) return;
+    SpectrumSample *samples = (SpectrumSample *)malloc((size_t)count * sizeof(SpectrumSample));
+    if (!samples) return;
+    for (int k = 0; k < count; k++) samples[k] = (SpectrumSample){ t[k], v[k] };
+    qsort(samples, count, sizeof(SpectrumSample), CompareSample);
+    for (int k = 0; k < count; k++) { t[k] = samples[k].t; v[k] = samples[k].v; }
+    free(samples);
+}
+
+static void SpectrumEngine_Run(void *ctx, const void *params, int key, float *t, float *v, int count) {
+    SpectrumEngine *engine = (SpectrumEngine *)ctx;
+    const SpectrumParams *p = (const SpectrumParams *)params;
+    Spectrum_SortByTime(t, v, count);
+    Spectrum_Compute(t, v, count, p->window, p->pad, &engine->jobResult);
+    engine->jobResult.key = key;
+}
+
+// Échange des tampons : le prochain calcul réutilise ceux du résultat précédent.
+static void SpectrumEngine_Collect(void *ctx) {
+    SpectrumEngine *engine = (SpectrumEngine *)ctx;
+    SpectrumResult done = engine->jobResult;
+    engine->jobResult = engine->result;
+    engine->result = done;
+    engine->hasResult = true;
+}
+
+SpectrumEngine* SpectrumEngine_Create(void) {
+    SpectrumEngine *engine = (SpectrumEngine *)calloc(1, sizeof(SpectrumEngine));
+    if (!engine) return NULL;
+    engine->job = LatestJob_Create(sizeof(SpectrumParams), SpectrumEngine_Run, SpectrumEngine_Collect, engine);
+    if (!engine->job) {
+        free(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void SpectrumEngine_Destroy(SpectrumEngine *engine) {
+    if (!engine) return;
+    LatestJob_Destroy(engine->job);
+    Spectrum_FreeResult(&engine->jobResult);
+    Spectrum_FreeResult(&engine->result);
+    free(engine);
+}
+
+void SpectrumEngine_Submit(SpectrumEngine *engine, SpectrumWindow window, int pad, int key, const float *t, const float *v, int count) {
+    if (!engine) return;
+    SpectrumParams params = { window, pad };
+    LatestJob_Submit(engine->job, &params, key, t, v, count);
+}
+
+bool SpectrumEngine_IsBusy(SpectrumEngine *engine) {
+    return engine && LatestJob_IsBusy(engine->job);
+}
+
+const SpectrumResult* SpectrumEngine_Result(SpectrumEngine *engine) {
+    if (!engine) return NULL;
+    LatestJob_Pump(engine->job);
+    return (engine->hasResult && engine->result.valid) ? &engine->result : NULL;
+}
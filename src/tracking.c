@@ -1,22 +1,175 @@
 #include "tracking.h"
 #include <math.h>
+#include <string.h>
 
-Vector2 PixelToPhysical(struct TrackingSystem *ts, Vector2 pixelPos) {
-    if (!ts->calib.hasOriginSet || ts->calib.pxPerMeter <= 0) {
-        return pixelPos; 
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define TRACKING_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TRACKING_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define TRACKING_SIMD_NEON
+#endif
+
+static const float* Tracking_PlaneHomography(TrackingSystem *ts) {
+    Calibration *c = &ts->calib;
+    if (c->planeStep < 4 || c->planeWidth <= 0 || c->planeHeight <= 0) return NULL;
+
+    PlaneCache *cache = &ts->planeCache;
+    bool same = cache->computed && cache->width == c->planeWidth && cache->height == c->planeHeight &&
+                Lens_Equals(&cache->lens, &c->lens);
+    for (int i = 0; same && i < 4; i++) {
+        same = cache->points[i].x == c->planePoints[i].x && cache->points[i].y == c->planePoints[i].y;
+    }
+    if (!same) {
+        Vector2 src[4];
+        for (int i = 0; i < 4; i++) {
+            cache->points[i] = c->planePoints[i];
+            src[i] = Lens_Undistort(&c->lens, c->planePoints[i]);
+        }
+        Vector2 dst[4] = { { 0, 0 }, { c->planeWidth, 0 }, { c->planeWidth, c->planeHeight }, { 0, c->planeHeight } };
+        cache->width = c->planeWidth;
+        cache->height = c->planeHeight;
+        cache->lens = c->lens;
+        cache->valid = Homography_FromQuad(src, dst, cache->H);
+        cache->computed = true;
     }
+    return cache->valid ? cache->H : NULL;
+}
+
+bool Tracking_HasPlane(TrackingSystem *ts) {
+    return Tracking_PlaneHomography(ts) != NULL;
+}
+
+bool Tracking_IsCalibrated(TrackingSystem *ts) {
+    return Tracking_HasPlane(ts) || (ts->calib.hasOriginSet && ts->calib.pxPerMeter > 0);
+}
 
-    float pxPerM = ts->calib.pxPerMeter;
-    float dxPx = pixelPos.x - ts->calib.origin.x;
-    float dyPx = pixelPos.y - ts->calib.origin.y;
+PhysicalTransform Tracking_BuildTransform(TrackingSystem *ts) {
+    PhysicalTransform t = { { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f } };
+    const float *H = Tracking_PlaneHomography(ts);
+    if (!H && (!ts->calib.hasOriginSet || ts->calib.pxPerMeter <= 0)) return t;
 
-    int dirX = (ts->calib.config == AXIS_X_RIGHT_Y_UP || ts->calib.config == AXIS_X_RIGHT_Y_DOWN) ? 1 : -1;
-    int dirY = (ts->calib.config == AXIS_X_RIGHT_Y_DOWN || ts->calib.config == AXIS_X_LEFT_Y_DOWN) ? 1 : -1;
+    float dirX = (ts->calib.config == AXIS_X_RIGHT_Y_UP || ts->calib.config == AXIS_X_RIGHT_Y_DOWN) ? 1.0f : -1.0f;
+    float dirY = (ts->calib.config == AXIS_X_RIGHT_Y_DOWN || ts->calib.config == AXIS_X_LEFT_Y_DOWN) ? 1.0f : -1.0f;
 
-    float valX = (dxPx * dirX) / pxPerM;
-    float valY = (dyPx * dirY) / pxPerM;
+    // L'origine est placée sur l'image brute : on la corrige comme les points.
+    Vector2 origin = Lens_Undistort(&ts->calib.lens, ts->calib.origin);
+    if (H) {
+        // Le plan fournit déjà des mètres ; sans origine, le coin 1 en tient lieu.
+        origin = ts->calib.hasOriginSet ? Homography_Apply(H, origin) : (Vector2){ 0, 0 };
+        float axes[9] = { dirX, 0.0f, -dirX * origin.x, 0.0f, dirY, -dirY * origin.y, 0.0f, 0.0f, 1.0f };
+        Homography_Multiply(axes, H, t.m);
+        return t;
+    }
 
-    return (Vector2){ valX, valY };
+    float sx = dirX / ts->calib.pxPerMeter;
+    float sy = dirY / ts->calib.pxPerMeter;
+    t.m[0] = sx;   t.m[1] = 0.0f; t.m[2] = -sx * origin.x;
+    t.m[3] = 0.0f; t.m[4] = sy;   t.m[5] = -sy * origin.y;
+    return t;
+}
+
+void Tracking_TransformBatch(const PhysicalTransform *t, const float *x, const float *y, float *outX, float *outY, int count) {
+    const float *m = t->m;
+    int i = 0;
+#if defined(TRACKING_SIMD_AVX)
+    __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+    __m256 m3 = _mm256_set1_ps(m[3]), m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]);
+    __m256 m6 = _mm256_set1_ps(m[6]), m7 = _mm256_set1_ps(m[7]), m8 = _mm256_set1_ps(m[8]);
+    for (; i + 8 <= count; i += 8) {
+        __m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i);
+        __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, vx), _mm256_mul_ps(m1, vy)), m2);
+        __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m3, vx), _mm256_mul_ps(m4, vy)), m5);
+        __m256 rw = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m6, vx), _mm256_mul_ps(m7, vy)), m8);
+        _mm256_storeu_ps(outX + i, _mm256_div_ps(rx, rw));
+        _mm256_storeu_ps(outY + i, _mm256_div_ps(ry, rw));
+    }
+#elif defined(TRACKING_SIMD_SSE)
+    __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+    __m128 m3 = _mm_set1_ps(m[3]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+    __m128 m6 = _mm_set1_ps(m[6]), m7 = _mm_set1_ps(m[7]), m8 = _mm_set1_ps(m[8]);
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i);
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, vx), _mm_mul_ps(m1, vy)), m2);
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, vx), _mm_mul_ps(m4, vy)), m5);
+        __m128 rw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m6, vx), _mm_mul_ps(m7, vy)), m8);
+        _mm_storeu_ps(outX + i, _mm_div_ps(rx, rw));
+        _mm_storeu_ps(outY + i, _mm_div_ps(ry, rw));
+    }
+#elif defined(TRACKING_SIMD_NEON)
+    float32x4_t m0 = vdupq_n_f32(m[0]), m1 = vdupq_n_f32(m[1]), m2 = vdupq_n_f32(m[2]);
+    float32x4_t m3 = vdupq_n_f32(m[3]), m4 = vdupq_n_f32(m[4]), m5 = vdupq_n_f32(m[5]);
+    float32x4_t m6 = vdupq_n_f32(m[6]), m7 = vdupq_n_f32(m[7]), m8 = vdupq_n_f32(m[8]);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t vx = vld1q_f32(x + i), vy = vld1q_f32(y + i);
+        float32x4_t rx = vmlaq_f32(vmlaq_f32(m2, m0, vx), m1, vy);
+        float32x4_t ry = vmlaq_f32(vmlaq_f32(m5, m3, vx), m4, vy);
+        float32x4_t rw = vmlaq_f32(vmlaq_f32(m8, m6, vx), m7, vy);
+        // Inverse approchée puis deux pas de Newton (pas de division sur ARMv7).
+        float32x4_t inv = vrecpeq_f32(rw);
+        inv = vmulq_f32(vrecpsq_f32(rw, inv), inv);
+        inv = vmulq_f32(vrecpsq_f32(rw, inv), inv);
+        vst1q_f32(outX + i, vmulq_f32(rx, inv));
+        vst1q_f32(outY + i, vmulq_f32(ry, inv));
+    }
+#endif
+    for (; i < count; i++) {
+        float px = x[i], py = y[i];
+        float w = m[6] * px + m[7] * py + m[8];
+        outX[i] = (m[0] * px + m[1] * py + m[2]) / w;
+        outY[i] = (m[3] * px + m[4] * py + m[5]) / w;
+    }
+}
+
+// Signale une modification autre qu'un ajout en fin de série.
+void Tracking_MarkEdited(TrackingSystem *ts) {
+    ts->revision++;
+    ts->editRevision = ts->revision;
+}
+
+// Une seule passe pour toute la série : à appeler en tête de chaque consommateur
+// (tableau, graphique, exports) plutôt que point par point. Seuls les points
+// ajoutés depuis l'appel précédent sont transformés, sauf si l'étalonnage ou un
+// point existant a changé.
+void Tracking_UpdatePhysical(TrackingSystem *ts) {
+    PhysicalTransform t = Tracking_BuildTransform(ts);
+    bool sameTransform = ts->physValid && memcmp(&t, &ts->physTransform, sizeof(PhysicalTransform)) == 0;
+    if (!sameTransform && ts->physValid) Tracking_MarkEdited(ts);
+
+    int from = 0;
+    if (sameTransform && ts->physEdit == ts->editRevision && ts->physCount <= ts->count) from = ts->physCount;
+    Tracking_TransformBatch(&t, ts->undistX + from, ts->undistY + from, ts->physX + from, ts->physY + from, ts->count - from);
+
+    ts->physTransform = t;
+    ts->physCount = ts->count;
+    ts->physEdit = ts->editRevision;
+    ts->physValid = true;
+}
+
+Vector2 PixelToPhysical(struct TrackingSystem *ts, Vector2 pixelPos) {
+    PhysicalTransform t = Tracking_BuildTransform(ts);
+    Vector2 p = Lens_Undistort(&ts->calib.lens, pixelPos);
+    Tracking_TransformBatch(&t, &p.x, &p.y, &p.x, &p.y, 1);
+    return p;
+}
+
+// À rappeler quand le modèle d'objectif change ou que les points sont rechargés.
+void Tracking_ApplyLens(TrackingSystem *ts) {
+    for (int i = 0; i < ts->count; i++) {
+        ts->undistX[i] = ts->points[i].pixelPos.x;
+        ts->undistY[i] = ts->points[i].pixelPos.y;
+    }
+    Lens_UndistortBatch(&ts->calib.lens, ts->undistX, ts->undistY, ts->undistX, ts->undistY, ts->count);
+    Tracking_MarkEdited(ts);
+}
+
+static void Tracking_ApplyLensAt(TrackingSystem *ts, int index) {
+    Vector2 p = Lens_Undistort(&ts->calib.lens, ts->points[index].pixelPos);
+    ts->undistX[index] = p.x;
+    ts->undistY[index] = p.y;
 }
 
 void Tracking_Init(TrackingSystem *ts) {
@@ -31,7 +184,17 @@ void Tracking_Init(TrackingSystem *ts) {
     ts->calib.realDistance = 1.0f;
     ts->calib.pxPerMeter = 0.0f;
     ts->calib.hasOriginSet = false;
+    Lens_Reset(&ts->calib.lens);
+    LensLines_Clear(&ts->calib.lensLines);
+    ts->calib.isSettingLens = false;
+    ts->calib.planeStep = 0;
+    ts->calib.isSettingPlane = false;
+    ts->calib.planeWidth = 1.0f;
+    ts->calib.planeHeight = 1.0f;
+    ts->planeCache.computed = false;
     ts->startFrame=0;
+    ts->physValid = false;
+    Tracking_MarkEdited(ts);
 }
 
 Vector2 ScreenToVideo(Vector2 screenPos, Rectangle destRect, float sourceW, float sourceH) {
@@ -54,7 +217,11 @@ Vector2 VideoToScreen(Vector2 videoPos, Rectangle destRect, float sourceW, float
     return (Vector2){ scrX, scrY };
 }
 
-void Tracking_AddPoint(TrackingSystem *ts, double time, Vector2 videoPos) {
+bool Tracking_IsFull(const TrackingSystem *ts) {
+    return ts->count >= MAX_POINTS;
+}
+
+bool Tracking_AddPoint(TrackingSystem *ts, double time, Vector2 videoPos) {
     int existingIdx = -1;
     for (int i = 0; i < ts->count; i++) {
         if (fabs(ts->points[i].time - time) < 0.001) {
@@ -65,11 +232,15 @@ void Tracking_AddPoint(TrackingSystem *ts, double time, Vector2 videoPos) {
 
     if (existingIdx != -1) {
         ts->points[existingIdx].pixelPos = videoPos;
+        Tracking_ApplyLensAt(ts, existingIdx);
+        Tracking_MarkEdited(ts);
     } else {
-        if (ts->count < MAX_POINTS) {
-            ts->points[ts->count].time = time;
-            ts->points[ts->count].pixelPos = videoPos;
-            ts->count++;
-        }
+        if (Tracking_IsFull(ts)) return false;
+        ts->points[ts->count].time = time;
+        ts->points[ts->count].pixelPos = videoPos;
+        Tracking_ApplyLensAt(ts, ts->count);
+        ts->count++;
+        ts->revision++;
     }
+    return true;
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "lang.h"
+#include "derived.h"
 
 void CleanAndFormatFr(char* str) {
     if (strchr(str, '.') != NULL) {
@@ -35,8 +36,20 @@ const char* App_GetFileNameWithoutExt(const char* path) {
     return buffer;
 }
 
-void Action_ExportCSV(struct TrackingSystem *ts, const char* videoName) {
+// Grandeur dérivée j à la ligne i ; vide hors de la plage calculée ou si elle est en erreur.
+static void FormatDerivedCell(const DerivedSet *derived, int j, int i, char *buf, size_t size, bool localized) {
+    const float *values = derived ? Derived_Values(derived, j) : NULL;
+    buf[0] = '\0';
+    if (!values || i < derived->first || i >= derived->end) return;
+    snprintf(buf, size, "%.6g", values[i]);
+    if (localized && currentLang == LANG_FR) {
+        for (char *walk = buf; *walk; walk++) if (*walk == '.') *walk = ',';
+    }
+}
+
+void Action_ExportCSV(struct TrackingSystem *ts, const DerivedSet *derived, const char* videoName) {
     if (ts->count == 0) return;
+    Tracking_UpdatePhysical(ts);
 
     char defaultName[256];
     sprintf(defaultName, "export_%s.csv", App_GetFileNameWithoutExt(videoName));
@@ -46,23 +59,33 @@ void Action_ExportCSV(struct TrackingSystem *ts, const char* videoName) {
 
     FILE *f = fopen(path, "w");
     if (f) {
-        fprintf(f, "%s (s);%s (m);%s (m)\n", L(T_HEADER_TIME), L(T_HEADER_X), L(T_HEADER_Y));
+        int derivedCount = derived ? derived->count : 0;
+        fprintf(f, "%s (s);%s (m);%s (m)", L(T_HEADER_TIME), L(T_HEADER_X), L(T_HEADER_Y));
+        for (int j = 0; j < derivedCount; j++) fprintf(f, ";%s", derived->columns[j].name);
+        fprintf(f, "\n");
         for (int i = 0; i < ts->count; i++) {
-            Vector2 phys = PixelToPhysical(ts, ts->points[i].pixelPos);
+            Vector2 phys = { ts->physX[i], ts->physY[i] };
             char tBuf[64], xBuf[32], yBuf[32];
             sprintf(tBuf, "%.4lf", ts->points[i].time);
             sprintf(xBuf, "%.4f", phys.x);
             sprintf(yBuf, "%.4f", phys.y);
 
             CleanAndFormatFr(tBuf); CleanAndFormatFr(xBuf); CleanAndFormatFr(yBuf);
-            fprintf(f, "%s;%s;%s\n", tBuf, xBuf, yBuf);
+            fprintf(f, "%s;%s;%s", tBuf, xBuf, yBuf);
+            for (int j = 0; j < derivedCount; j++) {
+                char dBuf[32];
+                FormatDerivedCell(derived, j, i, dBuf, sizeof(dBuf), true);
+                fprintf(f, ";%s", dBuf);
+            }
+            fprintf(f, "\n");
         }
         fclose(f);
     }
 }
 
-void Action_ExportRegressi(struct TrackingSystem *ts, const char* videoName) {
+void Action_ExportRegressi(struct TrackingSystem *ts, const DerivedSet *derived, const char* videoName) {
     if (ts->count == 0) return;
+    Tracking_UpdatePhysical(ts);
     
     char defaultName[256];
     sprintf(defaultName, "regressi_%s.txt", App_GetFileNameWithoutExt(videoName));
@@ -75,39 +98,60 @@ void Action_ExportRegressi(struct TrackingSystem *ts, const char* videoName) {
         fprintf(f, "MotionLab Export\n");
         fprintf(f, "Video : %s\n", videoName);
         fprintf(f, "Donnees experimentales\n");
-        fprintf(f, "t\tx\ty\n");
-        fprintf(f, "s\tm\tm\n");
-        fprintf(f, "Temps\tAbscisse\tOrdonnee\n");
+        int derivedCount = derived ? derived->count : 0;
+        fprintf(f, "t\tx\ty");
+        for (int j = 0; j < derivedCount; j++) fprintf(f, "\t%s", derived->columns[j].name);
+        fprintf(f, "\ns\tm\tm");
+        for (int j = 0; j < derivedCount; j++) fprintf(f, "\t");
+        fprintf(f, "\nTemps\tAbscisse\tOrdonnee");
+        for (int j = 0; j < derivedCount; j++) fprintf(f, "\t%s", derived->columns[j].source);
+        fprintf(f, "\n");
 
         for (int i = 0; i < ts->count; i++) {
-            Vector2 phys = PixelToPhysical(ts, ts->points[i].pixelPos);
-            fprintf(f, "%.4lf\t%.4f\t%.4f\n", 
+            Vector2 phys = { ts->physX[i], ts->physY[i] };
+            fprintf(f, "%.4lf\t%.4f\t%.4f", 
                     ts->points[i].time, 
                     phys.x, 
                     phys.y);
+            for (int j = 0; j < derivedCount; j++) {
+                char dBuf[32];
+                FormatDerivedCell(derived, j, i, dBuf, sizeof(dBuf), false);
+                fprintf(f, "\t%s", dBuf);
+            }
+            fprintf(f, "\n");
         }
         fclose(f);
     }
 }
 
-void Action_CopyClipboard(struct TrackingSystem *ts) {
+void Action_CopyClipboard(struct TrackingSystem *ts, const DerivedSet *derived) {
     if (ts->count == 0) return;
-    size_t bufferSize = ts->count * 100 + 128; 
+    Tracking_UpdatePhysical(ts);
+    int derivedCount = derived ? derived->count : 0;
+    size_t bufferSize = (size_t)ts->count * (100 + 32 * derivedCount) + 128 + derivedCount * DERIVED_NAME_LEN;
     char* buffer = (char*)malloc(bufferSize);
     if (!buffer) return;
 
-    strcpy(buffer, "t(s)\tx(m)\ty(m)\n");
+    // Écriture en fin de tampon : strcat reparcourrait tout le texte à chaque ligne.
+    size_t len = (size_t)snprintf(buffer, bufferSize, "t(s)\tx(m)\ty(m)");
+    for (int j = 0; j < derivedCount; j++) len += (size_t)snprintf(buffer + len, bufferSize - len, "\t%s", derived->columns[j].name);
+    len += (size_t)snprintf(buffer + len, bufferSize - len, "\n");
     for (int i = 0; i < ts->count; i++) {
-        Vector2 phys = PixelToPhysical(ts, ts->points[i].pixelPos);
-        char line[128], tBuf[64], xBuf[32], yBuf[32];
+        Vector2 phys = { ts->physX[i], ts->physY[i] };
+        char tBuf[64], xBuf[32], yBuf[32];
         
         sprintf(tBuf, "%.4lf", ts->points[i].time);
         sprintf(xBuf, "%.4f", phys.x);
         sprintf(yBuf, "%.4f", phys.y);
         
         CleanAndFormatFr(tBuf); CleanAndFormatFr(xBuf); CleanAndFormatFr(yBuf);
-        sprintf(line, "%s\t%s\t%s\n", tBuf, xBuf, yBuf);
-        strcat(buffer, line);
+        len += (size_t)snprintf(buffer + len, bufferSize - len, "%s\t%s\t%s", tBuf, xBuf, yBuf);
+        for (int j = 0; j < derivedCount; j++) {
+            char dBuf[32];
+            FormatDerivedCell(derived, j, i, dBuf, sizeof(dBuf), true);
+            len += (size_t)snprintf(buffer + len, bufferSize - len, "\t%s", dBuf);
+        }
+        len += (size_t)snprintf(buffer + len, bufferSize - len, "\n");
     }
     SetClipboardText(buffer);
     free(buffer);
@@ -115,7 +159,7 @@ void Action_CopyClipboard(struct TrackingSystem *ts) {
 
 
 
-void Action_SaveProject(struct TrackingSystem *ts, const char* videoPath) {
+void Action_SaveProject(struct TrackingSystem *ts, struct VideoEngine *v, const DerivedSet *derived, const char* videoPath) {
     char defaultName[256];
     sprintf(defaultName, "%s.lab", App_GetFileNameWithoutExt(videoPath));
     
@@ -142,6 +186,36 @@ void Action_SaveProject(struct TrackingSystem *ts, const char* videoPath) {
         ts->startFrame
     );
 
+    // Distorsion : k1 | k2 | p1 | p2 | centreX | centreY | focale
+    if (ts->calib.lens.enabled) {
+        fprintf(f, "LENS|%f|%f|%f|%f|%f|%f|%f\n",
+            ts->calib.lens.k1, ts->calib.lens.k2, ts->calib.lens.p1, ts->calib.lens.p2,
+            ts->calib.lens.center.x, ts->calib.lens.center.y, ts->calib.lens.focal);
+    }
+
+    // Plan en perspective : 4 coins (x | y) puis largeur | hauteur en mètres
+    if (ts->calib.planeStep == 4) {
+        fprintf(f, "PLANE");
+        for (int i = 0; i < 4; i++) fprintf(f, "|%f|%f", ts->calib.planePoints[i].x, ts->calib.planePoints[i].y);
+        fprintf(f, "|%f|%f\n", ts->calib.planeWidth, ts->calib.planeHeight);
+    }
+
+    // Zone d'analyse en pixels de l'image complète : x | y | largeur | hauteur
+    if (v->isLoaded && !VideoCrop_IsFull(&v->crop, v->width, v->height)) {
+        fprintf(f, "CROP|%d|%d|%d|%d\n", v->crop.x, v->crop.y, v->crop.width, v->crop.height);
+    }
+
+    // Cadence choisie pour une suite d'images (images/s)
+    if (v->isLoaded && v->sequence) {
+        fprintf(f, "FPS|%f\n", v->fps);
+    }
+
+    // Grandeurs dérivées : m | g, puis une ligne "nom = expression" par grandeur
+    if (derived && derived->count > 0) {
+        fprintf(f, "PARAMS|%f|%f\n", derived->params[DERIVED_MASS], derived->params[DERIVED_GRAVITY]);
+        for (int j = 0; j < derived->count; j++) fprintf(f, "DERIVED|%s\n", derived->columns[j].source);
+    }
+
     fprintf(f, "POINTS|%d\n", ts->count);
     
     for (int i = 0; i < ts->count; i++) {
@@ -150,7 +224,7 @@ void Action_SaveProject(struct TrackingSystem *ts, const char* videoPath) {
     fclose(f);
 }
 
-bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, char* outVideoPath) {
+bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, DerivedSet *derived, char* outVideoPath) {
     char* path = sfd_open_file("Projet MotionLab\0*.lab\0");
     if (!path) return false;
 
@@ -165,6 +239,14 @@ bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, char*
 
     ts->count = 0;
     ts->startFrame = 0; 
+    v->cropRequest = (Rectangle){ 0 };
+    v->sequenceFps = 0.0;
+    Lens_Reset(&ts->calib.lens);
+    LensLines_Clear(&ts->calib.lensLines);
+    ts->calib.planeStep = 0;
+    if (derived) {
+        while (derived->count > 0) Derived_Remove(derived, derived->count - 1);
+    }
 
     while (fgets(line, sizeof(line), f)) {
         size_t len = strlen(line);
@@ -201,6 +283,42 @@ bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, char*
                 }
             }
         }
+        else if (strncmp(line, "LENS|", 5) == 0) {
+            LensModel *lens = &ts->calib.lens;
+            if (sscanf(line + 5, "%f|%f|%f|%f|%f|%f|%f", &lens->k1, &lens->k2, &lens->p1, &lens->p2,
+                       &lens->center.x, &lens->center.y, &lens->focal) == 7 && lens->focal > 0) {
+                lens->enabled = true;
+            } else {
+                Lens_Reset(lens);
+            }
+        }
+        else if (strncmp(line, "PLANE|", 6) == 0) {
+            Vector2 *c = ts->calib.planePoints;
+            int readCount = sscanf(line + 6, "%f|%f|%f|%f|%f|%f|%f|%f|%f|%f",
+                &c[0].x, &c[0].y, &c[1].x, &c[1].y, &c[2].x, &c[2].y, &c[3].x, &c[3].y,
+                &ts->calib.planeWidth, &ts->calib.planeHeight);
+            ts->calib.planeStep = (readCount == 10) ? 4 : 0;
+        }
+        else if (strncmp(line, "CROP|", 5) == 0) {
+            Rectangle crop = { 0 };
+            if (sscanf(line + 5, "%f|%f|%f|%f", &crop.x, &crop.y, &crop.width, &crop.height) == 4) {
+                v->cropRequest = crop;
+            }
+        }
+        else if (strncmp(line, "FPS|", 4) == 0) {
+            double fps = 0.0;
+            if (sscanf(line + 4, "%lf", &fps) == 1) Video_SetSequenceFps(v, fps);
+        }
+        else if (strncmp(line, "PARAMS|", 7) == 0 && derived) {
+            float m, g;
+            if (sscanf(line + 7, "%f|%f", &m, &g) == 2) {
+                derived->params[DERIVED_MASS] = m;
+                derived->params[DERIVED_GRAVITY] = g;
+            }
+        }
+        else if (strncmp(line, "DERIVED|", 8) == 0 && derived) {
+            if (derived->count < DERIVED_MAX) Derived_Define(derived, derived->count, line + 8);
+        }
         else if (strncmp(line, "P|", 2) == 0) {
             if (ts->count < MAX_POINTS) { 
                 sscanf(line + 2, "%lf|%f|%f", &ts->points[ts->count].time, &ts->points[ts->count].pixelPos.x, &ts->points[ts->count].pixelPos.y);
@@ -209,5 +327,6 @@ bool Action_LoadProject(struct TrackingSystem *ts, struct VideoEngine *v, char*
         }
     }
     fclose(f);
+    Tracking_ApplyLens(ts);
     return true;
 }
\ No newline at end of file
@@ -8,6 +8,18 @@
 #include "auto_tracker.h"
 #include "lang.h"
 
+// La texture ne contient que la zone d'analyse, mais les points restent exprimés en
+// pixels de l'image complète.
+static Vector2 CanvasToFrame(struct VideoEngine *v, Vector2 screenPos, Rectangle destRec) {
+    Vector2 p = ScreenToVideo(screenPos, destRec, (float)v->crop.width, (float)v->crop.height);
+    return (Vector2){ p.x + v->crop.x, p.y + v->crop.y };
+}
+
+static Vector2 FrameToCanvas(struct VideoEngine *v, Vector2 framePos, Rectangle destRec) {
+    Vector2 p = { framePos.x - v->crop.x, framePos.y - v->crop.y };
+    return VideoToScreen(p, destRec, (float)v->crop.width, (float)v->crop.height);
+}
+
 void DrawOutlinedLine(Vector2 start, Vector2 end, float thick, Color color) {
     DrawLineEx(start, end, thick + 2.0f, (Color){0, 0, 0, 150}); 
     DrawLineEx(start, end, thick, color);
@@ -59,14 +71,14 @@ void DrawMagnifierWindow(struct VideoEngine *v, struct UIState *ui, Rectangle vi
     DrawRectangleRec(contentRect, (Color){20, 20, 20, 255});
     
 
-    float scale = fminf(videoArea.width / (float)v->width, videoArea.height / (float)v->height);
-    float offsetX = videoArea.x + (videoArea.width - (float)v->width * scale) / 2.0f;
-    float offsetY = videoArea.y + (videoArea.height - (float)v->height * scale) / 2.0f;
+    float scale = fminf(videoArea.width / (float)v->crop.width, videoArea.height / (float)v->crop.height);
+    float offsetX = videoArea.x + (videoArea.width - (float)v->crop.width * scale) / 2.0f;
+    float offsetY = videoArea.y + (videoArea.height - (float)v->crop.height * scale) / 2.0f;
     float mVidX = (mouse.x - offsetX) / scale;
     float mVidY = (mouse.y - offsetY) / scale;
     
 
-    Rectangle destV = { offsetX, offsetY, v->width*scale, v->height*scale };
+    Rectangle destV = { offsetX, offsetY, v->crop.width*scale, v->crop.height*scale };
 
     if (CheckCollisionPointRec(mouse, destV)) {
         float srcW = contentRect.width / mag->zoomLevel;
@@ -89,9 +101,9 @@ void DrawMagnifierWindow(struct VideoEngine *v, struct UIState *ui, Rectangle vi
 void UpdateVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingSystem *ts, struct AutoTracker *autoTracker, Rectangle area) {
     if (!v->isLoaded || ui->isMenuOpen) return;
 
-    float scale = fminf(area.width / (float)v->width, area.height / (float)v->height);
-    float displayW = (float)v->width * scale;
-    float displayH = (float)v->height * scale;
+    float scale = fminf(area.width / (float)v->crop.width, area.height / (float)v->crop.height);
+    float displayW = (float)v->crop.width * scale;
+    float displayH = (float)v->crop.height * scale;
     float offsetX = area.x + (area.width - displayW) / 2.0f;
     float offsetY = area.y + (area.height - displayH) / 2.0f;
     Rectangle destRec = { offsetX, offsetY, displayW, displayH };
@@ -99,9 +111,30 @@ void UpdateVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct Trackin
     Vector2 mouse = GetMousePosition();
     bool mouseInVideo = CheckCollisionPointRec(mouse, destRec);
     bool isOverMagnifier = (ui->magnifier.isVisible && CheckCollisionPointRec(mouse, ui->magnifier.bounds));
-    if (!mouseInVideo || isOverMagnifier || ui->showGraphWindow) return;
 
-    Vector2 mouseVideo = ScreenToVideo(mouse, destRec, (float)v->width, (float)v->height);
+    if (ui->isSettingCrop) {
+        Vector2 framePos = CanvasToFrame(v, mouse, destRec);
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && mouseInVideo && !isOverMagnifier && !ui->showGraphWindow && !ui->showSpectrumWindow && !ui->showDerivedWindow) {
+            ui->isDraggingCrop = true;
+            ui->cropAnchor = framePos;
+        }
+        if (ui->isDraggingCrop) {
+            ui->cropDraft = (Rectangle){
+                fminf(ui->cropAnchor.x, framePos.x), fminf(ui->cropAnchor.y, framePos.y),
+                fabsf(framePos.x - ui->cropAnchor.x), fabsf(framePos.y - ui->cropAnchor.y)
+            };
+            if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+                ui->isDraggingCrop = false;
+                ui->isSettingCrop = false;
+                Video_SetCrop(v, ui->cropDraft);
+            }
+        }
+        return;
+    }
+
+    if (!mouseInVideo || isOverMagnifier || ui->showGraphWindow || ui->showSpectrumWindow || ui->showDerivedWindow) return;
+
+    Vector2 mouseVideo = CanvasToFrame(v, mouse, destRec);
 
     if (ts->calib.isSettingOrigin && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
         ts->calib.origin = mouseVideo;
@@ -122,9 +155,17 @@ void UpdateVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct Trackin
     if (ts->calib.isSettingScale && ts->calib.scaleStep == 1) {
         ts->calib.scalePointB = mouseVideo;
     }
+    if (ts->calib.isSettingPlane && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && ts->calib.planeStep < 4) {
+        ts->calib.planePoints[ts->calib.planeStep++] = mouseVideo;
+        if (ts->calib.planeStep == 4) ts->calib.isSettingPlane = false;
+    }
+    if (ts->calib.isSettingLens) {
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) LensLines_Add(&ts->calib.lensLines, mouseVideo);
+        if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) LensLines_NextLine(&ts->calib.lensLines);
+    }
 
     if (ui->currentTool == TOOL_POINT && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (!ts->calib.isSettingOrigin && !ts->calib.isSettingScale) {
+        if (!ts->calib.isSettingOrigin && !ts->calib.isSettingScale && !ts->calib.isSettingLens && !ts->calib.isSettingPlane) {
             int currentFrame = (int)(v->currentTime * v->fps + 0.5);
             if (currentFrame >= ts->startFrame) {
                 Tracking_AddPoint(ts, v->currentTime, mouseVideo);
@@ -168,19 +209,21 @@ void UpdateVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct Trackin
 void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingSystem *ts, struct AutoTracker *autoTracker, Rectangle area) {
     if (!v->isLoaded) {
         const char* msg = L(T_DRAG_VIDEO);
+        if (v->loadState == VIDEO_LOAD_OPENING || v->loadState == VIDEO_LOAD_METADATA) msg = L(T_VIDEO_OPENING);
+        else if (v->loadState == VIDEO_LOAD_FAILED) msg = L(T_VIDEO_OPEN_FAILED);
         int textW = MeasureText(msg, 20);
         DrawTextApp(ui, msg, (int)(area.x + area.width/2 - textW/2), (int)(area.y + area.height/2), 20, GRAY);
         return;
     }
 
-    float scale = fminf(area.width / (float)v->width, area.height / (float)v->height);
-    float displayW = (float)v->width * scale;
-    float displayH = (float)v->height * scale;
+    float scale = fminf(area.width / (float)v->crop.width, area.height / (float)v->crop.height);
+    float displayW = (float)v->crop.width * scale;
+    float displayH = (float)v->crop.height * scale;
     float offsetX = area.x + (area.width - displayW) / 2.0f;
     float offsetY = area.y + (area.height - displayH) / 2.0f;
 
     Rectangle destRec = { offsetX, offsetY, displayW, displayH };
-    Rectangle sourceRec = { 0.0f, 0.0f, (float)v->width, (float)v->height };
+    Rectangle sourceRec = { 0.0f, 0.0f, (float)v->crop.width, (float)v->crop.height };
 
     DrawTexturePro(v->texture, sourceRec, destRec, (Vector2){0,0}, 0.0f, WHITE);
 
@@ -190,8 +233,8 @@ void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingS
 
     if (autoTracker->state != TRACKER_IDLE) {
         Rectangle r = autoTracker->targetRect;
-        Vector2 p1 = VideoToScreen((Vector2){r.x, r.y}, destRec, (float)v->width, (float)v->height);
-        Vector2 p2 = VideoToScreen((Vector2){r.x + r.width, r.y + r.height}, destRec, (float)v->width, (float)v->height);
+        Vector2 p1 = FrameToCanvas(v, (Vector2){r.x, r.y}, destRec);
+        Vector2 p2 = FrameToCanvas(v, (Vector2){r.x + r.width, r.y + r.height}, destRec);
         Rectangle screenR = { p1.x, p1.y, p2.x - p1.x, p2.y - p1.y };
 
         if (autoTracker->state == TRACKER_SELECTING) {
@@ -218,7 +261,7 @@ void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingS
         }
         else if (autoTracker->state == TRACKER_TRACKING) {
             DrawRectangleLinesEx(screenR, 2, GREEN);
-            Vector2 centerScreen = VideoToScreen(autoTracker->centerPos, destRec, (float)v->width, (float)v->height);
+            Vector2 centerScreen = FrameToCanvas(v, autoTracker->centerPos, destRec);
             DrawCircleV(centerScreen, 3.0f, RED);
             DrawText(L(T_TRACKING_MSG), (int)screenR.x, (int)screenR.y - 20, 10, GREEN);
         }
@@ -232,8 +275,8 @@ void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingS
     }
 
     if (ui->showAxes && (ts->calib.hasOriginSet || ts->calib.isSettingOrigin)) {
-        Vector2 originVideo = (ts->calib.isSettingOrigin && mouseInVideo) ? ScreenToVideo(mouse, destRec, (float)v->width, (float)v->height) : ts->calib.origin;
-        Vector2 originScreen = VideoToScreen(originVideo, destRec, (float)v->width, (float)v->height);
+        Vector2 originVideo = (ts->calib.isSettingOrigin && mouseInVideo) ? CanvasToFrame(v, mouse, destRec) : ts->calib.origin;
+        Vector2 originScreen = FrameToCanvas(v, originVideo, destRec);
         int dirX = (ts->calib.config == AXIS_X_RIGHT_Y_UP || ts->calib.config == AXIS_X_RIGHT_Y_DOWN) ? 1 : -1;
         int dirY = (ts->calib.config == AXIS_X_RIGHT_Y_DOWN || ts->calib.config == AXIS_X_LEFT_Y_DOWN) ? 1 : -1;
         Color finalColor = ts->calib.isSettingOrigin ? YELLOW : WHITE;
@@ -252,8 +295,8 @@ void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingS
     }
 
     if (ts->calib.scaleStep > 0 || ts->calib.pxPerMeter > 0) {
-        Vector2 pA = VideoToScreen(ts->calib.scalePointA, destRec, (float)v->width, (float)v->height);
-        Vector2 pB = VideoToScreen(ts->calib.scalePointB, destRec, (float)v->width, (float)v->height);
+        Vector2 pA = FrameToCanvas(v, ts->calib.scalePointA, destRec);
+        Vector2 pB = FrameToCanvas(v, ts->calib.scalePointB, destRec);
         Color scaleColor = COLOR_ACCENT;
         DrawOutlinedLine(pA, pB, 2.0f, scaleColor);
         DrawCircleV(pA, 4.0f, scaleColor);
@@ -268,9 +311,34 @@ void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingS
         }
     }
 
+    if (ts->calib.isSettingLens || (ts->calib.lensLines.count > 0 && !ts->calib.lens.enabled)) {
+        const LensLines *lines = &ts->calib.lensLines;
+        for (int i = 0; i < lines->count; i++) {
+            Vector2 p = FrameToCanvas(v, lines->points[i], destRec);
+            Color lineColor = (lines->lineIds[i] % 2 == 0) ? SKYBLUE : ORANGE;
+            if (i > 0 && lines->lineIds[i - 1] == lines->lineIds[i]) {
+                DrawLineEx(FrameToCanvas(v, lines->points[i - 1], destRec), p, 1.5f, lineColor);
+            }
+            DrawCircleV(p, 3.0f, lineColor);
+        }
+    }
+
+    if (ts->calib.planeStep > 0) {
+        Color planeColor = ts->calib.isSettingPlane ? YELLOW : LIME;
+        Vector2 corners[4];
+        for (int i = 0; i < ts->calib.planeStep; i++) corners[i] = FrameToCanvas(v, ts->calib.planePoints[i], destRec);
+        for (int i = 0; i < ts->calib.planeStep; i++) {
+            if (i > 0) DrawOutlinedLine(corners[i - 1], corners[i], 1.5f, planeColor);
+            DrawCircleV(corners[i], 4.0f, planeColor);
+            DrawTextApp(ui, TextFormat("%d", i + 1), (int)corners[i].x + 6, (int)corners[i].y - 16, 14, planeColor);
+        }
+        if (ts->calib.planeStep == 4) DrawOutlinedLine(corners[3], corners[0], 1.5f, planeColor);
+        else if (ts->calib.isSettingPlane && mouseInVideo) DrawOutlinedLine(corners[ts->calib.planeStep - 1], mouse, 1.0f, planeColor);
+    }
+
     if (ui->showPoints) {
         for (int i = 0; i < ts->count; i++) {
-            Vector2 screenPos = VideoToScreen(ts->points[i].pixelPos, destRec, (float)v->width, (float)v->height);
+            Vector2 screenPos = FrameToCanvas(v, ts->points[i].pixelPos, destRec);
             bool isCurrent = (fabs(ts->points[i].time - v->currentTime) < 0.001);
             if (isCurrent) {
                 DrawCircleV(screenPos, 5.0f, RED); DrawCircleLines((int)screenPos.x, (int)screenPos.y, 8.0f, RED);
@@ -281,6 +349,21 @@ void DrawVideoCanvas(struct VideoEngine *v, struct UIState *ui, struct TrackingS
         }
     }
 
+    if (ui->isSettingCrop) {
+        if (ui->isDraggingCrop) {
+            Vector2 c1 = FrameToCanvas(v, (Vector2){ ui->cropDraft.x, ui->cropDraft.y }, destRec);
+            Vector2 c2 = FrameToCanvas(v, (Vector2){ ui->cropDraft.x + ui->cropDraft.width, ui->cropDraft.y + ui->cropDraft.height }, destRec);
+            Rectangle screenCrop = { c1.x, c1.y, c2.x - c1.x, c2.y - c1.y };
+            DrawRectangleRec(screenCrop, (Color){255, 255, 0, 40});
+            DrawRectangleLinesEx(screenCrop, 2, YELLOW);
+        }
+        if (mouseInVideo) DrawTextApp(ui, L(T_CROP_ZONE), (int)mouse.x + 15, (int)mouse.y, 12, YELLOW);
+    }
+
     if (ts->calib.isSettingOrigin && mouseInVideo) DrawCircleLines((int)mouse.x, (int)mouse.y, 10, YELLOW);
     if (ts->calib.isSettingScale && mouseInVideo) DrawTextApp(ui, ts->calib.scaleStep==0?L(T_POINT_A) : L(T_POINT_B), (int)mouse.x+15, (int)mouse.y, 12, COLOR_ACCENT);
+    // Les nouveaux points ne sont plus enregistrés : on le signale au lieu de les perdre en silence.
+    if ((ui->currentTool == TOOL_POINT || ui->currentTool == TOOL_TRACK) && Tracking_IsFull(ts) && mouseInVideo) {
+        DrawTextApp(ui, TextFormat(L(T_POINTS_FULL), MAX_POINTS), (int)mouse.x + 15, (int)mouse.y + 16, 12, RED);
+    }
 }
\ No newline at end of file
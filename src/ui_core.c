@@ -38,6 +38,12 @@ const char* GetFileNameFromPath(const char* path) {
     return filename ? filename + 1 : path;
 }
 
+// Zone de défilement active : les widgets masqués par le scissor ne réagissent pas.
+bool IsMouseInWidgetClip(UIState *ui) {
+    if (ui->widgetClip.width <= 0 || ui->widgetClip.height <= 0) return true;
+    return CheckCollisionPointRec(GetMousePosition(), ui->widgetClip);
+}
+
 static Texture2D LoadTextureFromRes(const unsigned char *data, unsigned int size) {
     Image img = LoadImageFromMemory(".png", data, size);
     Texture2D tex = LoadTextureFromImage(img);
@@ -58,6 +64,8 @@ void InitUIState(UIState *state){
     state->magnifier.isDragging = false;
     state->magnifier.dragOffset = (Vector2){ 0, 0 };
     state->showGraphWindow = false;
+    state->showSpectrumWindow = false;
+    state->showDerivedWindow = false;
     state->showHelp = false;
     state->isWindowDragging = false;
     state->isResizing = false;  
@@ -65,12 +73,21 @@ void InitUIState(UIState *state){
     state->isMaximized = false;
     state->isMenuOpen = false;
     state->isEditingDist = false;
+    state->isEditingText = false;
     memset(state->distInputBuf, 0, 64);
     state->distCursorIndex = 0;
     state->distSelectStart = -1;
     state->distScrollOffset = 0.0f;
     state->tableScrollOffset = 0.0f;
     state->isDraggingTableScroll = false;
+    state->tableDerived = 0;
+    state->derived = NULL;
+}
+
+// Police TTF embarquée, pour qui doit la rastériser à une autre taille.
+const unsigned char* GetAppFontData(int *size) {
+    if (size) *size = (int)fonts_Inter_24pt_Medium_ttf_size;
+    return fonts_Inter_24pt_Medium_ttf_data;
 }
 
 void LoadUIResources(UIState *state){
@@ -383,7 +400,7 @@ bool DrawTitleBar(UIState *state, const char* fullPath, struct VideoEngine *vide
         }
     }
     DrawMenuBar(state, video, ts, tracker);
-    return shouldClose;
+    return shouldClose || state->requestQuit;
 }
 
 
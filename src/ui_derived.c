@@ -0,0 +1,128 @@
+#include "ui_derived.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+#include "theme.h"
+#include "ui_panels.h"
+#include "lang.h"
+
+#define DERIVED_ROW_H 48
+
+static const TextID exprErrorLabels[EXPR_ERROR_COUNT] = {
+    T_EXPR_ERR_SYNTAX, T_EXPR_ERR_EMPTY, T_EXPR_ERR_SYNTAX, T_EXPR_ERR_PAREN,
+    T_EXPR_ERR_UNKNOWN, T_EXPR_ERR_ARGS, T_EXPR_ERR_COMPLEX, T_EXPR_ERR_NAME
+};
+
+void InitDerivedWindow(DerivedWindowState *state) {
+    int sw = GetScreenWidth(); int sh = GetScreenHeight();
+    *state = (DerivedWindowState){ 0 };
+    state->bounds = (Rectangle){ (float)sw/2 - 320, (float)sh/2 - 245, 640, 490 };
+    state->editIndex = -1;
+}
+
+// Valide la ligne éditée : un texte vide retire la grandeur.
+static void DerivedCommit(DerivedWindowState *state, DerivedSet *set) {
+    int index = state->editIndex;
+    state->editIndex = -1;
+    state->text.editing = false;
+    if (index < 0 || index > set->count) return;
+    bool empty = true;
+    for (const char *c = state->editBuf; *c && empty; c++) empty = (*c == ' ' || *c == '\t');
+    if (empty) {
+        if (index < set->count) Derived_Remove(set, index);
+        return;
+    }
+    Derived_Define(set, index, state->editBuf);
+}
+
+static void DerivedStartEdit(UIState *ui, DerivedWindowState *state, int index, const char *source) {
+    state->editIndex = index;
+    snprintf(state->editBuf, sizeof(state->editBuf), "%s", source);
+    state->text.editing = true;
+    state->text.cursor = (int)strlen(state->editBuf);
+    state->text.scroll = 0.0f;
+    ui->isEditingText = true;
+}
+
+void DrawDerivedWindow(UIState *ui, DerivedWindowState *state, DerivedSet *set) {
+    if (!ui->showDerivedWindow) {
+        if (state->editIndex >= 0) {
+            DerivedCommit(state, set);
+            ui->isEditingText = false;
+        }
+        return;
+    }
+
+    DrawRectangleRec(state->bounds, (Color){35, 35, 35, 255});
+    DrawRectangleLinesEx(state->bounds, 1, (Color){60, 60, 60, 255});
+
+    Rectangle header = { state->bounds.x, state->bounds.y, state->bounds.width, 35 };
+    Rectangle closeBtn = { state->bounds.x + state->bounds.width - 35, state->bounds.y, 35, 35 };
+    Vector2 mouse = GetMousePosition();
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, header) && !CheckCollisionPointRec(mouse, closeBtn)) {
+        state->isDragging = true; state->dragOffset = (Vector2){ mouse.x - state->bounds.x, mouse.y - state->bounds.y };
+    }
+    if (state->isDragging) {
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) { state->bounds.x = mouse.x - state->dragOffset.x; state->bounds.y = mouse.y - state->dragOffset.y; }
+        else state->isDragging = false;
+    }
+    DrawRectangleRec(header, (Color){45, 45, 45, 255});
+    DrawTextEx(ui->appFont, L(T_DERIVED_TITLE), (Vector2){state->bounds.x + 12, state->bounds.y + 8}, 16, 1.0f, LIGHTGRAY);
+    if (GuiButton(ui, closeBtn, "X")) ui->showDerivedWindow = false;
+
+    // Paramètres : leur modification réévalue tout au prochain Derived_Update.
+    float startX = state->bounds.x + 15;
+    float startY = state->bounds.y + 45;
+    DrawTextEx(ui->appFont, L(T_DERIVED_MASS), (Vector2){ startX, startY + 7 }, 14, 1.0f, LIGHTGRAY);
+    GuiFloatInput(ui, (Rectangle){ startX + 85, startY, 105, 28 }, &set->params[DERIVED_MASS], "kg");
+    DrawTextEx(ui->appFont, L(T_DERIVED_GRAVITY), (Vector2){ startX + 205, startY + 7 }, 14, 1.0f, LIGHTGRAY);
+    GuiFloatInput(ui, (Rectangle){ startX + 300, startY, 105, 28 }, &set->params[DERIVED_GRAVITY], "m/s²");
+    bool addPresets = GuiButton(ui, (Rectangle){ state->bounds.x + state->bounds.width - 225, startY, 210, 28 }, L(T_DERIVED_PRESETS));
+
+    // Une ligne par grandeur ; les retraits et ajouts sont appliqués après la
+    // boucle, une fois la ligne éditée validée par le clic.
+    float rowY = startY + 45;
+    float fieldW = state->bounds.width - 30 - 38;
+    int removeIndex = -1;
+    int rows = (state->editIndex == set->count) ? set->count + 1 : set->count;
+    for (int j = 0; j < rows; j++) {
+        Rectangle field = { startX, rowY, fieldW, 28 };
+        if (j == state->editIndex) {
+            if (GuiTextInput(ui, field, state->editBuf, sizeof(state->editBuf), &state->text)) DerivedCommit(state, set);
+        } else {
+            const DerivedColumn *col = &set->columns[j];
+            bool hover = CheckCollisionPointRec(mouse, field);
+            DrawRectangleRounded(field, 0.3f, 4, (Color){50, 50, 50, 255});
+            DrawRectangleRoundedLines(field, 0.3f, 4, hover ? (Color){120, 120, 120, 255} : (Color){80, 80, 80, 255});
+            BeginScissorMode((int)field.x + 2, (int)field.y + 2, (int)field.width - 4, (int)field.height - 4);
+            DrawTextEx(ui->appFont, col->source, (Vector2){ field.x + 5, field.y + 7 }, 14, 1.0f, col->valid ? WHITE : (Color){239, 83, 80, 255});
+            EndScissorMode();
+            if (hover && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+                if (state->editIndex >= 0) DerivedCommit(state, set);
+                DerivedStartEdit(ui, state, j, set->columns[j].source);
+            }
+        }
+        if (j < set->count) {
+            if (GuiButton(ui, (Rectangle){ startX + fieldW + 10, rowY, 28, 28 }, "X")) removeIndex = j;
+            const DerivedColumn *col = &set->columns[j];
+            if (!col->valid) {
+                const char *msg = TextFormat(L(T_DERIVED_ERR_AT), L(exprErrorLabels[col->error]), col->errorPos + 1);
+                DrawTextEx(ui->appFont, msg, (Vector2){ startX + 5, rowY + 31 }, 13, 1.0f, (Color){239, 83, 80, 255});
+            }
+        }
+        rowY += DERIVED_ROW_H;
+    }
+
+    if (set->count < DERIVED_MAX && state->editIndex != set->count) {
+        if (GuiButton(ui, (Rectangle){ startX, rowY, 190, 28 }, L(T_DERIVED_ADD))) {
+            if (state->editIndex >= 0) DerivedCommit(state, set);
+            DerivedStartEdit(ui, state, set->count, "");
+        }
+    }
+    if (removeIndex >= 0 && state->editIndex < 0) Derived_Remove(set, removeIndex);
+    if (addPresets && state->editIndex < 0) Derived_AddPresets(set);
+
+    float helpY = state->bounds.y + state->bounds.height - 50;
+    DrawTextEx(ui->appFont, L(T_DERIVED_HELP_VARS), (Vector2){ startX, helpY }, 13, 1.0f, GRAY);
+    DrawTextEx(ui->appFont, L(T_DERIVED_HELP_FUNCS), (Vector2){ startX, helpY + 20 }, 13, 1.0f, GRAY);
+}
@@ -4,107 +4,31 @@
 #include <stdio.h>
 #include <math.h>
 #include <float.h> 
+#include <string.h>
+#include <stdlib.h>
 #include "theme.h"
 #include "ui_panels.h"
 #include "lang.h"
-
-Vector2 GetPos(TrackingSystem *ts, int i) {
-    if (i < 0) i = 0; if (i >= ts->count) i = ts->count - 1;
-    return PixelToPhysical(ts, ts->points[i].pixelPos);
-}
-
-float CalculateVelocity(TrackingSystem *ts, int index, bool isX) {
-    if (index <= ts->startFrame || index >= ts->count - 1) return 0.0f;
-    
-    Vector2 pPrev = GetPos(ts, index - 1); 
-    Vector2 pNext = GetPos(ts, index + 1);
-    float dt = ts->points[index + 1].time - ts->points[index - 1].time; 
-    
-    if (fabs(dt) < 1e-6) return 0.0f;
-    return (isX ? (pNext.x - pPrev.x) : (pNext.y - pPrev.y)) / dt;
-}
-
-float CalculateAccel(TrackingSystem *ts, int index, bool isX) {
-
-    if (index <= ts->startFrame || index >= ts->count - 1) return 0.0f;
-
-    float vPrev = CalculateVelocity(ts, index - 1, isX);
-    float vNext = CalculateVelocity(ts, index + 1, isX);
-    float dt = ts->points[index + 1].time - ts->points[index - 1].time;
-
-    if (fabs(dt) < 1e-6) return 0.0f;
-    return (vNext - vPrev) / dt;
-}
-
-typedef enum { REG_LINEAR, REG_QUADRATIC } RegressionType;
-typedef struct { RegressionType type; double a, b, c, rSquared; } RegressionResult;
+#include "file_utils.h"
 
 float GetModelY(RegressionResult reg, float x) {
     if (reg.type == REG_LINEAR) return (float)(reg.a * x + reg.b);
     else return (float)(reg.a * x * x + reg.b * x + reg.c);
 }
 
-double CalculateRSquared(float* x, float* y, int count, RegressionResult reg) {
-    double meanY = 0; 
-    for(int i=0; i<count; i++) meanY += y[i]; 
-    meanY /= count;
-    
-    double ssTot = 0, ssRes = 0;
-    for(int i=0; i<count; i++) {
-        double f = GetModelY(reg, x[i]);
-        ssTot += (y[i] - meanY)*(y[i] - meanY); 
-        ssRes += (y[i] - f)*(y[i] - f);
-    }
-
-    if (ssTot < 1e-9) return 1.0; 
-    return 1.0 - (ssRes / ssTot);
-}
-
-RegressionResult CalcLinearReg(float* x, float* y, int count) {
-    double sX=0, sY=0, sXY=0, sXX=0;
-    for (int i=0; i<count; i++) { sX+=x[i]; sY+=y[i]; sXY+=x[i]*y[i]; sXX+=x[i]*x[i]; }
-    
-    double denom = count*sXX - sX*sX;
-    
-    if (fabs(denom) < 1e-9) return (RegressionResult){ REG_LINEAR, 0, 0, 0, 0 };
-
-    double slope = (count*sXY - sX*sY) / denom;
-    double intercept = (sY - slope*sX) / count;
-    
-    RegressionResult res = { REG_LINEAR, slope, intercept, 0, 0 };
-    res.rSquared = CalculateRSquared(x, y, count, res);
-    return res;
-}
-
-RegressionResult CalcQuadraticReg(float* x, float* y, int count) {
-    double sX=0, sX2=0, sX3=0, sX4=0, sY=0, sXY=0, sX2Y=0;
-    for (int i=0; i<count; i++) {
-        double xi=x[i], yi=y[i], xi2=xi*xi;
-        sX+=xi; sX2+=xi2; sX3+=xi2*xi; sX4+=xi2*xi2; sY+=yi; sXY+=xi*yi; sX2Y+=xi2*yi;
-    }
-    double n=(double)count;
-    double D = n*(sX2*sX4 - sX3*sX3) - sX*(sX*sX4 - sX3*sX2) + sX2*(sX*sX3 - sX2*sX2);
-    
-    if (fabs(D)<1e-9) return (RegressionResult){ REG_QUADRATIC, 0,0,0,0 };
-    
-    double Da = n*(sX2*sX2Y - sXY*sX3) - sX*(sX*sX2Y - sXY*sX2) + sY*(sX*sX3 - sX2*sX2);
-    double Db = n*(sXY*sX4 - sX3*sX2Y) - sY*(sX*sX4 - sX3*sX2) + sX2*(sX*sX2Y - sXY*sX2);
-    double Dc = sY*(sX2*sX4 - sX3*sX3) - sX*(sXY*sX4 - sX3*sX2Y) + sX2*(sXY*sX3 - sX2*sX2Y);
-    
-    RegressionResult res = { REG_QUADRATIC, Da/D, Db/D, Dc/D, 0 };
-    res.rSquared = CalculateRSquared(x, y, count, res);
-    return res;
+// Courbe affichée : ajustement du thread de travail s'il y en a un, sinon droite/parabole.
+static float GetCurveY(RegressionResult reg, const FitResult *fit, float x) {
+    return fit ? (float)Fit_Eval(fit, x) : GetModelY(reg, x);
 }
 
-
-RegressionResult CalcBestFit(float* x, float* y, int count, GraphMode mode) {
-    RegressionResult lin = CalcLinearReg(x, y, count);
+RegressionResult CalcBestFit(const RegressionStats *stats, GraphMode mode) {
+    RegressionResult lin = Regression_Linear(stats);
     
     if (lin.rSquared < 0.15) return lin; 
 
     if (lin.rSquared > 0.98) return lin;
 
-    RegressionResult quad = CalcQuadraticReg(x, y, count);
+    RegressionResult quad = Regression_Quadratic(stats);
     
     float threshold = 0.02f;
 
@@ -123,188 +47,369 @@ RegressionResult CalcBestFit(float* x, float* y, int count, GraphMode mode) {
 void InitGraphSystem(GraphState *state) {
     int sw = GetScreenWidth(); int sh = GetScreenHeight();
     state->bounds = (Rectangle){ (float)sw/2 - 400, (float)sh/2 - 280, 800, 560 };
-    state->mode = GRAPH_Y_X; 
     state->isDragging = false;
     state->requestExport = false;
+    int fontSize = 0;
+    const unsigned char *fontData = GetAppFontData(&fontSize);
+    state->exporter = GraphExport_Create(fontData, fontSize);
+    state->exportFormat = GRAPH_EXPORT_PNG;
+    state->exportStatus = GRAPH_EXPORT_IDLE;
+    state->exportStatusTime = 0.0;
     state->showRegression = true;
     state->showFill = true; 
+    state->kinematics = Kinematics_Create();
+    state->derived = NULL;
+    state->fitModel = FIT_AUTO;
+    state->fitDegree = 3;
+    state->bootstrap = BOOT_OFF;
+    state->frame = 0;
+    for (int m = 0; m < GRAPH_MODE_COUNT; m++) {
+        GraphSeries *s = &state->series[m];
+        *s = (GraphSeries){ 0 };
+        s->valX = (float *)malloc(MAX_POINTS * sizeof(float));
+        s->valY = (float *)malloc(MAX_POINTS * sizeof(float));
+    }
+    state->drawIndices = (int *)malloc(GRAPH_MAX_DRAW_INDICES * sizeof(int));
+    for (int i = 0; i < GRAPH_MAX_PANELS; i++) {
+        GraphPanel *p = &state->panels[i];
+        *p = (GraphPanel){ 0 };
+        p->mode = (i == 0) ? GRAPH_Y_X : (GraphMode)(GRAPH_X_T + 2 * (i - 1));
+        p->viewMode = p->mode;
+    }
+    state->panelCount = 1;
+    state->activePanel = 0;
+    state->cursorIdx = state->nextCursorIdx = -1;
+    GraphGpu_Init();
 }
 
-void DrawGraphContent(Rectangle bodyRect, GraphState *state, TrackingSystem *ts, UIState *ui) {
-    Color graphBgColor = (Color){25, 25, 25, 255}; 
-
-    rlDisableColorBlend();
-    DrawRectangleRec(bodyRect, graphBgColor);
-    rlEnableColorBlend();
-
-    if (ts->count < 5) return;
-
-    float minX = FLT_MAX, maxX = -FLT_MAX;
-    float minY = FLT_MAX, maxY = -FLT_MAX;
-    #define MAX_DRAW_POINTS 4096
-    float valX[MAX_DRAW_POINTS]; float valY[MAX_DRAW_POINTS];
-    float regX[MAX_DRAW_POINTS]; float regY[MAX_DRAW_POINTS];
-
-    int effectiveStart = ts->startFrame; 
-    int count = (ts->count < MAX_DRAW_POINTS) ? ts->count : MAX_DRAW_POINTS;
-
-    int startI = effectiveStart;
-    int endI = count;
+void UnloadGraphSystem(GraphState *state) {
+    GraphExport_Destroy(state->exporter);
+    state->exporter = NULL;
+    Kinematics_Destroy(state->kinematics);
+    state->kinematics = NULL;
+    for (int m = 0; m < GRAPH_MODE_COUNT; m++) {
+        GraphSeries *s = &state->series[m];
+        GraphLod_Free(&s->lod);
+        free(s->valX);
+        free(s->valY);
+        *s = (GraphSeries){ 0 };
+    }
+    free(state->drawIndices);
+    state->drawIndices = NULL;
+    for (int i = 0; i < GRAPH_MAX_PANELS; i++) {
+        GraphPanel *p = &state->panels[i];
+        GraphPick_Free(&p->pick);
+        if (p->fitter) FitEngine_Destroy(p->fitter);
+        p->fitter = NULL;
+        RegressionTracker_Free(&p->regression);
+        GraphGeometry_Unload(&p->fillGeometry);
+        GraphGeometry_Unload(&p->curveGeometry);
+        GraphMarkers_Unload(&p->markers);
+        if (p->layer.id != 0) UnloadRenderTexture(p->layer);
+        p->layer = (RenderTexture2D){ 0 };
+    }
+    GraphGpu_Shutdown();
+}
 
-    if (state->mode == GRAPH_VX_T || state->mode == GRAPH_VY_T) {
-            startI = effectiveStart + 1; 
-            endI = count - 1;
-        } else if (state->mode == GRAPH_AX_T || state->mode == GRAPH_AY_T) {
-            startI = effectiveStart + 2; 
-            endI = count - 2;
-        }
+// Colonnes d'un mode pour l'image courante : le premier panneau qui les demande
+// les calcule, les suivants les relisent. NULL si la série est trop courte.
+// Quand la série n'a fait que s'allonger, seule la fin est recalculée.
+static GraphSeries* GraphSeries_Get(GraphState *state, GraphMode mode, TrackingSystem *ts) {
+    GraphSeries *s = &state->series[mode];
+    if (s->frame == state->frame) return s->ready ? s : NULL;
+    s->frame = state->frame;
+    s->ready = false;
+    if (!s->valX || !s->valY) return NULL;
+
+    Kinematics *kin = state->kinematics;
+    int startI = ts->startFrame;
+    int endI = ts->count;
+
+    // Les noyaux ont des lignes dédiées aux bords : toute la série est dérivable,
+    // dès qu'elle a KINEMATICS_MIN_SPAN points. Les grandeurs utilisateur
+    // peuvent lire les dérivées et suivent la même règle.
+    bool isDerivative = (mode >= GRAPH_VX_T);
+    bool isUser = (mode >= GRAPH_USER);
+    const float *userValues = NULL;
+    if (isUser) {
+        DerivedSet *derived = state->derived;
+        userValues = derived ? Derived_Values(derived, mode - GRAPH_USER) : NULL;
+        if (userValues && (derived->first != startI || derived->end != endI)) userValues = NULL;
+    }
+    if ((isDerivative && endI - startI < KINEMATICS_MIN_SPAN) || startI >= endI || (isUser && !userValues)) {
+        s->synced = false;
+        return NULL;
+    }
 
-    if (startI >= endI) return;
+    bool incremental = s->synced && s->seenEdit == ts->editRevision && s->start == startI && s->end <= endI;
+    int from = incremental ? s->end : startI;
+    if (incremental && isDerivative) {
+        // Un ajout modifie aussi les dérivées des dernières images (fenêtre décalée).
+        int kinFrom;
+        bool known = isUser ? Derived_ChangedSince(state->derived, s->kinVersion, &kinFrom)
+                            : Kinematics_ChangedSince(kin, s->kinVersion, &kinFrom);
+        if (!known) incremental = false;
+        else if (kinFrom < from) from = kinFrom;
+        if (!incremental || from < startI) from = startI;
+    }
+    bool appendOnly = incremental && from == s->end;
 
-    int validCount = 0;
-    for (int i = startI; i < endI; i++) {
-        Vector2 phys = PixelToPhysical(ts, ts->points[i].pixelPos);
+    float *valX = s->valX; float *valY = s->valY;
+    bool sortedX = incremental ? s->sortedX : true;
+    float minX = appendOnly ? s->rawMinX : FLT_MAX, maxX = appendOnly ? s->rawMaxX : -FLT_MAX;
+    for (int i = from; i < endI; i++) {
+        Vector2 phys = { ts->physX[i], ts->physY[i] };
         float t = ts->points[i].time;
-        switch (state->mode) {
+        switch (mode) {
             case GRAPH_Y_X: valX[i]=phys.x; valY[i]=phys.y; break;
             case GRAPH_X_T: valX[i]=t; valY[i]=phys.x; break;
             case GRAPH_Y_T: valX[i]=t; valY[i]=phys.y; break;
-            case GRAPH_VX_T: valX[i]=t; valY[i]=CalculateVelocity(ts, i, true); break;
-            case GRAPH_VY_T: valX[i]=t; valY[i]=CalculateVelocity(ts, i, false); break;
-            case GRAPH_AX_T: valX[i]=t; valY[i]=CalculateAccel(ts, i, true); break;
-            case GRAPH_AY_T: valX[i]=t; valY[i]=CalculateAccel(ts, i, false); break;
-            default: valX[i]=0; valY[i]=0;
+            case GRAPH_VX_T: valX[i]=t; valY[i]=Kinematics_Velocity(kin, i, true); break;
+            case GRAPH_VY_T: valX[i]=t; valY[i]=Kinematics_Velocity(kin, i, false); break;
+            case GRAPH_AX_T: valX[i]=t; valY[i]=Kinematics_Accel(kin, i, true); break;
+            case GRAPH_AY_T: valX[i]=t; valY[i]=Kinematics_Accel(kin, i, false); break;
+            default:
+                // Division par zéro, racine d'un négatif... : ramené à 0 pour garder des axes finis.
+                valX[i]=t; valY[i]=isfinite(userValues[i]) ? userValues[i] : 0.0f;
         }
-        regX[validCount] = valX[i]; 
-        regY[validCount] = valY[i]; 
-        validCount++;
-
+        if (i > startI && valX[i] < valX[i - 1]) sortedX = false;
         if (valX[i] < minX) minX = valX[i]; if (valX[i] > maxX) maxX = valX[i];
-        if (valY[i] < minY) minY = valY[i]; if (valY[i] > maxY) maxY = valY[i];
     }
-
-    float rangeX = maxX - minX; if(fabs(rangeX) < 1e-4) rangeX = 1.0f;
-    float rangeY = maxY - minY; if(fabs(rangeY) < 1e-4) rangeY = 1.0f;
-    
-    if (IsKeyPressed(KEY_D)) {
-        int totalCount = ts->count;
-            printf("\n--- DEBUG DATA DANS DRAW_GRAPH_CONTENT (Count: %d) ---\n", totalCount);
-            printf("Idx | Time  | PosY  | VelY  | AccY  |\n");
-            for(int i=0; i<totalCount; i++) {
-                float t = ts->points[i].time;
-                Vector2 p = PixelToPhysical(ts, ts->points[i].pixelPos);
-                float vy = CalculateVelocity(ts, i, false);
-                float ay = CalculateAccel(ts, i, false);
-                char used = (i >= startI && i < endI) ? '*' : ' ';
-                printf("%02d%c | %.3f | %.3f | %.3f | %.3f |\n", i, used, t, p.y, vy, ay);
+    // Points remplacés (dérivées de fin de série) : les bornes en x se relisent
+    // aux extrémités d'une série croissante, sinon on reparcourt tout.
+    if (incremental && !appendOnly) {
+        if (sortedX) { minX = valX[startI]; maxX = valX[endI - 1]; }
+        else {
+            for (int i = startI; i < from; i++) {
+                if (valX[i] < minX) minX = valX[i]; if (valX[i] > maxX) maxX = valX[i];
             }
-            printf("------------------------------------------\n");
         }
+    }
 
+    // Indices relatifs à startI dans la pyramide ; sa version sert de version à la série.
+    unsigned int oldVersion = s->lod.version;
+    if (incremental) GraphLod_Update(&s->lod, valX + startI, valY + startI, endI - startI, from - startI);
+    else GraphLod_Sync(&s->lod, valX + startI, valY + startI, endI - startI);
+    if (s->lod.version != oldVersion) s->changedFrom = incremental ? from - startI : 0;
 
-    minX -= rangeX * 0.05f; maxX += rangeX * 0.05f;
-    minY -= rangeY * 0.1f;  maxY += rangeY * 0.1f;
+    // Extrêmes en y lus au sommet de la pyramide.
+    int iMin, iMax;
+    GraphLod_Range(&s->lod, 0, endI - startI, &iMin, &iMax);
+    float minY = valY[startI + iMin], maxY = valY[startI + iMax];
 
-    RegressionResult reg;
-    if (state->showRegression && validCount > 1) reg = CalcBestFit(regX, regY, validCount, state->mode);
+    s->rawMinX = minX; s->rawMaxX = maxX;
+    s->seenEdit = ts->editRevision;
+    s->kinVersion = isUser ? Derived_Version(state->derived) : Kinematics_Version(kin);
+    s->synced = true;
 
+    float rangeX = maxX - minX; if(fabs(rangeX) < 1e-4) rangeX = 1.0f;
+    float rangeY = maxY - minY; if(fabs(rangeY) < 1e-4) rangeY = 1.0f;
+    s->minX = minX - rangeX * 0.05f; s->maxX = maxX + rangeX * 0.05f;
+    s->minY = minY - rangeY * 0.1f;  s->maxY = maxY + rangeY * 0.1f;
+    s->start = startI;
+    s->end = endI;
+    s->sortedX = sortedX;
+    s->ready = true;
+    return s;
+}
+
+// Premier indice (absolu) qui a pu changer depuis que le lecteur a vu 'version'.
+static int GraphSeries_ChangedSince(const GraphSeries *s, unsigned int version) {
+    if (version == s->lod.version) return s->end;
+    if (version + 1 == s->lod.version) return s->start + s->changedFrom;
+    return s->start;
+}
+
+static void GraphSetView(GraphPanel *panel, float minX, float maxX, float minY, float maxY, bool autoY) {
+    if (!(maxX - minX > 1e-6f) || !(maxY - minY > 1e-6f)) return;
+    panel->viewMinX = minX; panel->viewMaxX = maxX;
+    panel->viewMinY = minY; panel->viewMaxY = maxY;
+    panel->viewAutoY = autoY;
+    panel->zoomed = true;
+}
+
+// Molette : zoom autour du curseur. Glisser (gauche) : déplacement. Glisser (droit) :
+// zoom sur le cadre tracé ; un simple clic droit revient à l'ajustement automatique.
+// En mode temporel, l'axe y suit la fenêtre visible tant qu'aucun cadre ne l'a fixé.
+static void GraphHandleView(GraphPanel *panel, bool windowDragging, Rectangle bodyRect, float minX, float maxX, float minY, float maxY) {
     Vector2 mouse = GetMousePosition();
-    int hoverIdx = -1;
-    if (CheckCollisionPointRec(mouse, bodyRect)) {
-        float closestDistX = FLT_MAX;
-        for (int i = startI; i < endI; i++) {
-            float nx = (valX[i] - minX) / (maxX - minX);
-            float screenX = bodyRect.x + nx * bodyRect.width;
-            float dist = fabs(mouse.x - screenX);
-            if (dist < closestDistX) { closestDistX = dist; hoverIdx = i; }
-        }
-        if (closestDistX > 50.0f) hoverIdx = -1;
+    bool inside = CheckCollisionPointRec(mouse, bodyRect);
+    bool autoY = panel->zoomed ? panel->viewAutoY : (panel->mode != GRAPH_Y_X);
+    if (panel->zoomed) {
+        minX = panel->viewMinX; maxX = panel->viewMaxX;
+        if (!panel->viewAutoY) { minY = panel->viewMinY; maxY = panel->viewMaxY; }
+    }
+    float unitX = (maxX - minX) / bodyRect.width, unitY = (maxY - minY) / bodyRect.height;
+    float mouseX = minX + (mouse.x - bodyRect.x) * unitX;
+    float mouseY = maxY - (mouse.y - bodyRect.y) * unitY;
+
+    float wheel = GetMouseWheelMove();
+    if (inside && wheel != 0.0f && !panel->isPanning && !panel->isBoxZooming) {
+        float k = powf(0.8f, wheel);
+        float ky = autoY ? 1.0f : k;
+        GraphSetView(panel, mouseX - (mouseX - minX) * k, mouseX + (maxX - mouseX) * k,
+                     mouseY - (mouseY - minY) * ky, mouseY + (maxY - mouseY) * ky, autoY);
     }
 
-    rlSetBlendMode(RL_BLEND_ALPHA);
-    rlBegin(RL_LINES); rlColor4ub(60, 60, 60, 255);
-    int gridDivs = 6;
-    for (int i = 0; i <= gridDivs; i++) {
-        float r = (float)i / gridDivs;
-        float gx = bodyRect.x + r * bodyRect.width;
-        float gy = bodyRect.y + bodyRect.height - (r * bodyRect.height);
-        rlVertex2f(gx, bodyRect.y); rlVertex2f(gx, bodyRect.y + bodyRect.height);
-        rlVertex2f(bodyRect.x, gy); rlVertex2f(bodyRect.x + bodyRect.width, gy);
+    if (inside && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !windowDragging) {
+        panel->isPanning = true;
+        panel->panLast = mouse;
+    }
+    if (panel->isPanning) {
+        if (!IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+            panel->isPanning = false;
+        } else if (mouse.x != panel->panLast.x || mouse.y != panel->panLast.y) {
+            float dx = (mouse.x - panel->panLast.x) * unitX, dy = (mouse.y - panel->panLast.y) * unitY;
+            if (autoY) dy = 0.0f;
+            GraphSetView(panel, minX - dx, maxX - dx, minY + dy, maxY + dy, autoY);
+            panel->panLast = mouse;
+        }
     }
-    rlEnd();
 
-    for (int i = 0; i <= gridDivs; i += 2) {
-        float r = (float)i / gridDivs;
-        char lblX[32], lblY[32];
-        sprintf(lblX, "%.2f", minX + r * (maxX - minX));
-        sprintf(lblY, "%.2f", minY + r * (maxY - minY));
-        DrawTextEx(ui->appFont, lblX, (Vector2){bodyRect.x + r * bodyRect.width + 2, bodyRect.y + bodyRect.height - 15}, 10, 1.0f, GRAY);
-        DrawTextEx(ui->appFont, lblY, (Vector2){bodyRect.x + 5, bodyRect.y + bodyRect.height - (r * bodyRect.height) - 12}, 10, 1.0f, GRAY);
+    if (inside && IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
+        panel->isBoxZooming = true;
+        panel->boxStart = mouse;
     }
+    if (panel->isBoxZooming && !IsMouseButtonDown(MOUSE_RIGHT_BUTTON)) {
+        panel->isBoxZooming = false;
+        Vector2 a = panel->boxStart, b = mouse;
+        if (fabsf(b.x - a.x) > 5.0f && fabsf(b.y - a.y) > 5.0f) {
+            float x0 = minX + (fminf(a.x, b.x) - bodyRect.x) * unitX, x1 = minX + (fmaxf(a.x, b.x) - bodyRect.x) * unitX;
+            float y0 = maxY - (fmaxf(a.y, b.y) - bodyRect.y) * unitY, y1 = maxY - (fminf(a.y, b.y) - bodyRect.y) * unitY;
+            GraphSetView(panel, x0, x1, y0, y1, false);
+        } else {
+            panel->zoomed = false;
+        }
+    }
+}
 
-    Color mainColor = COLOR_ACCENT; 
-    if (state->mode == GRAPH_Y_T || state->mode == GRAPH_VY_T) mainColor = (Color){255, 80, 150, 255};
-    if (state->mode == GRAPH_X_T || state->mode == GRAPH_VX_T) mainColor = (Color){0, 220, 100, 255};
+static Color GraphModeColor(GraphMode mode) {
+    if (mode == GRAPH_Y_T || mode == GRAPH_VY_T) return (Color){255, 80, 150, 255};
+    if (mode == GRAPH_X_T || mode == GRAPH_VX_T) return (Color){0, 220, 100, 255};
+    if (mode >= GRAPH_USER) return (Color){255, 180, 60, 255};
+    return COLOR_ACCENT;
+}
 
-    BeginScissorMode((int)bodyRect.x, (int)bodyRect.y, (int)bodyRect.width, (int)bodyRect.height);
+static const char* graphModeLabels[GRAPH_USER] = { "y(x)", "x(t)", "y(t)", "Vx(t)", "Vy(t)", "Ax(t)", "Ay(t)" };
 
-    if (state->showRegression && validCount > 1) {
-        Color fadeTop = mainColor; fadeTop.a = 150; 
-        Color fadeBot = mainColor; fadeBot.a = 0;
-        int steps = 200; float stepX = (maxX - minX) / steps; Vector2 prevP = {0};
+static const char* GraphModeLabel(const GraphState *state, GraphMode mode) {
+    if (mode < GRAPH_USER) return graphModeLabels[mode];
+    int j = mode - GRAPH_USER;
+    if (state->derived && j < state->derived->count) return TextFormat("%s(t)", state->derived->columns[j].name);
+    return "?";
+}
 
-        if (state->showFill) {
-            rlDrawRenderBatchActive(); rlColorMask(true, true, true, false); 
-            rlBegin(RL_TRIANGLES);
-            for (int i = 0; i < steps; i++) {
-                float xCur = minX + i * stepX; float xNxt = minX + (i + 1) * stepX;
-                float yCur = GetModelY(reg, xCur); float yNxt = GetModelY(reg, xNxt);
-                float nx1 = (xCur - minX)/(maxX - minX); float ny1 = (yCur - minY)/(maxY - minY);
-                float nx2 = (xNxt - minX)/(maxX - minX); float ny2 = (yNxt - minY)/(maxY - minY);
-                float sx1 = bodyRect.x + nx1 * bodyRect.width;
-                float sy1 = bodyRect.y + bodyRect.height - (ny1 * bodyRect.height);
-                float sx2 = bodyRect.x + nx2 * bodyRect.width;
-                float sy2 = bodyRect.y + bodyRect.height - (ny2 * bodyRect.height);
-                float base = bodyRect.y + bodyRect.height;
-
-                rlColor4ub(fadeTop.r, fadeTop.g, fadeTop.b, fadeTop.a); rlVertex2f(sx1, sy1);
-                rlColor4ub(fadeBot.r, fadeBot.g, fadeBot.b, fadeBot.a); rlVertex2f(sx1, base);
-                rlColor4ub(fadeTop.r, fadeTop.g, fadeTop.b, fadeTop.a); rlVertex2f(sx2, sy2);
-                rlColor4ub(fadeBot.r, fadeBot.g, fadeBot.b, fadeBot.a); rlVertex2f(sx1, base);
-                rlColor4ub(fadeBot.r, fadeBot.g, fadeBot.b, fadeBot.a); rlVertex2f(sx2, base);
-                rlColor4ub(fadeTop.r, fadeTop.g, fadeTop.b, fadeTop.a); rlVertex2f(sx2, sy2);
-            }
-            rlEnd();
-            rlDrawRenderBatchActive(); rlColorMask(true, true, true, true); 
-        }
+// Un résultat n'est repris que pour le même mode et le même début de plage ; calculé
+// avant des ajouts en fin de plage, il reste affiché le temps du nouveau calcul.
+static bool GraphFitMatches(FitKey key, GraphMode mode, int begin, int end) {
+    return key.series == (int)mode && key.begin == begin && key.end <= end;
+}
 
-        for (int i = 0; i <= steps; i++) {
-            float xVal = minX + i * stepX; float yVal = GetModelY(reg, xVal);
-            float nx = (xVal - minX) / (maxX - minX); float ny = (yVal - minY) / (maxY - minY);
-            Vector2 p = { bodyRect.x + nx * bodyRect.width, bodyRect.y + bodyRect.height - (ny * bodyRect.height) };
-            if (i > 0) DrawLineEx(prevP, p, 2.5f, mainColor);
-            prevP = p;
+void DrawGraphContent(Rectangle bodyRect, GraphState *state, GraphPanel *panel, TrackingSystem *ts, UIState *ui) {
+    Color graphBgColor = (Color){25, 25, 25, 255}; 
+
+    rlDisableColorBlend();
+    DrawRectangleRec(bodyRect, graphBgColor);
+    rlEnableColorBlend();
+
+    if (ts->count < 5) return;
+    GraphSeries *series = GraphSeries_Get(state, panel->mode, ts);
+    if (!series || !state->drawIndices) return;
+
+    float *valX = series->valX; float *valY = series->valY;
+    int startI = series->start, endI = series->end;
+    bool sortedX = series->sortedX;
+    float minX = series->minX, maxX = series->maxX;
+    float minY = series->minY, maxY = series->maxY;
+
+    // Zoom / déplacement : les axes de la vue remplacent l'ajustement automatique.
+    if (panel->viewMode != panel->mode) { panel->zoomed = false; panel->viewMode = panel->mode; }
+    GraphHandleView(panel, state->isDragging, bodyRect, minX, maxX, minY, maxY);
+    if (panel->zoomed) { minX = panel->viewMinX; maxX = panel->viewMaxX; }
+
+    // En mode temporel, la fenêtre visible est une plage d'indices contiguë : les
+    // extrêmes en y se lisent dans la pyramide en O(log n).
+    int visBegin = startI, visEnd = endI;
+    if (panel->zoomed && sortedX) {
+        visBegin = startI + GraphLod_LowerBound(&series->lod, minX);
+        visEnd = startI + GraphLod_LowerBound(&series->lod, maxX);
+        if (visBegin > startI) visBegin--;
+        if (visEnd < endI) visEnd++;
+    }
+    if (panel->zoomed && !panel->viewAutoY) {
+        minY = panel->viewMinY; maxY = panel->viewMaxY;
+    } else if (panel->zoomed) {
+        int iMin, iMax;
+        if (sortedX && GraphLod_Range(&series->lod, visBegin - startI, visEnd - startI, &iMin, &iMax)) {
+            float lo = valY[startI + iMin], hi = valY[startI + iMax];
+            float span = hi - lo; if (fabsf(span) < 1e-4f) span = 1.0f;
+            minY = lo - span * 0.1f; maxY = hi + span * 0.1f;
         }
     }
-
-    for (int i = startI; i < endI; i++) {
-        float nx = (valX[i] - minX) / (maxX - minX);
-        float ny = (valY[i] - minY) / (maxY - minY);
-        Vector2 p = { bodyRect.x + nx * bodyRect.width, bodyRect.y + bodyRect.height - (ny * bodyRect.height) };
-        
-        if (i == hoverIdx) {
-            DrawCircleV(p, 6.0f, WHITE); 
-            DrawCircleLines((int)p.x, (int)p.y, 10.0f, mainColor);
-        } else {
-            DrawCircleV(p, 3.0f, (Color){200, 200, 200, 150}); 
+    int visibleCount = visEnd - visBegin;
+
+    RegressionResult reg = { 0 };
+    FitResult fit;
+    const FitResult *engineFit = NULL;
+    const FitResult *curveFit = NULL;
+    bool fitPending = false;
+    if (state->showRegression && visibleCount > 1) {
+        FitModel engineModel = state->fitModel;
+        int engineDegree = state->fitDegree;
+        if (state->fitModel == FIT_AUTO) {
+            // Seuls les points modifiés depuis l'image précédente touchent les sommes.
+            int changed = GraphSeries_ChangedSince(series, panel->regressionVersion);
+            RegressionTracker_SyncFrom(&panel->regression, (int)panel->mode, valX, valY, visBegin, visEnd, changed);
+            panel->regressionVersion = series->lod.version;
+            reg = CalcBestFit(&panel->regression.stats, panel->mode);
+            // Les intervalles de confiance passent par le polynôme équivalent.
+            engineModel = FIT_POLYNOMIAL;
+            engineDegree = (reg.type == REG_LINEAR) ? 1 : 2;
         }
+        if (state->fitModel != FIT_AUTO || state->bootstrap != BOOT_OFF) {
+            if (!panel->fitter) panel->fitter = FitEngine_Create();
+            if (panel->fitter) {
+                if (!panel->fitSubmitted || panel->fitVersion != series->lod.version || panel->fitBegin != visBegin || panel->fitEnd != visEnd ||
+                    panel->fitModel != engineModel || panel->fitDegree != engineDegree || panel->fitBoot != state->bootstrap) {
+                    FitEngine_Submit(panel->fitter, engineModel, engineDegree, state->bootstrap, (FitKey){ (int)panel->mode, visBegin, visEnd },
+                                     valX + visBegin, valY + visBegin, visibleCount);
+                    panel->fitSubmitted = true;
+                    panel->fitVersion = series->lod.version;
+                    panel->fitBegin = visBegin; panel->fitEnd = visEnd;
+                    panel->fitModel = engineModel; panel->fitDegree = engineDegree; panel->fitBoot = state->bootstrap;
+                }
+                if (FitEngine_Result(panel->fitter, &fit) && fit.valid && GraphFitMatches(fit.key, panel->mode, visBegin, visEnd) && fit.model == engineModel &&
+                    (fit.model != FIT_POLYNOMIAL || fit.degree == engineDegree)) {
+                    engineFit = &fit;
+                }
+                fitPending = FitEngine_IsBusy(panel->fitter);
+            }
+        }
+        if (state->fitModel != FIT_AUTO) curveFit = engineFit;
     }
-    EndScissorMode(); 
-
-
-    if (state->showRegression && validCount > 1) {
-        static char eqBuffer[128]; 
-        if (isnan(reg.a) || isnan(reg.b) || isnan(reg.rSquared)) {
+    bool drawCurve = state->showRegression && visibleCount > 1 && (state->fitModel == FIT_AUTO || curveFit);
+
+    Color mainColor = GraphModeColor(panel->mode);
+
+    // Texte de l'ajustement, calculé avant le rendu pour savoir si le calque a changé.
+    char eqBuffer[512] = "";
+    int fontSize = 20; 
+    bool showEquation = state->showRegression && visibleCount > 1;
+    if (showEquation) {
+        if (state->fitModel != FIT_AUTO) {
+            fontSize = 15;
+            if (!curveFit) {
+                snprintf(eqBuffer, sizeof(eqBuffer), "%s", fitPending ? L(T_FIT_PENDING) : L(T_FIT_NA));
+            } else {
+                const char *formulas[FIT_MODEL_COUNT] = { "", "", "y = A e^(-gamma t) cos(omega t + phi) + c", "y = A e^(-t/tau) + c", "y = y0 + vt t + (v0 - vt)(1 - e^(-k t))/k" };
+                int len = (fit.model == FIT_POLYNOMIAL)
+                    ? snprintf(eqBuffer, sizeof(eqBuffer), "Fit: y = sum a_k x^k (R²: %.4f)", fit.rSquared)
+                    : snprintf(eqBuffer, sizeof(eqBuffer), "Fit: %s (R²: %.4f)", formulas[fit.model], fit.rSquared);
+                for (int k = 0; k < fit.paramCount && len < (int)sizeof(eqBuffer); k++) {
+                    len += snprintf(eqBuffer + len, sizeof(eqBuffer) - len, "\n%s = %.5g ± %.2g", Fit_ParamName(fit.model, k), fit.params[k], fit.sigma[k]);
+                }
+            }
+        } else if (isnan(reg.a) || isnan(reg.b) || isnan(reg.rSquared)) {
              sprintf(eqBuffer, L(T_FIT_NA));
         } else if (reg.type == REG_LINEAR) {
             char signB = (reg.b >= 0) ? '+' : '-';
@@ -315,15 +420,246 @@ void DrawGraphContent(Rectangle bodyRect, GraphState *state, TrackingSystem *ts,
             sprintf(eqBuffer, "Fit: %.3f x² %c %.3f x %c %.3f (R²: %.2f)", reg.a, signB, fabsf(reg.b), signC, fabsf(reg.c), reg.rSquared);
         }
 
-        int fontSize = 20; 
-        Vector2 txtSz = MeasureTextEx(ui->appFont, eqBuffer, fontSize, 1.0f);
-        rlDrawRenderBatchActive(); rlColorMask(true, true, true, false); 
-        DrawRectangle(bodyRect.x + bodyRect.width - txtSz.x - 10, bodyRect.y + 5, txtSz.x + 10, txtSz.y + 6, graphBgColor);
-        rlDrawRenderBatchActive(); rlColorMask(true, true, true, true);
-        DrawTextEx(ui->appFont, eqBuffer, (Vector2){bodyRect.x + bodyRect.width - txtSz.x - 5, bodyRect.y + 7}, fontSize, 1.0f, mainColor);
+        if (state->bootstrap != BOOT_OFF) {
+            fontSize = 15;
+            int len = (int)strlen(eqBuffer);
+            if (engineFit && engineFit->interval.valid) {
+                const FitInterval *iv = &engineFit->interval;
+                for (int k = 0; k < engineFit->paramCount && len < (int)sizeof(eqBuffer); k++) {
+                    len += snprintf(eqBuffer + len, sizeof(eqBuffer) - len, "\n%s IC95 : [%.5g ; %.5g]", Fit_ParamName(engineFit->model, k), iv->lo[k], iv->hi[k]);
+                }
+            } else if (fitPending && len < (int)sizeof(eqBuffer)) {
+                snprintf(eqBuffer + len, sizeof(eqBuffer) - len, "\n%s", L(T_BOOT_PENDING));
+            }
+        }
+
+    }
+
+    // Calque statique (grille, libellés, courbe, points, équation) rendu dans une
+    // texture et recomposé tel quel tant que rien n'a changé.
+    int layerW = (int)bodyRect.width, layerH = (int)bodyRect.height;
+    if (layerW < 1) layerW = 1;
+    if (layerH < 1) layerH = 1;
+    if (panel->layer.id == 0 || panel->layer.texture.width != layerW || panel->layer.texture.height != layerH) {
+        if (panel->layer.id != 0) UnloadRenderTexture(panel->layer);
+        panel->layer = LoadRenderTexture(layerW, layerH);
+        panel->layerValid = false;
+    }
+    bool layerDirty = !panel->layerValid || panel->layerShowFill != state->showFill || strcmp(panel->layerText, eqBuffer) != 0;
+
+    if (drawCurve) {
+        // Courbe en coordonnées locales au tracé : les tampons GPU ne sont
+        // reconstruits que si elle a bougé (données, axes, taille, couleur).
+        Vector2 curve[GRAPH_CURVE_STEPS + 1];
+        float stepX = (maxX - minX) / GRAPH_CURVE_STEPS;
+        for (int i = 0; i <= GRAPH_CURVE_STEPS; i++) {
+            float xVal = minX + i * stepX; float yVal = GetCurveY(reg, curveFit, xVal);
+            float nx = (xVal - minX) / (maxX - minX); float ny = (yVal - minY) / (maxY - minY);
+            curve[i] = (Vector2){ nx * bodyRect.width, bodyRect.height - (ny * bodyRect.height) };
+        }
+        bool curveChanged = !panel->curveCacheValid || panel->curveFill != state->showFill || memcmp(&panel->curveColor, &mainColor, sizeof(Color)) != 0 ||
+                            panel->curveHeight != bodyRect.height || memcmp(panel->curveCache, curve, sizeof(curve)) != 0;
+        if (curveChanged) {
+            memcpy(panel->curveCache, curve, sizeof(curve));
+            panel->curveColor = mainColor;
+            panel->curveFill = state->showFill;
+            panel->curveHeight = bodyRect.height;
+            panel->curveCacheValid = true;
+
+            Color fadeTop = mainColor; fadeTop.a = 150; 
+            Color fadeBot = mainColor; fadeBot.a = 0;
+            GraphGeometry_Clear(&panel->fillGeometry);
+            if (state->showFill) {
+                for (int i = 0; i < GRAPH_CURVE_STEPS; i++) {
+                    Vector2 p1 = curve[i], p2 = curve[i + 1];
+                    Vector2 b1 = { p1.x, bodyRect.height }, b2 = { p2.x, bodyRect.height };
+                    GraphGeometry_Triangle(&panel->fillGeometry, p1, fadeTop, b1, fadeBot, p2, fadeTop);
+                    GraphGeometry_Triangle(&panel->fillGeometry, b1, fadeBot, b2, fadeBot, p2, fadeTop);
+                }
+            }
+            GraphGeometry_Clear(&panel->curveGeometry);
+            for (int i = 1; i <= GRAPH_CURVE_STEPS; i++) GraphGeometry_Segment(&panel->curveGeometry, curve[i - 1], curve[i], 2.5f, mainColor);
+        }
+
+        layerDirty |= curveChanged;
+    } else {
+        layerDirty |= panel->curveCacheValid;
+        panel->curveCacheValid = false;
+    }
+
+    // Au plus deux points (min et max) par colonne de pixels. Les centres sont en
+    // unités des données : un changement d'axes ne les renvoie pas, et quand tous
+    // les points visibles sont dessinés, un ajout ne pousse que les nouveaux.
+    int budget = (int)bodyRect.width;
+    bool selectAll = (visEnd - visBegin) <= 2 * budget;
+    int changed = panel->markersValid ? GraphSeries_ChangedSince(series, panel->markerVersion) : visBegin;
+    if (panel->markersValid && selectAll && panel->markersAll && panel->markerBegin == visBegin && changed >= visBegin) {
+        int keep = changed;
+        if (keep > panel->markerEnd) keep = panel->markerEnd;
+        if (keep > visEnd) keep = visEnd;
+        if (keep < visEnd || keep < panel->markerEnd) {
+            GraphMarkers_Truncate(&panel->markers, keep - visBegin);
+            for (int i = keep; i < visEnd; i++) GraphMarkers_Add(&panel->markers, (Vector2){ valX[i], valY[i] });
+            layerDirty = true;
+        }
+    } else if (!panel->markersValid || changed < series->end || panel->markerBegin != visBegin || panel->markerEnd != visEnd ||
+               panel->markerBudget != budget || panel->markersAll != selectAll) {
+        int drawCount = GraphLod_Select(&series->lod, visBegin - startI, visEnd - startI, budget, state->drawIndices, GRAPH_MAX_DRAW_INDICES);
+        GraphMarkers_Clear(&panel->markers);
+        for (int k = 0; k < drawCount; k++) {
+            int i = startI + state->drawIndices[k];
+            GraphMarkers_Add(&panel->markers, (Vector2){ valX[i], valY[i] });
+        }
+        layerDirty = true;
+    }
+    panel->markersValid = true;
+    panel->markersAll = selectAll;
+    panel->markerVersion = series->lod.version;
+    panel->markerBegin = visBegin;
+    panel->markerEnd = visEnd;
+    panel->markerBudget = budget;
+
+    // Export : copie de ce qui est affiché, avec assez de points pour la largeur d'impression.
+    if (state->requestExport) {
+        GraphExportPanel desc = { 0 };
+        if (state->panelCount > 1) snprintf(desc.label, sizeof(desc.label), "%s", GraphModeLabel(state, panel->mode));
+        if (showEquation) snprintf(desc.equation, sizeof(desc.equation), "%s", eqBuffer);
+        desc.color = mainColor;
+        desc.minX = minX; desc.maxX = maxX; desc.minY = minY; desc.maxY = maxY;
+        desc.width = bodyRect.width; desc.height = bodyRect.height;
+        desc.fill = state->showFill;
+        desc.hasCurve = drawCurve;
+        if (drawCurve) {
+            float stepX = (maxX - minX) / GRAPH_EXPORT_CURVE_STEPS;
+            for (int i = 0; i <= GRAPH_EXPORT_CURVE_STEPS; i++) desc.curveY[i] = GetCurveY(reg, curveFit, minX + i * stepX);
+        }
+        int exportCount = GraphLod_Select(&series->lod, visBegin - startI, visEnd - startI, GRAPH_EXPORT_WIDTH, state->drawIndices, GRAPH_MAX_DRAW_INDICES);
+        GraphExport_AddPanel(state->exporter, &desc, valX + startI, valY + startI, state->drawIndices, exportCount);
+    }
+
+    GraphViewKey viewKey = { (int)panel->mode, series->lod.version, startI, minX, maxX, minY, maxY, bodyRect.width, bodyRect.height };
+    if (!panel->viewValid || memcmp(&viewKey, &panel->viewKey, sizeof(GraphViewKey)) != 0) {
+        layerDirty = true;
+        panel->viewKey = viewKey;
+        panel->viewValid = true;
     }
+    GraphMapping mapping = { bodyRect.width / (maxX - minX), -bodyRect.height / (maxY - minY), minX, maxY };
 
+    // Survol : dichotomie sur le temps (croissant), grille pour la trajectoire y(x).
+    Vector2 mouse = GetMousePosition();
+    int hoverIdx = -1;
+    if (CheckCollisionPointRec(mouse, bodyRect)) {
+        int found = -1;
+        bool usePickGrid = (panel->mode == GRAPH_Y_X || !sortedX);
+        if (usePickGrid) {
+            // Grille construite à la demande : rien à faire tant que la souris est ailleurs.
+            if (!panel->pickValid || memcmp(&viewKey, &panel->pickKey, sizeof(GraphViewKey)) != 0) {
+                GraphPick_Build(&panel->pick, valX + startI, valY + startI, endI - startI, minX, maxX, minY, maxY, bodyRect.width, bodyRect.height);
+                panel->pickKey = viewKey;
+                panel->pickValid = true;
+            }
+            found = GraphPick_Nearest(&panel->pick, mouse.x - bodyRect.x, mouse.y - bodyRect.y, 50.0f);
+        } else {
+            float mouseX = minX + (mouse.x - bodyRect.x) / bodyRect.width * (maxX - minX);
+            found = GraphPick_NearestSorted(valX + startI, endI - startI, mouseX);
+            if (found != -1) {
+                float screenX = bodyRect.x + (valX[startI + found] - minX) / (maxX - minX) * bodyRect.width;
+                if (fabsf(mouse.x - screenX) > 50.0f) found = -1;
+            }
+        }
+        if (found != -1) hoverIdx = startI + found;
+    }
+    if (hoverIdx != -1) state->nextCursorIdx = hoverIdx;
+
+    if (layerDirty) {
+        panel->layerValid = true;
+        panel->layerShowFill = state->showFill;
+        strcpy(panel->layerText, eqBuffer);
+
+        BeginTextureMode(panel->layer);
+        ClearBackground(graphBgColor);
+        // Le calque couvre exactement le tracé : on dessine avec les coordonnées écran.
+        rlPushMatrix();
+        rlTranslatef(-bodyRect.x, -bodyRect.y, 0.0f);
+        Vector2 origin = { bodyRect.x, bodyRect.y };
+
+        rlSetBlendMode(RL_BLEND_ALPHA);
+        rlBegin(RL_LINES); rlColor4ub(60, 60, 60, 255);
+        int gridDivs = 6;
+        for (int i = 0; i <= gridDivs; i++) {
+            float r = (float)i / gridDivs;
+            float gx = bodyRect.x + r * bodyRect.width;
+            float gy = bodyRect.y + bodyRect.height - (r * bodyRect.height);
+            rlVertex2f(gx, bodyRect.y); rlVertex2f(gx, bodyRect.y + bodyRect.height);
+            rlVertex2f(bodyRect.x, gy); rlVertex2f(bodyRect.x + bodyRect.width, gy);
+        }
+        rlEnd();
+
+        for (int i = 0; i <= gridDivs; i += 2) {
+            float r = (float)i / gridDivs;
+            char lblX[32], lblY[32];
+            sprintf(lblX, "%.2f", minX + r * (maxX - minX));
+            sprintf(lblY, "%.2f", minY + r * (maxY - minY));
+            DrawTextEx(ui->appFont, lblX, (Vector2){bodyRect.x + r * bodyRect.width + 2, bodyRect.y + bodyRect.height - 15}, 10, 1.0f, GRAY);
+            DrawTextEx(ui->appFont, lblY, (Vector2){bodyRect.x + 5, bodyRect.y + bodyRect.height - (r * bodyRect.height) - 12}, 10, 1.0f, GRAY);
+        }
+
+        if (state->panelCount > 1) {
+            DrawTextEx(ui->appFont, GraphModeLabel(state, panel->mode), (Vector2){bodyRect.x + 8, bodyRect.y + 6}, 15, 1.0f, mainColor);
+        }
+
+        if (drawCurve) {
+            if (state->showFill) {
+                rlDrawRenderBatchActive(); rlColorMask(true, true, true, false); 
+                GraphGeometry_Draw(&panel->fillGeometry, origin);
+                rlDrawRenderBatchActive(); rlColorMask(true, true, true, true); 
+            }
+            GraphGeometry_Draw(&panel->curveGeometry, origin);
+        }
+        GraphMarkers_Draw(&panel->markers, origin, mapping, 3.0f, (Color){200, 200, 200, 150});
+
+        if (showEquation) {
+            Vector2 txtSz = MeasureTextEx(ui->appFont, eqBuffer, fontSize, 1.0f);
+            rlDrawRenderBatchActive(); rlColorMask(true, true, true, false); 
+            DrawRectangle(bodyRect.x + bodyRect.width - txtSz.x - 10, bodyRect.y + 5, txtSz.x + 10, txtSz.y + 6, graphBgColor);
+            rlDrawRenderBatchActive(); rlColorMask(true, true, true, true);
+            DrawTextEx(ui->appFont, eqBuffer, (Vector2){bodyRect.x + bodyRect.width - txtSz.x - 5, bodyRect.y + 7}, fontSize, 1.0f, mainColor);
+        }
+        rlPopMatrix();
+        EndTextureMode();
+    }
+
+    // Le calque est opaque : copie sans mélange, texture retournée (origine OpenGL en bas).
+    rlDisableColorBlend();
+    DrawTextureRec(panel->layer.texture, (Rectangle){ 0, 0, (float)layerW, -(float)layerH }, (Vector2){ bodyRect.x, bodyRect.y }, WHITE);
+    rlEnableColorBlend();
+
+    BeginScissorMode((int)bodyRect.x, (int)bodyRect.y, (int)bodyRect.width, (int)bodyRect.height);
     if (hoverIdx != -1) {
+        float nx = (valX[hoverIdx] - minX) / (maxX - minX);
+        float ny = (valY[hoverIdx] - minY) / (maxY - minY);
+        Vector2 p = { bodyRect.x + nx * bodyRect.width, bodyRect.y + bodyRect.height - (ny * bodyRect.height) };
+        DrawCircleV(p, 6.0f, WHITE); 
+        DrawCircleLines((int)p.x, (int)p.y, 10.0f, mainColor);
+    }
+    // Curseur partagé : le point survolé dans un autre panneau est repéré ici aussi.
+    int cursorIdx = state->cursorIdx;
+    if (hoverIdx == -1 && cursorIdx >= startI && cursorIdx < endI) {
+        float nx = (valX[cursorIdx] - minX) / (maxX - minX);
+        float ny = (valY[cursorIdx] - minY) / (maxY - minY);
+        Vector2 p = { bodyRect.x + nx * bodyRect.width, bodyRect.y + bodyRect.height - (ny * bodyRect.height) };
+        if (panel->mode != GRAPH_Y_X) DrawLine(p.x, bodyRect.y, p.x, bodyRect.y + bodyRect.height, Fade(WHITE, 0.2f));
+        DrawCircleLines((int)p.x, (int)p.y, 6.0f, mainColor);
+    }
+    if (panel->isBoxZooming) {
+        Vector2 a = panel->boxStart, b = GetMousePosition();
+        Rectangle box = { fminf(a.x, b.x), fminf(a.y, b.y), fabsf(b.x - a.x), fabsf(b.y - a.y) };
+        DrawRectangleRec(box, Fade(mainColor, 0.15f));
+        DrawRectangleLinesEx(box, 1, mainColor);
+    }
+    EndScissorMode(); 
+
+    if (hoverIdx != -1 && !panel->isBoxZooming) {
         float hValX = valX[hoverIdx]; float hValY = valY[hoverIdx];
         float nx = (hValX - minX) / (maxX - minX); float ny = (hValY - minY) / (maxY - minY);
         Vector2 target = { bodyRect.x + nx * bodyRect.width, bodyRect.y + bodyRect.height - (ny * bodyRect.height) };
@@ -332,10 +668,11 @@ void DrawGraphContent(Rectangle bodyRect, GraphState *state, TrackingSystem *ts,
         DrawLine(bodyRect.x, target.y, bodyRect.x + bodyRect.width, target.y, Fade(WHITE, 0.2f));
 
         const char* txtX = TextFormat("t: %.3f", hValX); 
-        if (state->mode == GRAPH_Y_X) txtX = TextFormat("x: %.3f", hValX);
+        if (panel->mode == GRAPH_Y_X) txtX = TextFormat("x: %.3f", hValX);
         const char* txtY = TextFormat("v: %.3f", hValY);
-        if (state->mode == GRAPH_Y_X || state->mode == GRAPH_Y_T) txtY = TextFormat("y: %.3f", hValY);
-        if (state->mode == GRAPH_AX_T || state->mode == GRAPH_AY_T) txtY = TextFormat("a: %.3f", hValY);
+        if (panel->mode == GRAPH_Y_X || panel->mode == GRAPH_Y_T) txtY = TextFormat("y: %.3f", hValY);
+        if (panel->mode == GRAPH_AX_T || panel->mode == GRAPH_AY_T) txtY = TextFormat("a: %.3f", hValY);
+        if (panel->mode >= GRAPH_USER && state->derived) txtY = TextFormat("%s: %.4g", state->derived->columns[panel->mode - GRAPH_USER].name, hValY);
 
         const char* fullTxt = TextFormat("%s\n%s", txtX, txtY);
         float tipFontSize = 20.0f; float spacing = 2.0f;
@@ -364,8 +701,14 @@ void DrawGraphWindow(UIState *ui, GraphState *state, TrackingSystem *ts) {
 
     Rectangle header = { state->bounds.x, state->bounds.y, state->bounds.width, 35 };
     Rectangle closeBtn = { state->bounds.x + state->bounds.width - 35, state->bounds.y, 35, 35 };
+    Rectangle panelMinusBtn = { state->bounds.x + state->bounds.width - 190, state->bounds.y + 4, 27, 27 };
+    Rectangle panelPlusBtn = { state->bounds.x + state->bounds.width - 70, state->bounds.y + 4, 27, 27 };
+    Rectangle pngBtn = { state->bounds.x + state->bounds.width - 300, state->bounds.y + 4, 45, 27 };
+    Rectangle svgBtn = { state->bounds.x + state->bounds.width - 250, state->bounds.y + 4, 45, 27 };
     Vector2 mouse = GetMousePosition();
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, header) && !CheckCollisionPointRec(mouse, closeBtn)) {
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, header) && !CheckCollisionPointRec(mouse, closeBtn) &&
+        !CheckCollisionPointRec(mouse, panelMinusBtn) && !CheckCollisionPointRec(mouse, panelPlusBtn) &&
+        !CheckCollisionPointRec(mouse, pngBtn) && !CheckCollisionPointRec(mouse, svgBtn)) {
         state->isDragging = true; state->dragOffset = (Vector2){ mouse.x - state->bounds.x, mouse.y - state->bounds.y };
     }
     if (state->isDragging) {
@@ -376,20 +719,66 @@ void DrawGraphWindow(UIState *ui, GraphState *state, TrackingSystem *ts) {
     DrawTextEx(ui->appFont, L(T_GRAPH_WINDOW_TITLE), (Vector2){state->bounds.x + 12, state->bounds.y + 8}, 16, 1.0f, LIGHTGRAY);
     if (GuiButton(ui, closeBtn, "X")) ui->showGraphWindow = false;
 
-    const char* labels[] = { "y(x)", "x(t)", "y(t)", "Vx(t)", "Vy(t)", "Ax(t)", "Ay(t)" };
+    if (GuiButton(ui, panelMinusBtn, "-") && state->panelCount > 1) {
+        state->panelCount--;
+        if (state->activePanel >= state->panelCount) state->activePanel = state->panelCount - 1;
+    }
+    DrawTextEx(ui->appFont, TextFormat(L(T_GRAPH_PANELS), state->panelCount), (Vector2){ panelMinusBtn.x + 35, state->bounds.y + 10 }, 15, 1.0f, LIGHTGRAY);
+    if (GuiButton(ui, panelPlusBtn, "+") && state->panelCount < GRAPH_MAX_PANELS) state->panelCount++;
+
+    // Export haute résolution : les panneaux se copient pendant leur dessin, le
+    // fichier est écrit par un thread de travail.
+    bool exportBusy = GraphExport_IsBusy(state->exporter);
+    if (GuiButton(ui, pngBtn, "PNG") && !exportBusy) { state->requestExport = true; state->exportFormat = GRAPH_EXPORT_PNG; }
+    if (GuiButton(ui, svgBtn, "SVG") && !exportBusy) { state->requestExport = true; state->exportFormat = GRAPH_EXPORT_SVG; }
+    if (state->requestExport) GraphExport_Begin(state->exporter);
+
+    GraphExportStatus exportStatus = GraphExport_Status(state->exporter);
+    if (exportStatus != state->exportStatus) { state->exportStatus = exportStatus; state->exportStatusTime = GetTime(); }
+    const char *exportMsg = NULL;
+    if (exportStatus == GRAPH_EXPORT_RUNNING) exportMsg = L(T_GRAPH_EXPORTING);
+    else if (exportStatus == GRAPH_EXPORT_DONE && GetTime() - state->exportStatusTime < 3.0) exportMsg = L(T_GRAPH_EXPORTED);
+    else if (exportStatus == GRAPH_EXPORT_FAILED && GetTime() - state->exportStatusTime < 3.0) exportMsg = L(T_GRAPH_EXPORT_FAILED);
+    if (exportMsg) {
+        Vector2 msgSz = MeasureTextEx(ui->appFont, exportMsg, 15, 1.0f);
+        DrawTextEx(ui->appFont, exportMsg, (Vector2){ pngBtn.x - msgSz.x - 10, state->bounds.y + 10 }, 15, 1.0f, exportStatus == GRAPH_EXPORT_FAILED ? (Color){ 239, 83, 80, 255 } : LIGHTGRAY);
+    }
+
+    GraphPanel *active = &state->panels[state->activePanel];
     float btnW = 70; int fontSize = 15;
     float startX = state->bounds.x + 15;
     float startY = state->bounds.y + 45;
 
-    for (int i = 0; i < 7; i++) {
+    for (int i = 0; i < GRAPH_USER; i++) {
         Rectangle btnRect = { startX + i*(btnW+5), startY, btnW, 30 };
-        bool isActive = (state->mode == (GraphMode)i);
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, btnRect)) state->mode = (GraphMode)i;
+        bool isActive = (active->mode == (GraphMode)i);
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, btnRect)) active->mode = (GraphMode)i;
         Color bg = isActive ? COLOR_ACCENT : (Color){50,50,50,255};
         DrawRectangleRounded(btnRect, 0.3f, 4, bg);
-        Vector2 txtSz = MeasureTextEx(ui->appFont, labels[i], fontSize, 1.0f);
-        DrawTextEx(ui->appFont, labels[i], (Vector2){btnRect.x + (btnW-txtSz.x)/2, btnRect.y + (30-txtSz.y)/2}, fontSize, 1.0f, WHITE);
+        Vector2 txtSz = MeasureTextEx(ui->appFont, graphModeLabels[i], fontSize, 1.0f);
+        DrawTextEx(ui->appFont, graphModeLabels[i], (Vector2){btnRect.x + (btnW-txtSz.x)/2, btnRect.y + (30-txtSz.y)/2}, fontSize, 1.0f, WHITE);
+    }
+
+    // Grandeurs dérivées : un seul bouton qui passe de l'une à la suivante ; sans
+    // grandeur définie, il ouvre la fenêtre d'édition.
+    DerivedSet *derived = state->derived;
+    int derivedCount = derived ? derived->count : 0;
+    for (int i = 0; i < state->panelCount; i++) {
+        if (state->panels[i].mode >= GRAPH_USER && (int)state->panels[i].mode - GRAPH_USER >= derivedCount) state->panels[i].mode = GRAPH_Y_T;
     }
+    Rectangle userBtn = { startX + GRAPH_USER*(btnW+5), startY, 60, 30 };
+    bool userActive = (active->mode >= GRAPH_USER);
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, userBtn)) {
+        if (derivedCount == 0) ui->showDerivedWindow = true;
+        else active->mode = (GraphMode)(GRAPH_USER + (userActive ? (active->mode - GRAPH_USER + 1) % derivedCount : 0));
+        userActive = (active->mode >= GRAPH_USER);
+    }
+    const char *userLabel = (derivedCount == 0) ? "f(t)" : derived->columns[userActive ? active->mode - GRAPH_USER : 0].name;
+    DrawRectangleRounded(userBtn, 0.3f, 4, userActive ? COLOR_ACCENT : (Color){50,50,50,255});
+    Vector2 userSz = MeasureTextEx(ui->appFont, userLabel, fontSize, 1.0f);
+    BeginScissorMode((int)userBtn.x, (int)userBtn.y, (int)userBtn.width, (int)userBtn.height);
+    DrawTextEx(ui->appFont, userLabel, (Vector2){userBtn.x + fmaxf(4.0f, (userBtn.width-userSz.x)/2), userBtn.y + (30-userSz.y)/2}, fontSize, 1.0f, WHITE);
+    EndScissorMode();
 
     Rectangle toggleRegBtn = { state->bounds.x + state->bounds.width - 190, startY, 80, 28 };
     if (GuiButton(ui, toggleRegBtn, state->showRegression ? L(T_HIDE_FIT) : L(T_SHOW_FIT))) state->showRegression = !state->showRegression;
@@ -399,7 +788,75 @@ void DrawGraphWindow(UIState *ui, GraphState *state, TrackingSystem *ts) {
         state->showFill = !state->showFill;
     }
 
-    Rectangle graphBody = { state->bounds.x + 50, state->bounds.y + 90, state->bounds.width - 70, state->bounds.height - 120 };
-    DrawGraphContent(graphBody, state, ts, ui);
-    DrawRectangleLinesEx(graphBody, 1, (Color){80, 80, 80, 255});
+    float fitY = state->bounds.y + state->bounds.height - 80;
+    const TextID fitLabels[FIT_MODEL_COUNT] = { T_FIT_AUTO, T_FIT_POLYNOMIAL, T_FIT_OSCILLATOR, T_FIT_DECAY, T_FIT_DRAG };
+    if (GuiButton(ui, (Rectangle){ startX, fitY, 230, 28 }, L(fitLabels[state->fitModel]))) {
+        state->fitModel = (FitModel)((state->fitModel + 1) % FIT_MODEL_COUNT);
+    }
+    if (state->fitModel == FIT_POLYNOMIAL) {
+        float paramX = startX + 240;
+        if (GuiButton(ui, (Rectangle){ paramX, fitY, 28, 28 }, "-") && state->fitDegree > 1) state->fitDegree--;
+        DrawTextEx(ui->appFont, TextFormat(L(T_DIFF_ORDER), state->fitDegree), (Vector2){ paramX + 36, fitY + 6 }, 15, 1.0f, LIGHTGRAY);
+        if (GuiButton(ui, (Rectangle){ paramX + 120, fitY, 28, 28 }, "+") && state->fitDegree < FIT_MAX_DEGREE) state->fitDegree++;
+    }
+    const TextID bootLabels[BOOT_MODE_COUNT] = { T_BOOT_OFF, T_BOOT_RESAMPLE, T_BOOT_JITTER };
+    if (GuiButton(ui, (Rectangle){ state->bounds.x + state->bounds.width - 250, fitY, 240, 28 }, L(bootLabels[state->bootstrap]))) {
+        state->bootstrap = (BootstrapMode)((state->bootstrap + 1) % BOOT_MODE_COUNT);
+    }
+
+    DiffSettings diff = Kinematics_Settings(state->kinematics);
+    float diffY = state->bounds.y + state->bounds.height - 45;
+    const TextID methodLabels[DIFF_METHOD_COUNT] = { T_DIFF_CENTRAL, T_DIFF_SAVGOL, T_DIFF_SPLINE };
+    if (GuiButton(ui, (Rectangle){ startX, diffY, 230, 28 }, L(methodLabels[diff.method]))) {
+        diff.method = (DiffMethod)((diff.method + 1) % DIFF_METHOD_COUNT);
+    }
+    float paramX = startX + 240;
+    if (diff.method == DIFF_SAVGOL) {
+        if (GuiButton(ui, (Rectangle){ paramX, diffY, 28, 28 }, "-")) diff.half--;
+        DrawTextEx(ui->appFont, TextFormat(L(T_DIFF_WINDOW), 2 * diff.half + 1), (Vector2){ paramX + 36, diffY + 6 }, 15, 1.0f, LIGHTGRAY);
+        if (GuiButton(ui, (Rectangle){ paramX + 120, diffY, 28, 28 }, "+")) diff.half++;
+        if (GuiButton(ui, (Rectangle){ paramX + 160, diffY, 90, 28 }, TextFormat(L(T_DIFF_ORDER), diff.order))) {
+            diff.order = (diff.order >= 5) ? 2 : diff.order + 1;
+        }
+    } else if (diff.method == DIFF_SPLINE) {
+        if (GuiButton(ui, (Rectangle){ paramX, diffY, 28, 28 }, "-")) diff.lambda /= 4.0f;
+        DrawTextEx(ui->appFont, TextFormat(L(T_DIFF_SMOOTHING), diff.lambda), (Vector2){ paramX + 36, diffY + 6 }, 15, 1.0f, LIGHTGRAY);
+        if (GuiButton(ui, (Rectangle){ paramX + 160, diffY, 28, 28 }, "+")) diff.lambda *= 4.0f;
+    }
+    Kinematics_Configure(state->kinematics, diff);
+
+    // Toutes les séries de l'image lisent les mêmes positions et dérivées.
+    state->frame++;
+    state->cursorIdx = state->nextCursorIdx;
+    state->nextCursorIdx = -1;
+    if (ts->count >= 5) {
+        Tracking_UpdatePhysical(ts);
+        Kinematics_Update(state->kinematics, ts);
+        // Réglages de dérivation changés plus haut : les grandeurs suivent dans la même image.
+        if (state->derived) Derived_Update(state->derived, ts);
+    }
+
+    // Tuiles empilées : les panneaux temporels partagent l'axe horizontal à l'écran.
+    Rectangle graphBody = { state->bounds.x + 50, state->bounds.y + 90, state->bounds.width - 70, state->bounds.height - 185 };
+    float gap = 8.0f;
+    float tileH = (graphBody.height - gap * (state->panelCount - 1)) / state->panelCount;
+    for (int i = 0; i < state->panelCount; i++) {
+        Rectangle tile = { graphBody.x, graphBody.y + i * (tileH + gap), graphBody.width, tileH };
+        if (state->panelCount > 1 && !state->isDragging && CheckCollisionPointRec(mouse, tile) &&
+            (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))) {
+            state->activePanel = i;
+        }
+        DrawGraphContent(tile, state, &state->panels[i], ts, ui);
+        bool highlight = (state->panelCount > 1 && i == state->activePanel);
+        DrawRectangleLinesEx(tile, 1, highlight ? COLOR_ACCENT : (Color){80, 80, 80, 255});
+    }
+
+    if (state->requestExport) {
+        state->requestExport = false;
+        bool svg = (state->exportFormat == GRAPH_EXPORT_SVG);
+        if (GraphExport_PanelCount(state->exporter) > 0) {
+            char* path = sfd_save_file(L(svg ? T_FILTER_SVG : T_FILTER_PNG), svg ? "svg" : "png", svg ? "graph.svg" : "graph.png");
+            if (path) GraphExport_Start(state->exporter, state->exportFormat, path);
+        }
+    }
 }
\ No newline at end of file
@@ -30,9 +30,10 @@ static int GetCharIndexUnderMouse(Font font, const char* text, float mouseRelX)
     int len = (int)strlen(text);
     int bestIndex = 0;
     float minDiff = 10000.0f;
+    if (len > 255) len = 255;
     
     for(int i=0; i<=len; i++) {
-        char tmp[64];
+        char tmp[256];
         strncpy(tmp, text, i);
         tmp[i] = '\0';
         Vector2 sz = MeasureTextEx(font, tmp, 14.0f, 1.0f);
@@ -49,17 +50,32 @@ static int GetCharIndexUnderMouse(Font font, const char* text, float mouseRelX)
 
 bool GuiFloatInput(struct UIState *ui, Rectangle bounds, float *value, const char* suffix) {
     Vector2 mouse = GetMousePosition();
-    bool hover = CheckCollisionPointRec(mouse, bounds);
+    bool hover = CheckCollisionPointRec(mouse, bounds) && IsMouseInWidgetClip(ui);
     
     Font font = ui->appFont;
     float fontSize = 14.0f;
     float textPadding = 5.0f;
 
+    // Un autre champ est en cours d'édition : on affiche seulement celui-ci, sauf
+    // s'il est cliqué, auquel cas l'autre est validé et l'édition passe ici.
+    if (ui->isEditingDist && ui->distEditTarget != value) {
+        if (hover && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            if (ui->distEditTarget && strlen(ui->distInputBuf) > 0) *ui->distEditTarget = (float)atof(ui->distInputBuf);
+            ui->isEditingDist = false;
+            ui->distSelectStart = -1;
+        } else {
+            ui->isEditingDist = false;
+            bool changed = GuiFloatInput(ui, bounds, value, suffix);
+            ui->isEditingDist = true;
+            return changed;
+        }
+    }
 
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
         if (hover) {
             if (!ui->isEditingDist) {
                 ui->isEditingDist = true;
+                ui->distEditTarget = value;
                 sprintf(ui->distInputBuf, "%.3f", *value);
                 ui->distCursorIndex = (int)strlen(ui->distInputBuf);
                 ui->distSelectStart = 0;
@@ -243,4 +259,107 @@ bool GuiFloatInput(struct UIState *ui, Rectangle bounds, float *value, const cha
     EndScissorMode();
 
     return ui->isEditingDist;
+}
+
+bool GuiTextInput(struct UIState *ui, Rectangle bounds, char *buffer, int size, GuiTextState *state) {
+    Vector2 mouse = GetMousePosition();
+    bool hover = CheckCollisionPointRec(mouse, bounds) && IsMouseInWidgetClip(ui);
+
+    Font font = ui->appFont;
+    float fontSize = 14.0f;
+    float textPadding = 5.0f;
+    bool committed = false;
+    bool wasEditing = state->editing;
+
+    int len = (int)strlen(buffer);
+    if (state->cursor < 0) state->cursor = 0;
+    if (state->cursor > len) state->cursor = len;
+
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+        if (hover) {
+            state->editing = true;
+            state->cursor = GetCharIndexUnderMouse(font, buffer, mouse.x - (bounds.x + textPadding) + state->scroll);
+        } else if (state->editing) {
+            state->editing = false;
+            committed = true;
+        }
+    }
+
+    if (state->editing) {
+        bool ctrl = IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL);
+
+        if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_KP_ENTER)) {
+            state->editing = false;
+            committed = true;
+        }
+
+        if (ctrl && IsKeyPressed(KEY_V)) {
+            const char* clipText = GetClipboardText();
+            if (clipText != NULL) {
+                char cleanText[256];
+                int cleanIdx = 0;
+                for (int i = 0; clipText[i] != '\0' && cleanIdx < 255; i++) {
+                    if (clipText[i] >= 32 && clipText[i] <= 126) cleanText[cleanIdx++] = clipText[i];
+                }
+                cleanText[cleanIdx] = '\0';
+                InsertText(buffer, size, &state->cursor, cleanText);
+            }
+        }
+
+        if (IsKeyPressed(KEY_LEFT) || IsKeyPressedRepeat(KEY_LEFT)) {
+            if (state->cursor > 0) state->cursor--;
+        }
+        if (IsKeyPressed(KEY_RIGHT) || IsKeyPressedRepeat(KEY_RIGHT)) {
+            if (state->cursor < (int)strlen(buffer)) state->cursor++;
+        }
+        if (IsKeyPressed(KEY_HOME)) state->cursor = 0;
+        if (IsKeyPressed(KEY_END)) state->cursor = (int)strlen(buffer);
+
+        if ((IsKeyPressed(KEY_BACKSPACE) || IsKeyPressedRepeat(KEY_BACKSPACE)) && state->cursor > 0) {
+            DeleteTextRange(buffer, state->cursor - 1, state->cursor);
+            state->cursor--;
+        }
+        if (IsKeyPressed(KEY_DELETE) || IsKeyPressedRepeat(KEY_DELETE)) {
+            DeleteTextRange(buffer, state->cursor, state->cursor + 1);
+        }
+
+        int key = GetCharPressed();
+        while (key > 0) {
+            if (key >= 32 && key <= 126) {
+                char str[2] = { (char)key, '\0' };
+                InsertText(buffer, size, &state->cursor, str);
+            }
+            key = GetCharPressed();
+        }
+    }
+    // Espace et flèches ne doivent pas piloter la vidéo pendant la saisie.
+    if (state->editing) ui->isEditingText = true;
+    else if (wasEditing) ui->isEditingText = false;
+
+    char textBeforeCursor[256];
+    int before = (state->cursor < 255) ? state->cursor : 255;
+    strncpy(textBeforeCursor, buffer, before);
+    textBeforeCursor[before] = '\0';
+    float cursorPixelX = MeasureTextEx(font, textBeforeCursor, fontSize, 1.0f).x;
+
+    float visibleWidth = bounds.width - (textPadding * 2);
+    if (cursorPixelX - state->scroll > visibleWidth) state->scroll = cursorPixelX - visibleWidth;
+    if (cursorPixelX - state->scroll < 0) state->scroll = cursorPixelX;
+    if (!state->editing || MeasureTextEx(font, buffer, fontSize, 1.0f).x < visibleWidth) state->scroll = 0;
+
+    Color bgColor = state->editing ? (Color){30, 30, 30, 255} : (Color){50, 50, 50, 255};
+    Color borderColor = state->editing ? COLOR_ACCENT : (Color){80, 80, 80, 255};
+    DrawRectangleRounded(bounds, 0.3f, 4, bgColor);
+    DrawRectangleRoundedLines(bounds, 0.3f, 4, borderColor);
+
+    BeginScissorMode((int)bounds.x + 2, (int)bounds.y + 2, (int)bounds.width - 4, (int)bounds.height - 4);
+        float drawX = bounds.x + textPadding - state->scroll;
+        float drawY = bounds.y + (bounds.height - fontSize)/2;
+        DrawTextEx(font, buffer, (Vector2){drawX, drawY}, fontSize, 1.0f, WHITE);
+        if (state->editing && ((int)(GetTime() * 2) % 2) == 0) {
+            DrawLine((int)(drawX + cursorPixelX), (int)bounds.y + 5, (int)(drawX + cursorPixelX), (int)(bounds.y + bounds.height - 5), COLOR_ACCENT);
+        }
+    EndScissorMode();
+
+    return committed;
 }
\ No newline at end of file
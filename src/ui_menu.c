@@ -26,9 +26,10 @@ void App_OpenURL(const char* url) {
 }
 
 static void Action_OpenVideo_Internal(VideoEngine *v, TrackingSystem *ts) {
-    char* path = sfd_open_file("Videos\0*.mp4;*.avi;*.mkv\0");
+    char* path = sfd_open_file("Videos / Images\0*.mp4;*.avi;*.mkv;*.png;*.tif;*.tiff;*.jpg;*.jpeg;*.bmp;*.dpx\0");
     if (path) {
         Video_Unload(v);
+        Video_SetCrop(v, (Rectangle){ 0 });
         if (Video_Load(v, path)) {
             strncpy(currentFilePath, path, 511);
             ts->count = 0;
@@ -88,7 +89,7 @@ void DrawMenuBar(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracker *a
             int itemCount = 0;
             if (i == MENU_FILE) itemCount = 4;
             else if (i == MENU_EXPORT) itemCount = 3;
-            else if (i == MENU_GRAPHS) itemCount = 1;
+            else if (i == MENU_GRAPHS) itemCount = 3;
             else if (i == MENU_HELP) itemCount = 3;
 
             Rectangle dropRect = { btnRect.x, 45, 210, (float)itemCount * itemHeight + 10 };
@@ -111,7 +112,7 @@ void DrawMenuBar(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracker *a
                     }
                     itemY += itemHeight;
                     if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_OPEN_PROJET), NULL)) {
-                        if (Action_LoadProject(ts, v, currentFilePath)) {
+                        if (Action_LoadProject(ts, v, ui->derived, currentFilePath)) {
                             Video_Unload(v);
                             if (Video_Load(v, currentFilePath)) {
                                 printf("%s : %s\n", L(T_MSG_LOADED), currentFilePath);
@@ -121,32 +122,29 @@ void DrawMenuBar(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracker *a
                     }
                     itemY += itemHeight;
                     if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_SAVE_PROJET), "Ctrl+S")) {
-                        Action_SaveProject(ts,currentFilePath);
+                        Action_SaveProject(ts, v, ui->derived, currentFilePath);
                         
                         activeMenu = MENU_NONE;
                     }
                     itemY += itemHeight;
                     if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_QUIT), "Alt+F4")) {
                         activeMenu = MENU_NONE;
-                        Video_Unload(v);
-                        AutoTracker_Free(at);
-                        CloseWindow();
-                        exit(0);
+                        ui->requestQuit = true;
                     }
                 }
                 else if (i == MENU_EXPORT) {
                     if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_TO_REGRESSI), NULL)) {
-                        Action_ExportRegressi(ts, currentFilePath);
+                        Action_ExportRegressi(ts, ui->derived, currentFilePath);
                         activeMenu = MENU_NONE;
                     }
                     itemY += itemHeight;
                     if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_TO_EXCEL), NULL)) {
-                        Action_ExportCSV(ts, currentFilePath);
+                        Action_ExportCSV(ts, ui->derived, currentFilePath);
                         activeMenu = MENU_NONE;
                     }
                     itemY += itemHeight;
                     if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_COPY_CLIPBOARD), NULL)) {
-                        Action_CopyClipboard(ts);
+                        Action_CopyClipboard(ts, ui->derived);
                         activeMenu = MENU_NONE;
                     }
                 }
@@ -155,6 +153,16 @@ void DrawMenuBar(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracker *a
                         ui->showGraphWindow = !ui->showGraphWindow;
                         activeMenu = MENU_NONE; 
                     }
+                    itemY += itemHeight;
+                    if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_VIEW_SPECTRUM), "F3")) {
+                        ui->showSpectrumWindow = !ui->showSpectrumWindow;
+                        activeMenu = MENU_NONE;
+                    }
+                    itemY += itemHeight;
+                    if (DrawMenuItem(ui, (Rectangle){itemX, itemY, itemWidth, itemHeight}, L(T_VIEW_DERIVED), "F4")) {
+                        ui->showDerivedWindow = !ui->showDerivedWindow;
+                        activeMenu = MENU_NONE;
+                    }
 
                 }
                 else if (i == MENU_HELP) {
@@ -188,6 +196,7 @@ void HandleShortcuts(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracke
         FilePathList droppedFiles = LoadDroppedFiles();
         if (droppedFiles.count > 0) {
             Video_Unload(v);
+            Video_SetCrop(v, (Rectangle){ 0 });
             if (Video_Load(v, droppedFiles.paths[0])) {
                 strncpy(currentFilePath, droppedFiles.paths[0], 511);
                 ts->count = 0;
@@ -202,10 +211,12 @@ void HandleShortcuts(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracke
         AutoTracker_ConfirmSelection(autoTracker, v);
         autoTracker->pendingInit = false;
     }
-    if (autoTracker->state == TRACKER_READY && IsKeyPressed(KEY_SPACE)) {
+    // Pendant une saisie de texte, Espace et les flèches appartiennent au champ.
+    bool typing = ui->isEditingText;
+    if (autoTracker->state == TRACKER_READY && IsKeyPressed(KEY_SPACE) && !typing) {
         AutoTracker_StartTracking(autoTracker);
     }
-    else if (autoTracker->state == TRACKER_TRACKING && IsKeyPressed(KEY_SPACE)) {
+    else if (autoTracker->state == TRACKER_TRACKING && IsKeyPressed(KEY_SPACE) && !typing) {
         AutoTracker_Stop(autoTracker);
         v->isPlaying = false;
     }
@@ -222,7 +233,7 @@ void HandleShortcuts(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracke
 
     if (ctrl && IsKeyPressed(KEY_S)) {
         if (ts->count > 0 || v->isLoaded) {
-            Action_SaveProject(ts, currentFilePath);
+            Action_SaveProject(ts, v, ui->derived, currentFilePath);
         }
     }
     if (IsKeyPressed(KEY_F1)) {
@@ -233,8 +244,16 @@ void HandleShortcuts(UIState *ui, VideoEngine *v, TrackingSystem *ts, AutoTracke
         ui->showGraphWindow = !ui->showGraphWindow;
         if (ui->showGraphWindow) ui->showHelp = false;
     }
+    if (IsKeyPressed(KEY_F3)) {
+        ui->showSpectrumWindow = !ui->showSpectrumWindow;
+        if (ui->showSpectrumWindow) ui->showHelp = false;
+    }
+    if (IsKeyPressed(KEY_F4)) {
+        ui->showDerivedWindow = !ui->showDerivedWindow;
+        if (ui->showDerivedWindow) ui->showHelp = false;
+    }
     
-    if (!v->isPlaying && v->isLoaded) {
+    if (!v->isPlaying && v->isLoaded && !typing) {
         if (IsKeyPressed(KEY_RIGHT) || IsKeyPressedRepeat(KEY_RIGHT)) {
             Video_NextFrame(v);
         }
@@ -20,7 +20,7 @@ bool DrawTabButton(const char* label, bool active, Rectangle bounds, struct UISt
 
 bool GuiButton(struct UIState *ui, Rectangle bounds, const char* text) {
     Vector2 mousePoint = GetMousePosition();
-    bool isHover = CheckCollisionPointRec(mousePoint, bounds);
+    bool isHover = CheckCollisionPointRec(mousePoint, bounds) && IsMouseInWidgetClip(ui);
     bool isPressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
     bool clicked = isHover && isPressed;
     Color colorBg = (Color){60, 60, 60, 255}; 
@@ -79,8 +79,12 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         DrawMeasurementTable(ui, ts, v, contentArea);
     } 
     else if (ui->activeTab == TAB_CALIB) {
-        int y = (int)contentArea.y;
+        if (CheckCollisionPointRec(GetMousePosition(), contentArea)) ui->calibScrollOffset -= GetMouseWheelMove() * 30.0f;
+        if (ui->calibScrollOffset < 0) ui->calibScrollOffset = 0;
+        int y = (int)(contentArea.y - ui->calibScrollOffset);
         int w = (int)contentArea.width;
+        ui->widgetClip = contentArea;
+        BeginScissorMode((int)contentArea.x, (int)contentArea.y, (int)contentArea.width, (int)contentArea.height);
 
         DrawTextApp(ui, L(T_AXIS_ORIENTATION), (int)contentArea.x, y, 12, COLOR_ACCENT);
         y += 25;
@@ -97,7 +101,7 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
             
             Rectangle btnRect = { (float)bx, (float)by, (float)btnSize, (float)btnSize };
             bool isSelected = (ts->calib.config == (AxisConfiguration)i);
-            bool hover = CheckCollisionPointRec(GetMousePosition(), btnRect);
+            bool hover = CheckCollisionPointRec(GetMousePosition(), btnRect) && IsMouseInWidgetClip(ui);
             
             if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && hover) {
                 ts->calib.config = (AxisConfiguration)i;
@@ -131,6 +135,8 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         if (GuiButton(ui, (Rectangle){ (float)contentArea.x, (float)y, (float)w, 35 }, btnLabel)) {
              ts->calib.isSettingOrigin = !ts->calib.isSettingOrigin;
              ts->calib.isSettingScale = false;
+             ts->calib.isSettingLens = false;
+             ts->calib.isSettingPlane = false;
         }
         y += 45;
         DrawTextApp(ui, TextFormat("X: %.0f px   Y: %.0f px", ts->calib.origin.x, ts->calib.origin.y), (int)contentArea.x, y, 14, GRAY);
@@ -144,6 +150,8 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         if (GuiButton(ui, (Rectangle){ (float)contentArea.x, (float)y, (float)w, 35 }, scaleLabel)) {
             ts->calib.isSettingScale = !ts->calib.isSettingScale;
             ts->calib.isSettingOrigin = false;
+            ts->calib.isSettingLens = false;
+            ts->calib.isSettingPlane = false;
             if (ts->calib.isSettingScale) ts->calib.scaleStep = 0;
         }
         y += 50;
@@ -152,8 +160,11 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         GuiFloatInput(ui, (Rectangle){ (float)(contentArea.x + w - inputW), (float)y, inputW, 30 }, &ts->calib.realDistance, "m");
         y += 45;
         if (ts->calib.scaleStep > 0 || ts->calib.pxPerMeter > 0) {
-            float dx = ts->calib.scalePointB.x - ts->calib.scalePointA.x;
-            float dy = ts->calib.scalePointB.y - ts->calib.scalePointA.y;
+            // L'échelle se mesure sur l'image redressée, comme les points.
+            Vector2 scaleA = Lens_Undistort(&ts->calib.lens, ts->calib.scalePointA);
+            Vector2 scaleB = Lens_Undistort(&ts->calib.lens, ts->calib.scalePointB);
+            float dx = scaleB.x - scaleA.x;
+            float dy = scaleB.y - scaleA.y;
             float pxDist = sqrtf(dx*dx + dy*dy);
             
             if (pxDist > 0 && ts->calib.realDistance > 0) {
@@ -164,9 +175,79 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         const char* resText = TextFormat(L(T_PX_PER_METER), ts->calib.pxPerMeter);
         Vector2 resSz = MeasureTextEx(ui->appFont, resText, 14, 1.0f);
         DrawTextApp(ui, resText, (int)(contentArea.x + (w-resSz.x)/2), y + 13, 14, COLOR_ACCENT);
+        y += 55;
+
+        DrawLine((int)contentArea.x, y, (int)contentArea.x + w, y, (Color){60, 60, 60, 255});
+        y += 20;
+        DrawTextApp(ui, L(T_LENS), (int)contentArea.x, y, 12, COLOR_ACCENT);
+        y += 25;
+        const char* lensLabel = ts->calib.isSettingLens ? L(T_LENS_TRACING) : L(T_LENS_TRACE);
+        if (GuiButton(ui, (Rectangle){ (float)contentArea.x, (float)y, (float)w, 35 }, lensLabel)) {
+            ts->calib.isSettingLens = !ts->calib.isSettingLens;
+            ts->calib.isSettingOrigin = false;
+            ts->calib.isSettingScale = false;
+            ts->calib.isSettingPlane = false;
+        }
+        y += 45;
+        float halfW = (w - 10) / 2.0f;
+        if (GuiButton(ui, (Rectangle){ (float)contentArea.x, (float)y, halfW, 30 }, L(T_LENS_FIT))) {
+            if (Lens_Fit(&ts->calib.lens, &ts->calib.lensLines, v->width, v->height)) {
+                ts->calib.isSettingLens = false;
+                Tracking_ApplyLens(ts);
+            }
+        }
+        if (GuiButton(ui, (Rectangle){ contentArea.x + halfW + 10, (float)y, halfW, 30 }, L(T_LENS_RESET))) {
+            Lens_Reset(&ts->calib.lens);
+            LensLines_Clear(&ts->calib.lensLines);
+            Tracking_ApplyLens(ts);
+        }
+        y += 40;
+        DrawTextApp(ui, TextFormat(L(T_LENS_LINES), ts->calib.lensLines.lineCount, ts->calib.lensLines.count), (int)contentArea.x, y, 14, GRAY);
+        y += 20;
+        const char* lensText = ts->calib.lens.enabled
+            ? TextFormat("k1 %.4f  k2 %.4f  p1 %.4f  p2 %.4f", ts->calib.lens.k1, ts->calib.lens.k2, ts->calib.lens.p1, ts->calib.lens.p2)
+            : L(T_LENS_NONE);
+        DrawTextApp(ui, lensText, (int)contentArea.x, y, 14, ts->calib.lens.enabled ? COLOR_ACCENT : GRAY);
+        y += 35;
+
+        DrawLine((int)contentArea.x, y, (int)contentArea.x + w, y, (Color){60, 60, 60, 255});
+        y += 20;
+        DrawTextApp(ui, L(T_PLANE), (int)contentArea.x, y, 12, COLOR_ACCENT);
+        y += 25;
+        const char* planeLabel = ts->calib.isSettingPlane ? TextFormat(L(T_PLANE_CLICK), ts->calib.planeStep + 1) : L(T_PLANE_DEFINE);
+        if (GuiButton(ui, (Rectangle){ (float)contentArea.x, (float)y, (float)w, 35 }, planeLabel)) {
+            ts->calib.isSettingPlane = !ts->calib.isSettingPlane;
+            ts->calib.isSettingOrigin = false;
+            ts->calib.isSettingScale = false;
+            ts->calib.isSettingLens = false;
+            if (ts->calib.isSettingPlane) ts->calib.planeStep = 0;
+        }
+        y += 50;
+        DrawTextApp(ui, L(T_PLANE_WIDTH), (int)contentArea.x, y + 8, 14, GRAY);
+        GuiFloatInput(ui, (Rectangle){ (float)(contentArea.x + w - inputW), (float)y, inputW, 30 }, &ts->calib.planeWidth, "m");
+        y += 40;
+        DrawTextApp(ui, L(T_PLANE_HEIGHT), (int)contentArea.x, y + 8, 14, GRAY);
+        GuiFloatInput(ui, (Rectangle){ (float)(contentArea.x + w - inputW), (float)y, inputW, 30 }, &ts->calib.planeHeight, "m");
+        y += 45;
+        bool hasPlane = Tracking_HasPlane(ts);
+        const char* planeStatus = hasPlane ? L(T_PLANE_ACTIVE) : (ts->calib.planeStep == 4 ? L(T_PLANE_INVALID) : L(T_PLANE_NONE));
+        DrawTextApp(ui, planeStatus, (int)contentArea.x, y + 8, 14, hasPlane ? COLOR_ACCENT : GRAY);
+        float clearW = 100;
+        if (ts->calib.planeStep > 0 && GuiButton(ui, (Rectangle){ contentArea.x + w - clearW, (float)y, clearW, 30 }, L(T_LENS_RESET))) {
+            ts->calib.planeStep = 0;
+            ts->calib.isSettingPlane = false;
+        }
+        y += 40;
+
+        EndScissorMode();
+        ui->widgetClip = (Rectangle){ 0 };
+        float contentHeight = y + ui->calibScrollOffset - contentArea.y;
+        float maxScroll = fmaxf(0.0f, contentHeight - contentArea.height);
+        if (ui->calibScrollOffset > maxScroll) ui->calibScrollOffset = maxScroll;
     }
     else if (ui->activeTab == TAB_INFO) {
-        if (!v->isLoaded) {
+        // Les métadonnées sont affichées dès que le worker d'ouverture les a publiées.
+        if (!v->isLoaded && v->loadState != VIDEO_LOAD_METADATA) {
             DrawTextApp(ui, L(T_NO_FILE), (int)contentArea.x, (int)contentArea.y + 20, 16, GRAY);
             return;
         }
@@ -195,7 +276,39 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         y += UI_PADDING_MD;
         DrawInfoRow(ui, L(T_RES), TextFormat("%d x %d", v->width, v->height), (int)contentArea.x, y, w);
         y += spacing;
-        DrawInfoRow(ui, L(T_FPS), TextFormat("%.2f fps", v->fps), (int)contentArea.x, y, w);
+        if (v->isLoaded) {
+            bool fullFrame = VideoCrop_IsFull(&v->crop, v->width, v->height);
+            const char* cropText = fullFrame ? L(T_CROP_RESET)
+                                             : TextFormat("%d x %d (%d, %d)", v->crop.width, v->crop.height, v->crop.x, v->crop.y);
+            DrawInfoRow(ui, L(T_CROP_ZONE), cropText, (int)contentArea.x, y, w);
+            y += spacing - 5;
+            float halfW = (w - 10) / 2.0f;
+            const char* defineLabel = ui->isSettingCrop ? "..." : L(T_CROP_DEFINE);
+            if (GuiButton(ui, (Rectangle){ (float)contentArea.x, (float)y, halfW, 26 }, defineLabel)) {
+                ui->isSettingCrop = !ui->isSettingCrop;
+                ui->isDraggingCrop = false;
+                // La zone se trace sur l'image complète.
+                if (ui->isSettingCrop && !fullFrame) Video_SetCrop(v, (Rectangle){ 0 });
+            }
+            if (GuiButton(ui, (Rectangle){ contentArea.x + halfW + 10, (float)y, halfW, 26 }, L(T_CROP_RESET))) {
+                ui->isSettingCrop = false;
+                Video_SetCrop(v, (Rectangle){ 0 });
+            }
+            y += spacing;
+        }
+        if (v->sequence) {
+            // Une suite d'images n'a pas de cadence : c'est l'utilisateur qui la fournit.
+            float *fps = &ui->sequenceFpsEdit;
+            if (!(ui->isEditingDist && ui->distEditTarget == fps)) *fps = (float)v->fps;
+            DrawTextApp(ui, L(T_FPS), (int)contentArea.x, y, 14, GRAY);
+            float inputW = 100;
+            GuiFloatInput(ui, (Rectangle){ (float)(contentArea.x + w - inputW), (float)y - 6, inputW, 26 }, fps, "fps");
+            if (!(ui->isEditingDist && ui->distEditTarget == fps) && *fps > 0.0f && *fps != (float)v->fps) {
+                Video_SetSequenceFps(v, *fps);
+            }
+        } else {
+            DrawInfoRow(ui, L(T_FPS), TextFormat("%.2f fps", v->fps), (int)contentArea.x, y, w);
+        }
         y += spacing;
         DrawInfoRow(ui, L(T_DURATION), TextFormat("%.2f s", v->durationSec), (int)contentArea.x, y, w);
         y += spacing;
@@ -207,6 +320,14 @@ void DrawRightPanel(struct UIState *ui, struct TrackingSystem *ts, struct VideoE
         DrawInfoRow(ui,L(T_CODEC), v->codecName, (int)contentArea.x, y, w);
         y += spacing;
         DrawInfoRow(ui,L(T_PIXELS), v->pixelFormat, (int)contentArea.x, y, w);
+        y += spacing;
+        DrawInfoRow(ui,L(T_DISCARDED), TextFormat("%lld (%.1f Mo)", v->discardedPackets, v->discardedBytes / (1024.0 * 1024.0)), (int)contentArea.x, y, w);
+        y += spacing;
+        DrawInfoRow(ui,L(T_GPU_UPLOAD), TextFormat("%.2f ms (max %.2f)", v->uploadAvgMs, v->uploadMaxMs), (int)contentArea.x, y, w);
+        y += spacing - 10;
+        bool doubleBuffer = !v->directUpload;
+        DrawCheckbox(ui, L(T_DOUBLE_BUFFER), &doubleBuffer, (int)contentArea.x, y);
+        Video_SetDirectUpload(v, !doubleBuffer);
     }
     DrawLine(commonArea.x, commonArea.y, commonArea.x + commonArea.width, commonArea.y, (Color){60,60,60,255});
     DrawCommonSettingsWithTS(ui, ts, tracker, commonArea);
@@ -293,11 +414,21 @@ void DrawBottomBar(struct UIState *ui, struct VideoEngine *v, Rectangle videoAre
 
     float iconSize = 24.0f;
     float spacing = 20.0f;
-    float totalControlsWidth = (iconSize * 3) + (spacing * 2);
+    float totalControlsWidth = (iconSize * 4) + (spacing * 3);
     
     float startX = barRect.x + (barRect.width - totalControlsWidth) / 2.0f;
     float centerY = barRect.y + 25.0f;
 
+    Rectangle reverseRect = { startX, centerY - iconSize/2, iconSize, iconSize };
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), reverseRect)) {
+        Video_TogglePlayReverse(v);
+    }
+    bool reversing = v->isPlaying && v->isReversing;
+    Texture2D reverseIcon = reversing ? ui->iconPause : ui->iconPlay;
+    float reverseSrcW = reversing ? (float)reverseIcon.width : -(float)reverseIcon.width;
+    DrawTexturePro(reverseIcon, (Rectangle){0,0,reverseSrcW, reverseIcon.height}, reverseRect, (Vector2){0,0}, 0.0f, WHITE);
+    startX += iconSize + spacing;
+
     Rectangle prevRect = { startX, centerY - iconSize/2, iconSize, iconSize };
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), prevRect)) {
         Video_PrevFrame(v);
@@ -309,7 +440,7 @@ void DrawBottomBar(struct UIState *ui, struct VideoEngine *v, Rectangle videoAre
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), playRect)) {
         Video_TogglePlay(v);
     }
-    Texture2D currentIcon = v->isPlaying ? ui->iconPause : ui->iconPlay;
+    Texture2D currentIcon = (v->isPlaying && !v->isReversing) ? ui->iconPause : ui->iconPlay;
     DrawTexturePro(currentIcon, (Rectangle){0,0,currentIcon.width, currentIcon.height}, playRect, (Vector2){0,0}, 0.0f, WHITE);
 
     Rectangle nextRect = { startX + (iconSize + spacing) * 2, centerY - iconSize/2, iconSize, iconSize };
@@ -319,6 +450,12 @@ void DrawBottomBar(struct UIState *ui, struct VideoEngine *v, Rectangle videoAre
     }
     DrawTexturePro(ui->iconNext, (Rectangle){0,0,ui->iconNext.width, ui->iconNext.height}, nextRect, (Vector2){0,0}, 0.0f, WHITE);
 
+    const char* speedLabel = (v->playbackSpeed >= 1.0) ? TextFormat("x%g", v->playbackSpeed)
+                                                       : TextFormat("x1/%d", (int)(1.0 / v->playbackSpeed + 0.5));
+    Rectangle speedRect = { barRect.x + 15, centerY - 12, 60, 24 };
+    if (GuiButton(ui, speedRect, speedLabel)) Video_StepPlaybackSpeed(v, 1);
+    if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), speedRect)) Video_StepPlaybackSpeed(v, -1);
+
 
     float sliderMargin = 10.0f;
     float sliderY = barRect.y + 55.0f;
@@ -328,14 +465,18 @@ void DrawBottomBar(struct UIState *ui, struct VideoEngine *v, Rectangle videoAre
     DrawRectangleRounded((Rectangle){barRect.x + sliderMargin, sliderY, sliderW, sliderH}, 1.0f, 4, (Color){60,60,60,255});
 
     static bool isDraggingTimeline = false;
+    static double scrubTarget = 0.0;
     Rectangle hitBoxSlider = { barRect.x + sliderMargin, sliderY - 15, sliderW, 35 };
 
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), hitBoxSlider)) {
         isDraggingTimeline = true;
         v->isPlaying = false;
+        Video_SetDecodeQuality(v, VIDEO_QUALITY_SCRUB);
     }
-    if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+    if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON) && isDraggingTimeline) {
         isDraggingTimeline = false;
+        Video_SetDecodeQuality(v, VIDEO_QUALITY_FULL);
+        Video_Seek(v, scrubTarget);
     }
 
     if (isDraggingTimeline) {
@@ -346,7 +487,11 @@ void DrawBottomBar(struct UIState *ui, struct VideoEngine *v, Rectangle videoAre
         if (ratio < 0.0f) ratio = 0.0f;
         if (ratio > 1.0f) ratio = 1.0f;
         
-        Video_Seek(v, ratio * v->durationSec);
+        double target = ratio * v->durationSec;
+        if (target != scrubTarget || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            scrubTarget = target;
+            Video_Seek(v, scrubTarget);
+        }
     }
 
     double frameDuration = (v->fps > 0) ? (1.0 / v->fps) : 0.0;
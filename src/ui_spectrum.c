@@ -0,0 +1,232 @@
+#include "ui_spectrum.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "theme.h"
+#include "ui_panels.h"
+#include "lang.h"
+
+#define SPECTRUM_DB_RANGE 80.0f
+
+static const TextID windowLabels[SPECTRUM_WINDOW_COUNT] = { T_SPEC_RECT, T_SPEC_HANN, T_SPEC_HAMMING, T_SPEC_BLACKMAN };
+
+void InitSpectrumSystem(SpectrumState *state) {
+    int sw = GetScreenWidth(); int sh = GetScreenHeight();
+    *state = (SpectrumState){ 0 };
+    state->bounds = (Rectangle){ (float)sw/2 - 380, (float)sh/2 - 250, 760, 500 };
+    state->useY = true;
+    state->window = SPECTRUM_HANN;
+    state->pad = 2;
+    state->logScale = false;
+    state->viewMaxFreq = 0.0f;
+    state->engine = SpectrumEngine_Create();
+    state->t = (float *)malloc(MAX_POINTS * sizeof(float));
+    state->v = (float *)malloc(MAX_POINTS * sizeof(float));
+}
+
+void UnloadSpectrumSystem(SpectrumState *state) {
+    SpectrumEngine_Destroy(state->engine);
+    state->engine = NULL;
+    free(state->t);
+    free(state->v);
+    state->t = state->v = NULL;
+}
+
+// Envoie la série au thread de calcul quand les points ou les réglages ont changé.
+static void SpectrumSubmit(SpectrumState *state, TrackingSystem *ts) {
+    if (!state->engine || !state->t || !state->v) return;
+    int key = (state->useY ? 1 : 0) | ((int)state->window << 1) | (state->pad << 4);
+    if (state->submitted && state->seenRevision == ts->revision && state->seenStart == ts->startFrame && state->seenKey == key) return;
+
+    int start = ts->startFrame;
+    int count = ts->count - start;
+    if (count < 0) count = 0;
+    double t0 = (count > 0) ? ts->points[start].time : 0.0;
+    for (int k = 0; k < count; k++) {
+        int i = start + k;
+        state->t[k] = (float)(ts->points[i].time - t0);
+        state->v[k] = state->useY ? ts->physY[i] : ts->physX[i];
+    }
+    SpectrumEngine_Submit(state->engine, state->window, state->pad, state->useY ? 1 : 0, state->t, state->v, count);
+
+    state->submitted = true;
+    state->seenRevision = ts->revision;
+    state->seenStart = ts->startFrame;
+    state->seenKey = key;
+}
+
+static float SpectrumLevel(const SpectrumState *state, float amp, float maxAmp) {
+    if (!state->logScale) return amp;
+    float db = (amp > 0.0f && maxAmp > 0.0f) ? 20.0f * log10f(amp / maxAmp) : -SPECTRUM_DB_RANGE;
+    return (db < -SPECTRUM_DB_RANGE) ? -SPECTRUM_DB_RANGE : db;
+}
+
+static void DrawSpectrumPlot(UIState *ui, SpectrumState *state, const SpectrumResult *r, Rectangle body) {
+    Color bg = (Color){25, 25, 25, 255};
+    Color lineColor = COLOR_CYAN;
+    Vector2 mouse = GetMousePosition();
+
+    double nyquist = r->sampleRate * 0.5;
+    double minSpan = 4.0 * r->df;
+    if (CheckCollisionPointRec(mouse, body)) {
+        float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f) {
+            double fMax = (state->viewMaxFreq > 0.0f) ? state->viewMaxFreq : nyquist;
+            fMax *= powf(0.8f, wheel);
+            if (fMax < minSpan) fMax = minSpan;
+            state->viewMaxFreq = (fMax >= nyquist) ? 0.0f : (float)fMax;
+        }
+        if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) state->viewMaxFreq = 0.0f;
+    }
+    double fMax = (state->viewMaxFreq > 0.0f && state->viewMaxFreq < nyquist) ? state->viewMaxFreq : nyquist;
+
+    int kEnd = (int)ceil(fMax / r->df);
+    if (kEnd > r->bins - 1) kEnd = r->bins - 1;
+    if (kEnd < 1) return;
+
+    // Référence hors composante continue : la tendance retirée la laisse proche de zéro.
+    float maxAmp = 0.0f;
+    for (int k = 1; k <= kEnd; k++) if (r->amp[k] > maxAmp) maxAmp = r->amp[k];
+    if (maxAmp <= 0.0f) maxAmp = 1.0f;
+    float loY = state->logScale ? -SPECTRUM_DB_RANGE : 0.0f;
+    float hiY = state->logScale ? 5.0f : maxAmp * 1.1f;
+
+    DrawRectangleRec(body, bg);
+
+    int gridDivs = 6;
+    for (int i = 0; i <= gridDivs; i++) {
+        float g = (float)i / gridDivs;
+        float gx = body.x + g * body.width;
+        float gy = body.y + body.height - g * body.height;
+        DrawLineV((Vector2){ gx, body.y }, (Vector2){ gx, body.y + body.height }, (Color){60, 60, 60, 255});
+        DrawLineV((Vector2){ body.x, gy }, (Vector2){ body.x + body.width, gy }, (Color){60, 60, 60, 255});
+    }
+    for (int i = 0; i <= gridDivs; i += 2) {
+        float g = (float)i / gridDivs;
+        const char *lblX = TextFormat("%.2f Hz", g * fMax);
+        const char *lblY = state->logScale ? TextFormat("%.0f dB", loY + g * (hiY - loY)) : TextFormat("%.3g", loY + g * (hiY - loY));
+        DrawTextEx(ui->appFont, lblX, (Vector2){ body.x + g * body.width + 2, body.y + body.height - 15 }, 10, 1.0f, GRAY);
+        DrawTextEx(ui->appFont, lblY, (Vector2){ body.x + 5, body.y + body.height - g * body.height - 12 }, 10, 1.0f, GRAY);
+    }
+
+    BeginScissorMode((int)body.x, (int)body.y, (int)body.width, (int)body.height);
+    // Peu de raies : segments raie à raie ; sinon le maximum de chaque colonne,
+    // pour qu'un pic étroit ne disparaisse pas entre deux pixels.
+    int visible = kEnd + 1;
+    int columns = (int)body.width;
+    float scaleX = body.width / (float)fMax;
+    float scaleY = body.height / (hiY - loY);
+    if (visible <= 2 * columns) {
+        Vector2 prev = { 0 };
+        for (int k = 0; k <= kEnd; k++) {
+            Vector2 p = { body.x + (float)(k * r->df) * scaleX, body.y + body.height - (SpectrumLevel(state, r->amp[k], maxAmp) - loY) * scaleY };
+            if (k > 0) DrawLineEx(prev, p, 1.5f, lineColor);
+            prev = p;
+        }
+    } else {
+        Vector2 prev = { 0 };
+        for (int c = 0; c < columns; c++) {
+            int k0 = (int)((long long)c * visible / columns);
+            int k1 = (int)((long long)(c + 1) * visible / columns);
+            float peak = 0.0f;
+            for (int k = k0; k < k1; k++) if (r->amp[k] > peak) peak = r->amp[k];
+            Vector2 p = { body.x + c + 0.5f, body.y + body.height - (SpectrumLevel(state, peak, maxAmp) - loY) * scaleY };
+            if (c > 0) DrawLineEx(prev, p, 1.5f, lineColor);
+            prev = p;
+        }
+    }
+
+    if (r->peakFreq > 0.0 && r->peakFreq <= fMax) {
+        float px = body.x + (float)r->peakFreq * scaleX;
+        DrawLineV((Vector2){ px, body.y }, (Vector2){ px, body.y + body.height }, Fade(COLOR_ACCENT, 0.6f));
+        DrawTextEx(ui->appFont, TextFormat("%.3f Hz", r->peakFreq), (Vector2){ px + 5, body.y + 8 }, 15, 1.0f, COLOR_ACCENT);
+    }
+    EndScissorMode();
+
+    if (CheckCollisionPointRec(mouse, body)) {
+        double f = (mouse.x - body.x) / scaleX;
+        int k = (int)lround(f / r->df);
+        if (k > kEnd) k = kEnd;
+        float level = SpectrumLevel(state, r->amp[k], maxAmp);
+        Vector2 target = { body.x + (float)(k * r->df) * scaleX, body.y + body.height - (level - loY) * scaleY };
+        DrawLine((int)target.x, (int)body.y, (int)target.x, (int)(body.y + body.height), Fade(WHITE, 0.2f));
+        DrawCircleV(target, 4.0f, WHITE);
+
+        const char *tip = (k > 0) ? TextFormat("f: %.4f Hz\nT: %.4f s\nA: %.4g", k * r->df, 1.0 / (k * r->df), r->amp[k])
+                                  : TextFormat("f: 0 Hz\nA: %.4g", r->amp[k]);
+        float tipSize = 16.0f, pad = 8.0f;
+        Vector2 sz = MeasureTextEx(ui->appFont, tip, tipSize, 1.0f);
+        Rectangle badge = { target.x + 12, body.y + 30, sz.x + 2 * pad, sz.y + 2 * pad };
+        if (badge.x + badge.width > body.x + body.width) badge.x = target.x - badge.width - 12;
+        DrawRectangleRec(badge, bg);
+        DrawRectangleLinesEx(badge, 1.5f, lineColor);
+        DrawTextEx(ui->appFont, tip, (Vector2){ badge.x + pad, badge.y + pad }, tipSize, 1.0f, WHITE);
+    }
+}
+
+void DrawSpectrumWindow(UIState *ui, SpectrumState *state, TrackingSystem *ts) {
+    if (!ui->showSpectrumWindow) return;
+
+    DrawRectangleRec(state->bounds, (Color){35, 35, 35, 255});
+    DrawRectangleLinesEx(state->bounds, 1, (Color){60, 60, 60, 255});
+
+    Rectangle header = { state->bounds.x, state->bounds.y, state->bounds.width, 35 };
+    Rectangle closeBtn = { state->bounds.x + state->bounds.width - 35, state->bounds.y, 35, 35 };
+    Vector2 mouse = GetMousePosition();
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, header) && !CheckCollisionPointRec(mouse, closeBtn)) {
+        state->isDragging = true; state->dragOffset = (Vector2){ mouse.x - state->bounds.x, mouse.y - state->bounds.y };
+    }
+    if (state->isDragging) {
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) { state->bounds.x = mouse.x - state->dragOffset.x; state->bounds.y = mouse.y - state->dragOffset.y; }
+        else state->isDragging = false;
+    }
+    DrawRectangleRec(header, (Color){45, 45, 45, 255});
+    DrawTextEx(ui->appFont, L(T_SPEC_WINDOW_TITLE), (Vector2){state->bounds.x + 12, state->bounds.y + 8}, 16, 1.0f, LIGHTGRAY);
+    if (GuiButton(ui, closeBtn, "X")) ui->showSpectrumWindow = false;
+
+    float startX = state->bounds.x + 15;
+    float startY = state->bounds.y + 45;
+    const char *signalLabels[2] = { "x(t)", "y(t)" };
+    for (int i = 0; i < 2; i++) {
+        Rectangle btnRect = { startX + i * 75, startY, 70, 30 };
+        bool isActive = (state->useY == (i == 1));
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mouse, btnRect)) state->useY = (i == 1);
+        DrawRectangleRounded(btnRect, 0.3f, 4, isActive ? COLOR_ACCENT : (Color){50, 50, 50, 255});
+        Vector2 txtSz = MeasureTextEx(ui->appFont, signalLabels[i], 15, 1.0f);
+        DrawTextEx(ui->appFont, signalLabels[i], (Vector2){ btnRect.x + (70 - txtSz.x) / 2, btnRect.y + (30 - txtSz.y) / 2 }, 15, 1.0f, WHITE);
+    }
+
+    float ctrlX = startX + 165;
+    if (GuiButton(ui, (Rectangle){ ctrlX, startY, 210, 28 }, L(windowLabels[state->window]))) {
+        state->window = (SpectrumWindow)((state->window + 1) % SPECTRUM_WINDOW_COUNT);
+    }
+    ctrlX += 220;
+    if (GuiButton(ui, (Rectangle){ ctrlX, startY, 28, 28 }, "-") && state->pad > 1) state->pad /= 2;
+    DrawTextEx(ui->appFont, TextFormat(L(T_SPEC_PADDING), state->pad), (Vector2){ ctrlX + 36, startY + 6 }, 15, 1.0f, LIGHTGRAY);
+    if (GuiButton(ui, (Rectangle){ ctrlX + 120, startY, 28, 28 }, "+") && state->pad < SPECTRUM_MAX_PAD) state->pad *= 2;
+    if (GuiButton(ui, (Rectangle){ state->bounds.x + state->bounds.width - 160, startY, 145, 28 }, state->logScale ? L(T_SPEC_SCALE_DB) : L(T_SPEC_SCALE_LIN))) {
+        state->logScale = !state->logScale;
+    }
+
+    if (ts->count > 0) Tracking_UpdatePhysical(ts);
+    SpectrumSubmit(state, ts);
+    const SpectrumResult *r = SpectrumEngine_Result(state->engine);
+    if (r && r->key != (state->useY ? 1 : 0)) r = NULL;
+
+    Rectangle body = { state->bounds.x + 50, state->bounds.y + 90, state->bounds.width - 70, state->bounds.height - 165 };
+    if (!r) {
+        DrawRectangleRec(body, (Color){25, 25, 25, 255});
+        const char *msg = SpectrumEngine_IsBusy(state->engine) ? L(T_FIT_PENDING) : L(T_SPEC_NO_DATA);
+        Vector2 sz = MeasureTextEx(ui->appFont, msg, 18, 1.0f);
+        DrawTextEx(ui->appFont, msg, (Vector2){ body.x + (body.width - sz.x) / 2, body.y + (body.height - sz.y) / 2 }, 18, 1.0f, GRAY);
+    } else {
+        DrawSpectrumPlot(ui, state, r, body);
+        float infoY = body.y + body.height + 12;
+        if (r->peakFreq > 0.0) {
+            DrawTextEx(ui->appFont, TextFormat(L(T_SPEC_PEAK), r->peakFreq, 1.0 / r->peakFreq, r->peakAmp), (Vector2){ startX, infoY }, 16, 1.0f, WHITE);
+        }
+        DrawTextEx(ui->appFont, TextFormat(L(T_SPEC_GRID), r->sampleRate, r->samples, r->fftSize, r->df), (Vector2){ startX, infoY + 24 }, 15, 1.0f, LIGHTGRAY);
+    }
+    DrawRectangleLinesEx(body, 1, (Color){80, 80, 80, 255});
+}
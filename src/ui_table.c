@@ -9,15 +9,23 @@
 #include <stdio.h>
 #include <math.h>
 #include "lang.h"
+#include "derived.h"
 
 bool GuiButton(struct UIState *ui, Rectangle bounds, const char* text);
 
 void DrawMeasurementTable(struct UIState *ui, struct TrackingSystem *ts, struct VideoEngine *v, Rectangle bounds) {
     DrawRectangleRec(bounds, (Color){30, 30, 30, 255});
+    Tracking_UpdatePhysical(ts);
     
     int headerH = 30;
     int rowH = 25;
-    int colW = bounds.width / 3;
+
+    // Une grandeur dérivée en 4e colonne ; un clic sur son en-tête passe à la suivante.
+    DerivedSet *derived = ui->derived;
+    int derivedCount = derived ? derived->count : 0;
+    if (ui->tableDerived >= derivedCount) ui->tableDerived = 0;
+    int colCount = (derivedCount > 0) ? 4 : 3;
+    int colW = bounds.width / colCount;
 
     DrawRectangle(bounds.x, bounds.y, bounds.width, headerH, (Color){45, 45, 45, 255});
     
@@ -26,6 +34,16 @@ void DrawMeasurementTable(struct UIState *ui, struct TrackingSystem *ts, struct
     DrawTextEx(font, "t (s)", (Vector2){bounds.x + 10, bounds.y + 8}, 14, 1, hColor);
     DrawTextEx(font, "x (m)", (Vector2){bounds.x + colW + 10, bounds.y + 8}, 14, 1, hColor);
     DrawTextEx(font, "y (m)", (Vector2){bounds.x + colW*2 + 10, bounds.y + 8}, 14, 1, hColor);
+    const float *derivedValues = NULL;
+    if (derivedCount > 0) {
+        Rectangle derivedHeader = { bounds.x + colW*3, bounds.y, bounds.width - colW*3, headerH };
+        bool hover = CheckCollisionPointRec(GetMousePosition(), derivedHeader);
+        if (hover && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) ui->tableDerived = (ui->tableDerived + 1) % derivedCount;
+        BeginScissorMode((int)derivedHeader.x, (int)derivedHeader.y, (int)derivedHeader.width, (int)derivedHeader.height);
+        DrawTextEx(font, derived->columns[ui->tableDerived].name, (Vector2){derivedHeader.x + 10, bounds.y + 8}, 14, 1, hover ? COLOR_ACCENT : hColor);
+        EndScissorMode();
+        derivedValues = Derived_Values(derived, ui->tableDerived);
+    }
 
     Rectangle contentRect = { bounds.x, bounds.y + headerH, bounds.width, bounds.height - headerH };
     
@@ -98,9 +116,9 @@ void DrawMeasurementTable(struct UIState *ui, struct TrackingSystem *ts, struct
         DrawRectangleRec(rowRect, rowColor);
 
         double t = i * (1.0 / v->fps);
-        char tStr[32], xStr[32], yStr[32];
+        char tStr[32], xStr[32], yStr[32], dStr[32];
         sprintf(tStr, "%.3f", t);
-        sprintf(xStr, "-"); sprintf(yStr, "-");
+        sprintf(xStr, "-"); sprintf(yStr, "-"); sprintf(dStr, "-");
 
         int foundPt = -1;
         for(int k=0; k<ts->count; k++) {
@@ -109,31 +127,27 @@ void DrawMeasurementTable(struct UIState *ui, struct TrackingSystem *ts, struct
 
         if (foundPt != -1) {
             Vector2 rawPx = ts->points[foundPt].pixelPos;
-            if (ts->calib.hasOriginSet && ts->calib.pxPerMeter > 0) {
-                float pxPerM = ts->calib.pxPerMeter;
-                float dxPx = rawPx.x - ts->calib.origin.x;
-                float dyPx = rawPx.y - ts->calib.origin.y;
-                int dirX = (ts->calib.config == AXIS_X_RIGHT_Y_UP || ts->calib.config == AXIS_X_RIGHT_Y_DOWN) ? 1 : -1;
-                int dirY = (ts->calib.config == AXIS_X_RIGHT_Y_DOWN || ts->calib.config == AXIS_X_LEFT_Y_DOWN) ? 1 : -1;
-                
-                float valX = (dxPx * dirX) / pxPerM;
-                float valY = (dyPx * dirY) / pxPerM;
-
-                sprintf(xStr, "%.3f", valX);
-                sprintf(yStr, "%.3f", valY);
+            if (Tracking_IsCalibrated(ts)) {
+                sprintf(xStr, "%.3f", ts->physX[foundPt]);
+                sprintf(yStr, "%.3f", ts->physY[foundPt]);
             } else {
                 sprintf(xStr, "%.0f", rawPx.x);
                 sprintf(yStr, "%.0f", rawPx.y);
             }
+            if (derivedValues && foundPt >= derived->first && foundPt < derived->end) {
+                snprintf(dStr, sizeof(dStr), "%.4g", derivedValues[foundPt]);
+            }
         }
 
         Color txtColor = isDisabled ? (Color){100, 100, 100, 255} : WHITE;
         DrawTextEx(font, tStr, (Vector2){bounds.x + 10, y+6}, 14, 1, txtColor);
         DrawTextEx(font, xStr, (Vector2){bounds.x + colW + 10, y+6}, 14, 1, txtColor);
         DrawTextEx(font, yStr, (Vector2){bounds.x + colW*2 + 10, y+6}, 14, 1, txtColor);
+        if (colCount == 4) DrawTextEx(font, dStr, (Vector2){bounds.x + colW*3 + 10, y+6}, 14, 1, txtColor);
 
         DrawLine(bounds.x + colW, y, bounds.x + colW, y+rowH, (Color){60,60,60,255});
         DrawLine(bounds.x + colW*2, y, bounds.x + colW*2, y+rowH, (Color){60,60,60,255});
+        if (colCount == 4) DrawLine(bounds.x + colW*3, y, bounds.x + colW*3, y+rowH, (Color){60,60,60,255});
         
         if (CheckCollisionPointRec(GetMousePosition(), rowRect) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !ui->isDraggingTableScroll) {
             Video_Seek(v, t);
@@ -218,7 +232,7 @@ void DrawCommonSettingsWithTS(struct UIState *ui, struct TrackingSystem *ts, str
     int startX = x + textWidth + 15; 
 
     if (GuiButton(ui, (Rectangle){(float)startX, (float)y, 25, 25}, "<")) {
-        if (ts->startFrame > 0) ts->startFrame--;
+        if (ts->startFrame > 0) { ts->startFrame--; Tracking_MarkEdited(ts); }
     }
     
     const char* valStr = TextFormat("%02d", ts->startFrame);
@@ -226,5 +240,6 @@ void DrawCommonSettingsWithTS(struct UIState *ui, struct TrackingSystem *ts, str
     
     if (GuiButton(ui, (Rectangle){(float)startX + 60, (float)y, 25, 25}, ">")) {
         ts->startFrame++;
+        Tracking_MarkEdited(ts);
     }
 }
\ No newline at end of file
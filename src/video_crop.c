@@ -0,0 +1,37 @@
+#include "video_crop.h"
+
+VideoCrop VideoCrop_Make(float x, float y, float width, float height, int frameW, int frameH) {
+    VideoCrop crop = { 0, 0, frameW, frameH };
+    if (width <= 0.0f || height <= 0.0f) return crop;
+
+    int x0 = (int)x & ~1;
+    int y0 = (int)y & ~1;
+    int x1 = ((int)(x + width) + 1) & ~1;
+    int y1 = ((int)(y + height) + 1) & ~1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > frameW) x1 = frameW;
+    if (y1 > frameH) y1 = frameH;
+    if (x1 - x0 < 16 || y1 - y0 < 16) return crop;
+
+    crop.x = x0;
+    crop.y = y0;
+    crop.width = x1 - x0;
+    crop.height = y1 - y0;
+    return crop;
+}
+
+bool VideoCrop_IsFull(const VideoCrop *crop, int frameW, int frameH) {
+    return crop->x == 0 && crop->y == 0 && crop->width == frameW && crop->height == frameH;
+}
+
+bool VideoCrop_Apply(const VideoCrop *crop, AVFrame *frame) {
+    if (VideoCrop_IsFull(crop, frame->width, frame->height)) return true;
+    if (crop->x + crop->width > frame->width || crop->y + crop->height > frame->height) return false;
+
+    frame->crop_left = crop->x;
+    frame->crop_top = crop->y;
+    frame->crop_right = frame->width - crop->x - crop->width;
+    frame->crop_bottom = frame->height - crop->y - crop->height;
+    return av_frame_apply_cropping(frame, AV_FRAME_CROP_UNALIGNED) >= 0;
+}
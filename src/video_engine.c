@@ -1,7 +1,13 @@
 #include "video_engine.h"
+#include "video_reverse.h"
+#include "job_system.h"
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+static void Video_SeekDecoder(VideoEngine *v, double targetTime);
+
 
 double GetRawFrameTime(VideoEngine *v) {
     int64_t ts = v->frame->best_effort_timestamp;
@@ -28,48 +34,167 @@ double GetRelativeFrameTime(VideoEngine *v) {
 }
 
 
+// Envoi de v->buffer vers le GPU. En mode double tampon, l'image est écrite dans la
+// texture qui n'est pas affichée : glTexSubImage2D n'attend plus la fin des tracés
+// qui lisent encore l'image précédente. La durée de l'appel est mesurée dans les deux modes.
+static void Video_UploadFrame(VideoEngine *v) {
+    double start = GetTime();
+    if (v->directUpload) {
+        UpdateTexture(v->texture, v->buffer);
+    } else {
+        v->uploadIndex = (v->uploadIndex + 1) % VIDEO_UPLOAD_TEXTURES;
+        UpdateTexture(v->uploadTextures[v->uploadIndex], v->buffer);
+        v->texture = v->uploadTextures[v->uploadIndex];
+    }
+    double elapsedMs = (GetTime() - start) * 1000.0;
+
+    v->uploadLastMs = elapsedMs;
+    v->uploadAvgMs = (v->uploadAvgMs > 0.0) ? v->uploadAvgMs * 0.9 + elapsedMs * 0.1 : elapsedMs;
+    if (elapsedMs > v->uploadMaxMs) v->uploadMaxMs = elapsedMs;
+}
+
+
 void Video_ProcessFrame(VideoEngine *v) {
     if (!v->frame->data[0] || v->frame->width <= 0 || v->frame->height <= 0) return;
 
+    VideoCrop_Apply(&v->crop, v->frame);
     v->swsCtx = sws_getCachedContext(v->swsCtx,
         v->frame->width, v->frame->height, v->frame->format,
-        v->width, v->height, AV_PIX_FMT_RGB24,
+        v->crop.width, v->crop.height, AV_PIX_FMT_RGB24,
         SWS_BILINEAR, NULL, NULL, NULL);
 
     if (v->swsCtx) {
         sws_scale(v->swsCtx, (const uint8_t *const *)v->frame->data, v->frame->linesize, 
                   0, v->frame->height, v->frameRGB->data, v->frameRGB->linesize);
-        UpdateTexture(v->texture, v->buffer);
+        Video_UploadFrame(v);
     }
     
     v->currentTime = GetRelativeFrameTime(v);
 }
 
 
-bool Video_DecodeAndDisplayOne(VideoEngine *v) {
-    if (!v->isLoaded) return false;
-    
-    while (av_read_frame(v->formatCtx, v->packet) >= 0) {
+// Premier paquet du flux dont la position dans le fichier est >= pos.
+static int Video_IndexLowerBound(AVStream *st, int count, int64_t pos) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (avformat_index_get_entry(st, mid)->pos < pos) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Les flux marqués AVDISCARD_ALL ne sont plus lus : leurs paquets situés entre deux
+// paquets vidéo sont comptés dans l'index du démuxeur (MP4, MOV, AVI...). Sans index,
+// seul l'écart d'octets entre les deux paquets est compté.
+static void Video_CountSkipped(VideoEngine *v, int64_t pos, int size) {
+    if (pos < 0) return;
+    if (v->skipScanPos >= 0 && pos > v->skipScanPos) {
+        bool indexed = false;
+        for (unsigned int i = 0; i < v->formatCtx->nb_streams; i++) {
+            AVStream *st = v->formatCtx->streams[i];
+            if ((int)i == v->videoStreamIndex || st->discard != AVDISCARD_ALL) continue;
+            int count = avformat_index_get_entries_count(st);
+            if (count <= 0) continue;
+            indexed = true;
+            for (int e = Video_IndexLowerBound(st, count, v->skipScanPos); e < count; e++) {
+                const AVIndexEntry *entry = avformat_index_get_entry(st, e);
+                if (entry->pos >= pos) break;
+                v->discardedPackets++;
+                v->discardedBytes += entry->size;
+            }
+        }
+        if (!indexed) v->discardedBytes += pos - v->skipScanPos;
+    }
+    v->skipScanPos = pos + size;
+}
+
+// Lit le prochain paquet du flux vidéo. Les paquets que certains démuxeurs renvoient
+// malgré AVDISCARD_ALL figurent aussi dans l'index : Video_CountSkipped les compte déjà.
+static int Video_ReadVideoPacket(VideoEngine *v) {
+    int ret;
+    while ((ret = av_read_frame(v->formatCtx, v->packet)) >= 0) {
         if (v->packet->stream_index == v->videoStreamIndex) {
-            if (avcodec_send_packet(v->codecCtx, v->packet) == 0) {
-                if (avcodec_receive_frame(v->codecCtx, v->frame) == 0) {
-                    
-
-                    if (v->swsCtx == NULL) {
-                         v->swsCtx = sws_getCachedContext(NULL,
-                            v->frame->width, v->frame->height, v->frame->format,
-                            v->width, v->height, AV_PIX_FMT_RGB24,
-                            SWS_BILINEAR, NULL, NULL, NULL);
-                    }
-                    if(v->swsCtx) {
-                        sws_scale(v->swsCtx, (const uint8_t *const *)v->frame->data, v->frame->linesize, 
-                                0, v->frame->height, v->frameRGB->data, v->frameRGB->linesize);
-                        UpdateTexture(v->texture, v->buffer);
-                    }
-                    
-                    av_packet_unref(v->packet);
-                    return true; 
+            Video_CountSkipped(v, v->packet->pos, v->packet->size);
+            return ret;
+        }
+        av_packet_unref(v->packet);
+    }
+    return ret;
+}
+
+
+// Ouverture en deux temps : un worker ouvre le fichier dans 'staged' et publie les
+// métadonnées dès qu'elles sont connues, puis le thread UI récupère le décodeur et crée
+// la texture (OpenGL). Le même worker prépare ensuite le décodeur arrière et le cache.
+typedef struct VideoLoader {
+    VideoEngine staged;
+    VideoEngine preview;
+    char path[512];
+    Job *job;
+    JobMutex *mutex;
+    VideoLoadState stage;
+    ReversePlayer *warmPlayer;
+    bool cancelled;
+} VideoLoader;
+
+// Permet d'interrompre avformat_open_input / find_stream_info si l'utilisateur
+// ouvre un autre fichier pendant le chargement.
+static int Video_InterruptCallback(void *opaque) {
+    VideoLoader *ld = (VideoLoader *)opaque;
+    JobMutex_Lock(ld->mutex);
+    bool cancelled = ld->cancelled;
+    JobMutex_Unlock(ld->mutex);
+    return cancelled ? 1 : 0;
+}
+
+static void Video_CopyMetadata(VideoEngine *dst, const VideoEngine *src) {
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->fps = src->fps;
+    dst->durationSec = src->durationSec;
+    dst->frameCount = src->frameCount;
+    memcpy(dst->codecName, src->codecName, sizeof(dst->codecName));
+    memcpy(dst->pixelFormat, src->pixelFormat, sizeof(dst->pixelFormat));
+}
+
+static void Video_SetStage(VideoLoader *ld, VideoLoadState stage) {
+    JobMutex_Lock(ld->mutex);
+    ld->stage = stage;
+    JobMutex_Unlock(ld->mutex);
+}
+
+static void Video_PublishMetadata(VideoLoader *ld, VideoEngine *v) {
+    JobMutex_Lock(ld->mutex);
+    Video_CopyMetadata(&ld->preview, v);
+    ld->stage = VIDEO_LOAD_METADATA;
+    JobMutex_Unlock(ld->mutex);
+}
+
+static bool Video_OpenSequence(VideoEngine *v, const char *source, VideoLoader *ld);
+
+
+// Appelé depuis le worker d'ouverture : convertit dans v->buffer sans toucher à la texture.
+static bool Video_DecodeFirstFrame(VideoEngine *v) {
+    while (Video_ReadVideoPacket(v) >= 0) {
+        if (avcodec_send_packet(v->codecCtx, v->packet) == 0) {
+            if (avcodec_receive_frame(v->codecCtx, v->frame) == 0) {
+                
+
+                VideoCrop_Apply(&v->crop, v->frame);
+                if (v->swsCtx == NULL) {
+                     v->swsCtx = sws_getCachedContext(NULL,
+                        v->frame->width, v->frame->height, v->frame->format,
+                        v->crop.width, v->crop.height, AV_PIX_FMT_RGB24,
+                        SWS_BILINEAR, NULL, NULL, NULL);
+                }
+                if(v->swsCtx) {
+                    sws_scale(v->swsCtx, (const uint8_t *const *)v->frame->data, v->frame->linesize, 
+                            0, v->frame->height, v->frameRGB->data, v->frameRGB->linesize);
                 }
+                
+                av_packet_unref(v->packet);
+                return true; 
             }
         }
         av_packet_unref(v->packet);
@@ -78,14 +203,26 @@ bool Video_DecodeAndDisplayOne(VideoEngine *v) {
 }
 
 
-bool Video_Load(VideoEngine *v, const char *filename) {
-    v->formatCtx = NULL;
+static bool Video_OpenSource(VideoEngine *v, const char *filename, VideoLoader *ld) {
+    if (ImageSequence_IsSource(filename)) return Video_OpenSequence(v, filename, ld);
+
+    v->formatCtx = avformat_alloc_context();
+    if (!v->formatCtx) return false;
+    v->formatCtx->interrupt_callback.callback = Video_InterruptCallback;
+    v->formatCtx->interrupt_callback.opaque = ld;
     if (avformat_open_input(&v->formatCtx, filename, NULL, NULL) != 0) return false;
     if (avformat_find_stream_info(v->formatCtx, NULL) < 0) return false;
 
     v->videoStreamIndex = av_find_best_stream(v->formatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
     if (v->videoStreamIndex < 0) return false;
 
+    for (unsigned int i = 0; i < v->formatCtx->nb_streams; i++) {
+        if ((int)i != v->videoStreamIndex) v->formatCtx->streams[i]->discard = AVDISCARD_ALL;
+    }
+    v->discardedPackets = 0;
+    v->discardedBytes = 0;
+    v->skipScanPos = -1;
+
     AVCodecParameters *codecParams = v->formatCtx->streams[v->videoStreamIndex]->codecpar;
     const AVCodec *codec = avcodec_find_decoder(codecParams->codec_id);
     v->codecCtx = avcodec_alloc_context3(codec);
@@ -95,6 +232,7 @@ bool Video_Load(VideoEngine *v, const char *filename) {
 
     v->width = v->codecCtx->width;
     v->height = v->codecCtx->height;
+    v->crop = VideoCrop_Make(v->cropRequest.x, v->cropRequest.y, v->cropRequest.width, v->cropRequest.height, v->width, v->height);
     
     AVStream *stream = v->formatCtx->streams[v->videoStreamIndex];
     if (stream->avg_frame_rate.den > 0) v->fps = av_q2d(stream->avg_frame_rate);
@@ -114,28 +252,24 @@ bool Video_Load(VideoEngine *v, const char *filename) {
     if (cName) strncpy(v->codecName, cName, 31);
     const char *pName = av_get_pix_fmt_name(v->codecCtx->pix_fmt);
     if (pName) strncpy(v->pixelFormat, pName, 31);
+    Video_PublishMetadata(ld, v);
 
     v->frame = av_frame_alloc();
     v->frameRGB = av_frame_alloc();
     v->packet = av_packet_alloc();
 
-    int numBytes = av_image_get_buffer_size(AV_PIX_FMT_RGB24, v->width, v->height, 32);
+    int numBytes = av_image_get_buffer_size(AV_PIX_FMT_RGB24, v->crop.width, v->crop.height, 32);
 
     v->buffer = (uint8_t *)av_malloc(numBytes); 
     if (!v->buffer) return false;
     av_image_fill_arrays(v->frameRGB->data, v->frameRGB->linesize, 
                         v->buffer, AV_PIX_FMT_RGB24, 
-                        v->width, v->height, 1); 
+                        v->crop.width, v->crop.height, 1); 
 
     v->swsCtx = NULL;
-    Image img = { v->buffer, v->width, v->height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8 };
-    v->texture = LoadTextureFromImage(img);
-    
-    v->isLoaded = true;
-    v->isPlaying = false;
     v->baseTimeOffset = 0.0; 
 
-    if (Video_DecodeAndDisplayOne(v)) {
+    if (Video_DecodeFirstFrame(v)) {
         double firstFrameRaw = GetRawFrameTime(v);
         
 
@@ -154,33 +288,409 @@ bool Video_Load(VideoEngine *v, const char *filename) {
 }
 
 
+static bool Video_DecodeNextFrame(VideoEngine *v) {
+    while (Video_ReadVideoPacket(v) >= 0) {
+        bool gotFrame = false;
+        if (avcodec_send_packet(v->codecCtx, v->packet) == 0) {
+            gotFrame = (avcodec_receive_frame(v->codecCtx, v->frame) == 0);
+        }
+        av_packet_unref(v->packet);
+        if (gotFrame) return true;
+    }
+    return false;
+}
+
+
+static long long Video_FrameIndex(VideoEngine *v, double time) {
+    return llround(time * v->fps);
+}
+
+static int Video_SequenceReadAhead(VideoEngine *v) {
+    int count = JobSystem_WorkerCount() * 2;
+    if (count < 2) count = 2;
+    int limit = FrameCache_Capacity(v->cache) / 2;
+    if (count > limit) count = limit;
+    return count;
+}
+
+// Chaque image de la suite est indépendante : accès direct, puis lecture anticipée
+// des suivantes (dans le sens de lecture) sur les workers.
+static bool Video_ShowSequenceFrame(VideoEngine *v, long long frameIdx) {
+    if (frameIdx >= v->frameCount) frameIdx = v->frameCount - 1;
+    if (frameIdx < 0) frameIdx = 0;
+
+    if (!FrameCache_Fetch(v->cache, frameIdx, v->buffer, NULL)) {
+        if (!ImageSequence_Decode(v->sequence, frameIdx, &v->crop, v->buffer)) return false;
+    }
+    Video_UploadFrame(v);
+    v->currentTime = frameIdx / v->fps;
+
+    ImageSequence_Prefetch(v->sequence, v->cache, &v->crop, frameIdx, v->isReversing ? -1 : 1, Video_SequenceReadAhead(v), v->fps);
+    return true;
+}
+
+static bool Video_OpenSequence(VideoEngine *v, const char *source, VideoLoader *ld) {
+    v->sequence = ImageSequence_Open(source);
+    if (!v->sequence) return false;
+
+    v->width = ImageSequence_Width(v->sequence);
+    v->height = ImageSequence_Height(v->sequence);
+    v->crop = VideoCrop_Make(v->cropRequest.x, v->cropRequest.y, v->cropRequest.width, v->cropRequest.height, v->width, v->height);
+    if (v->sequenceFps <= 0.0) v->sequenceFps = SEQUENCE_DEFAULT_FPS;
+    v->fps = v->sequenceFps;
+    v->frameCount = ImageSequence_Count(v->sequence);
+    v->durationSec = v->frameCount / v->fps;
+    v->baseTimeOffset = 0.0;
+    v->videoStreamIndex = -1;
+    v->discardedPackets = 0;
+    v->discardedBytes = 0;
+    v->skipScanPos = -1;
+
+    memset(v->codecName, 0, sizeof(v->codecName));
+    memset(v->pixelFormat, 0, sizeof(v->pixelFormat));
+    strncpy(v->codecName, ImageSequence_CodecName(v->sequence), 31);
+    strncpy(v->pixelFormat, ImageSequence_PixelFormat(v->sequence), 31);
+    Video_PublishMetadata(ld, v);
+
+    size_t frameBytes = (size_t)v->crop.width * v->crop.height * 3;
+    v->buffer = (uint8_t *)av_malloc(frameBytes);
+    if (!v->buffer) return false;
+    if (!ImageSequence_Decode(v->sequence, 0, &v->crop, v->buffer)) memset(v->buffer, 0, frameBytes);
+    v->currentTime = 0.0;
+    return true;
+}
+
+static void Video_UpdateSequence(VideoEngine *v) {
+    v->accumulator += GetFrameTime() * v->playbackSpeed;
+    double frameDelay = 1.0 / v->fps;
+
+    int framesDue = (int)(v->accumulator / frameDelay);
+    if (framesDue <= 0) return;
+    v->accumulator -= framesDue * frameDelay;
+
+    long long target = Video_FrameIndex(v, v->currentTime) + (v->isReversing ? -framesDue : framesDue);
+    if (target <= 0 || target >= v->frameCount - 1) v->isPlaying = false;
+    Video_ShowSequenceFrame(v, target);
+}
+
+static void Video_FreeDecoder(VideoEngine *v) {
+    if (v->sequence) {
+        ImageSequence_Close(v->sequence);
+        v->sequence = NULL;
+    }
+    if (v->swsCtx) {
+        sws_freeContext(v->swsCtx);
+        v->swsCtx = NULL;
+    }
+    if (v->frameRGB) av_frame_free(&v->frameRGB);
+    if (v->frame) av_frame_free(&v->frame);
+    if (v->packet) av_packet_free(&v->packet);
+    if (v->codecCtx) avcodec_free_context(&v->codecCtx);
+    if (v->formatCtx) avformat_close_input(&v->formatCtx);
+    if (v->buffer) {
+        av_free(v->buffer);
+        v->buffer = NULL;
+    }
+}
+
+static void Video_OpenJob(void *arg) {
+    VideoLoader *ld = (VideoLoader *)arg;
+    bool ok = Video_OpenSource(&ld->staged, ld->path, ld);
+    Video_SetStage(ld, ok ? VIDEO_LOAD_READY : VIDEO_LOAD_FAILED);
+}
+
+// Après l'affichage de la première image : ouvre le décodeur arrière (construction
+// de son index) et remplit le cache avec le début de la vidéo.
+static void Video_WarmupJob(void *arg) {
+    VideoLoader *ld = (VideoLoader *)arg;
+    VideoEngine *p = &ld->preview;
+    ld->warmPlayer = ReversePlayer_Create(ld->path, p->fps, p->baseTimeOffset, &p->crop, p->cache);
+    if (!ld->warmPlayer || Video_InterruptCallback(ld)) return;
+    ReversePlayer_SetInterrupt(ld->warmPlayer, Video_InterruptCallback, ld);
+    ReversePlayer_DecodeWindow(ld->warmPlayer, FrameCache_Capacity(p->cache) / 2 - 1);
+}
+
+// Interrompt et attend le worker, puis libère le chargeur. Si la vidéo n'a pas encore
+// été transmise au thread UI, les ressources ouvertes par le worker sont libérées.
+static void Video_EndLoader(VideoEngine *v) {
+    VideoLoader *ld = v->loader;
+    if (!ld) return;
+
+    JobMutex_Lock(ld->mutex);
+    ld->cancelled = true;
+    JobMutex_Unlock(ld->mutex);
+    Job_Wait(ld->job);
+
+    if (!v->isLoaded) Video_FreeDecoder(&ld->staged);
+    if (ld->warmPlayer) {
+        ReversePlayer_SetInterrupt(ld->warmPlayer, NULL, NULL);
+        if (v->isLoaded && !v->reverse) v->reverse = ld->warmPlayer;
+        else ReversePlayer_Destroy(ld->warmPlayer);
+    }
+    JobMutex_Destroy(ld->mutex);
+    free(ld);
+    v->loader = NULL;
+}
+
+// Cache et textures à la taille de la zone d'analyse, initialisés avec v->buffer.
+static void Video_CreateOutput(VideoEngine *v) {
+    v->cache = FrameCache_Create(v->crop.width, v->crop.height, FRAME_CACHE_BUDGET_BYTES);
+
+    Image img = { v->buffer, v->crop.width, v->crop.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8 };
+    for (int i = 0; i < VIDEO_UPLOAD_TEXTURES; i++) v->uploadTextures[i] = LoadTextureFromImage(img);
+    v->uploadIndex = 0;
+    v->texture = v->uploadTextures[0];
+}
+
+static void Video_DestroyOutput(VideoEngine *v) {
+    if (v->cache) {
+        FrameCache_Destroy(v->cache);
+        v->cache = NULL;
+    }
+    for (int i = 0; i < VIDEO_UPLOAD_TEXTURES; i++) UnloadTexture(v->uploadTextures[i]);
+    v->texture = (Texture2D){ 0 };
+}
+
+// Ne reprend de 'staged' que ce que le worker a ouvert ou mesuré : les réglages que
+// l'interface a pu modifier pendant le chargement (vitesse, recadrage, envoi GPU) restent.
+static void Video_TakeDecoder(VideoEngine *v, VideoEngine *staged) {
+    Video_CopyMetadata(v, staged);
+    v->crop = staged->crop;
+    v->baseTimeOffset = staged->baseTimeOffset;
+    v->currentTime = staged->currentTime;
+    v->buffer = staged->buffer;
+    v->frame = staged->frame;
+    v->frameRGB = staged->frameRGB;
+    v->packet = staged->packet;
+    v->formatCtx = staged->formatCtx;
+    v->codecCtx = staged->codecCtx;
+    v->swsCtx = staged->swsCtx;
+    v->videoStreamIndex = staged->videoStreamIndex;
+    v->discardedPackets = staged->discardedPackets;
+    v->discardedBytes = staged->discardedBytes;
+    v->skipScanPos = staged->skipScanPos;
+    v->sequence = staged->sequence;
+    if (v->sequenceFps <= 0.0) v->sequenceFps = staged->sequenceFps;
+    memset(staged, 0, sizeof(*staged));
+}
+
+static void Video_FinishLoad(VideoEngine *v) {
+    VideoLoader *ld = v->loader;
+    Job_Wait(ld->job);
+    ld->job = NULL;
+
+    Video_TakeDecoder(v, &ld->staged);
+    if (v->formatCtx) v->formatCtx->interrupt_callback.callback = NULL;
+
+    snprintf(v->filePath, sizeof(v->filePath), "%s", ld->path);
+    Video_CreateOutput(v);
+    v->uploadLastMs = 0.0;
+    v->uploadAvgMs = 0.0;
+    v->uploadMaxMs = 0.0;
+
+    v->isLoaded = true;
+    v->loadState = VIDEO_LOAD_READY;
+    v->isPlaying = false;
+    v->isReversing = false;
+    v->needsResync = false;
+    v->quality = VIDEO_QUALITY_FULL;
+    v->accumulator = 0.0;
+    if (v->playbackSpeed <= 0.0) v->playbackSpeed = 1.0;
+
+    if (v->sequence) {
+        if (v->sequenceFps != v->fps) Video_SetSequenceFps(v, v->sequenceFps);
+        ImageSequence_Prefetch(v->sequence, v->cache, &v->crop, 0, 1, Video_SequenceReadAhead(v), v->fps);
+        Video_EndLoader(v);
+        Video_SetCrop(v, v->cropRequest);
+        return;
+    }
+    ld->preview = *v;
+    ld->job = Job_Submit(Video_WarmupJob, ld);
+}
+
+static void Video_PollLoad(VideoEngine *v) {
+    VideoLoader *ld = v->loader;
+    if (!ld) return;
+
+    if (v->isLoaded) {
+        if (Job_IsDone(ld->job)) {
+            Video_EndLoader(v);
+            // Recadrage demandé pendant le chargement (projet ouvert, réglage utilisateur).
+            Video_SetCrop(v, v->cropRequest);
+        }
+        return;
+    }
+
+    JobMutex_Lock(ld->mutex);
+    VideoLoadState stage = ld->stage;
+    if (stage >= VIDEO_LOAD_METADATA && v->loadState == VIDEO_LOAD_OPENING) {
+        Video_CopyMetadata(v, &ld->preview);
+        v->loadState = VIDEO_LOAD_METADATA;
+    }
+    JobMutex_Unlock(ld->mutex);
+
+    if (stage == VIDEO_LOAD_READY) {
+        Video_FinishLoad(v);
+    } else if (stage == VIDEO_LOAD_FAILED) {
+        Video_EndLoader(v);
+        v->loadState = VIDEO_LOAD_FAILED;
+    }
+}
+
+bool Video_Load(VideoEngine *v, const char *filename) {
+    if (!filename || !filename[0]) return false;
+    if (!ImageSequence_IsSource(filename) && !FileExists(filename)) return false;
+
+    VideoLoader *ld = (VideoLoader *)calloc(1, sizeof(VideoLoader));
+    if (!ld) return false;
+    ld->mutex = JobMutex_Create();
+    if (!ld->mutex) {
+        free(ld);
+        return false;
+    }
+
+    ld->staged = *v;
+    ld->staged.isLoaded = false;
+    ld->staged.formatCtx = NULL;
+    ld->staged.codecCtx = NULL;
+    ld->staged.swsCtx = NULL;
+    ld->staged.frame = NULL;
+    ld->staged.frameRGB = NULL;
+    ld->staged.packet = NULL;
+    ld->staged.buffer = NULL;
+    ld->staged.cache = NULL;
+    ld->staged.reverse = NULL;
+    ld->staged.sequence = NULL;
+    ld->staged.loader = NULL;
+    ld->stage = VIDEO_LOAD_OPENING;
+    strncpy(ld->path, filename, sizeof(ld->path) - 1);
+
+    v->loader = ld;
+    v->loadState = VIDEO_LOAD_OPENING;
+    ld->job = Job_Submit(Video_OpenJob, ld);
+    return true;
+}
+
+
+// Affiche une image du FrameCache sans toucher au décodeur principal, qui devra
+// être repositionné avant de reprendre la lecture séquentielle.
+static bool Video_PresentCachedFrame(VideoEngine *v, long long frameIdx) {
+    double time;
+    if (!FrameCache_Fetch(v->cache, frameIdx, v->buffer, &time)) return false;
+    Video_UploadFrame(v);
+    v->currentTime = time;
+    v->needsResync = true;
+    return true;
+}
+
+// Vrai tant que le worker de chargement prépare le décodeur arrière et le cache : les
+// appels depuis l'interface ne l'attendent pas, Video_PollLoad le libère à la fin.
+static bool Video_LoaderBusy(VideoEngine *v) {
+    if (!v->loader) return false;
+    if (!Job_IsDone(v->loader->job)) return true;
+    Video_EndLoader(v);
+    return false;
+}
+
+static ReversePlayer* Video_GetReversePlayer(VideoEngine *v) {
+    if (Video_LoaderBusy(v)) return NULL;
+    if (!v->reverse && v->cache && !v->sequence) {
+        v->reverse = ReversePlayer_Create(v->filePath, v->fps, v->baseTimeOffset, &v->crop, v->cache);
+    }
+    return v->reverse;
+}
+
+static bool Video_ShowFrameBackward(VideoEngine *v, long long frameIdx) {
+    if (frameIdx < 0) return false;
+    ReversePlayer *rp = Video_GetReversePlayer(v);
+    if (!rp) return false;
+
+    if (!Video_PresentCachedFrame(v, frameIdx)) {
+        ReversePlayer_Wait(rp);
+        if (!Video_PresentCachedFrame(v, frameIdx)) {
+            ReversePlayer_DecodeGop(rp, frameIdx);
+            if (!Video_PresentCachedFrame(v, frameIdx)) return false;
+        }
+    }
+    ReversePlayer_Anticipate(rp, frameIdx);
+    return true;
+}
+
+static void Video_UpdateReverse(VideoEngine *v) {
+    v->accumulator += GetFrameTime() * v->playbackSpeed;
+    double frameDelay = 1.0 / v->fps;
+
+    int framesDue = (int)(v->accumulator / frameDelay);
+    if (framesDue <= 0) return;
+
+    long long target = Video_FrameIndex(v, v->currentTime) - framesDue;
+    if (target <= 0) {
+        target = 0;
+        v->isPlaying = false;
+    }
+
+    ReversePlayer *rp = Video_GetReversePlayer(v);
+    if (!rp) {
+        // Décodeur arrière encore en préparation : on garde l'image sans accumuler de retard.
+        if (v->loader) v->accumulator = frameDelay;
+        else v->isPlaying = false;
+        return;
+    }
+
+    if (Video_PresentCachedFrame(v, target)) {
+        ReversePlayer_Anticipate(rp, target);
+    } else if (ReversePlayer_IsBusy(rp)) {
+        // Le worker décode encore la fenêtre : on garde l'image sans accumuler de retard.
+        v->accumulator = frameDelay;
+        return;
+    } else if (!Video_ShowFrameBackward(v, target)) {
+        v->isPlaying = false;
+    }
+    v->accumulator -= framesDue * frameDelay;
+}
+
+
 void Video_Update(VideoEngine *v) {
+    Video_PollLoad(v);
     if (!v->isLoaded || !v->isPlaying) return;
 
-    v->accumulator += GetFrameTime();
+    if (v->sequence) {
+        Video_UpdateSequence(v);
+        return;
+    }
+    if (v->isReversing) {
+        Video_UpdateReverse(v);
+        return;
+    }
+    if (v->needsResync) Video_SeekDecoder(v, v->currentTime);
+
+    v->accumulator += GetFrameTime() * v->playbackSpeed;
     double frameDelay = 1.0 / v->fps;
 
-    if (v->accumulator >= frameDelay) {
-        bool frameDecoded = false;
-        while (!frameDecoded) {
-            if (av_read_frame(v->formatCtx, v->packet) < 0) {
-                v->isPlaying = false;
-                v->currentTime = v->durationSec; 
-                break;
-            }
+    // Au ralenti aucune image n'est due la plupart des ticks : on garde celle affichée.
+    // En accéléré plusieurs images sont dues : on les décode mais seule la dernière est convertie.
+    int framesDue = (int)(v->accumulator / frameDelay);
+    if (framesDue <= 0) return;
+    v->accumulator -= framesDue * frameDelay;
+
+    if (framesDue > VIDEO_MAX_CATCHUP_FRAMES) {
+        double target = v->currentTime + framesDue * frameDelay;
+        if (target >= v->durationSec) {
+            v->isPlaying = false;
+            target = v->durationSec;
+        }
+        Video_Seek(v, target);
+        return;
+    }
 
-            if (v->packet->stream_index == v->videoStreamIndex) {
-                if (avcodec_send_packet(v->codecCtx, v->packet) == 0) {
-                    if (avcodec_receive_frame(v->codecCtx, v->frame) == 0) {
-                        Video_ProcessFrame(v);
-                        frameDecoded = true;
-                    }
-                }
-            }
-            av_packet_unref(v->packet);
+    for (int i = 0; i < framesDue; i++) {
+        if (!Video_DecodeNextFrame(v)) {
+            v->isPlaying = false;
+            v->currentTime = v->durationSec;
+            return;
         }
-        v->accumulator -= frameDelay;
     }
+    Video_ProcessFrame(v);
 }
 
 
@@ -190,6 +700,22 @@ void Video_Seek(VideoEngine *v, double targetTime) {
     if (targetTime < 0) targetTime = 0;
     if (targetTime > v->durationSec + 0.5) targetTime = v->durationSec + 0.5;
 
+    if (v->sequence) {
+        Video_ShowSequenceFrame(v, Video_FrameIndex(v, targetTime));
+        v->accumulator = 0;
+        return;
+    }
+    // Le cache n'est rempli que par le décodeur arrière, en pleine qualité : une image
+    // déjà décodée est affichée telle quelle, y compris pendant le défilement rapide.
+    if (Video_PresentCachedFrame(v, Video_FrameIndex(v, targetTime))) {
+        v->accumulator = 0;
+        return;
+    }
+    Video_SeekDecoder(v, targetTime);
+}
+
+
+static void Video_SeekDecoder(VideoEngine *v, double targetTime) {
     double absoluteTarget = targetTime + v->baseTimeOffset;
     int64_t targetTS = (int64_t)(absoluteTarget / av_q2d(v->formatCtx->streams[v->videoStreamIndex]->time_base));
     
@@ -198,6 +724,7 @@ void Video_Seek(VideoEngine *v, double targetTime) {
     }
 
     avcodec_flush_buffers(v->codecCtx);
+    v->skipScanPos = -1;
     
     bool reachedTarget = false;
     bool anyFrameDecoded = false;
@@ -208,22 +735,20 @@ void Video_Seek(VideoEngine *v, double targetTime) {
     if (threshold < 0) threshold = -0.0001;
 
     while (!reachedTarget && safetyCount < 1000) { 
-        int ret = av_read_frame(v->formatCtx, v->packet);
+        int ret = Video_ReadVideoPacket(v);
         if (ret < 0) break; // EOF
 
-        if (v->packet->stream_index == v->videoStreamIndex) {
-            if (avcodec_send_packet(v->codecCtx, v->packet) == 0) {
-                while (avcodec_receive_frame(v->codecCtx, v->frame) == 0) {
-                    anyFrameDecoded = true;
-                    
-                    double currentRel = GetRelativeFrameTime(v);
-                    
-                    if (currentRel >= threshold) {
-                        Video_ProcessFrame(v);
-                        reachedTarget = true;
-                    } else {
-                        v->currentTime = currentRel;
-                    }
+        if (avcodec_send_packet(v->codecCtx, v->packet) == 0) {
+            while (avcodec_receive_frame(v->codecCtx, v->frame) == 0) {
+                anyFrameDecoded = true;
+                
+                double currentRel = GetRelativeFrameTime(v);
+                
+                if (currentRel >= threshold) {
+                    Video_ProcessFrame(v);
+                    reachedTarget = true;
+                } else {
+                    v->currentTime = currentRel;
                 }
             }
         }
@@ -236,43 +761,151 @@ void Video_Seek(VideoEngine *v, double targetTime) {
     }
     
     v->accumulator = 0;
+    v->needsResync = false;
+}
+
+// En mode SCRUB le décodeur saute le filtre de boucle et les images non-référence :
+// les images intermédiaires sont approximatives mais un long seek coûte bien moins cher.
+void Video_SetDecodeQuality(VideoEngine *v, VideoDecodeQuality quality) {
+    if (!v->isLoaded || v->quality == quality) return;
+    v->quality = quality;
+    if (!v->codecCtx) return;
+
+    if (quality == VIDEO_QUALITY_SCRUB) {
+        v->codecCtx->skip_loop_filter = AVDISCARD_ALL;
+        v->codecCtx->skip_frame = AVDISCARD_NONREF;
+        v->codecCtx->flags2 |= AV_CODEC_FLAG2_FAST;
+    } else {
+        v->codecCtx->skip_loop_filter = AVDISCARD_DEFAULT;
+        v->codecCtx->skip_frame = AVDISCARD_DEFAULT;
+        v->codecCtx->flags2 &= ~AV_CODEC_FLAG2_FAST;
+    }
 }
 
 void Video_NextFrame(VideoEngine *v) {
     if (!v->isLoaded) return;
+    Video_SetDecodeQuality(v, VIDEO_QUALITY_FULL);
     Video_Seek(v, v->currentTime + (1.0 / v->fps));
 }
 
 void Video_PrevFrame(VideoEngine *v) {
     if (!v->isLoaded) return;
+    Video_SetDecodeQuality(v, VIDEO_QUALITY_FULL);
+    long long frameIdx = Video_FrameIndex(v, v->currentTime);
+    if (frameIdx > 0 && Video_ShowFrameBackward(v, frameIdx - 1)) {
+        v->accumulator = 0;
+        return;
+    }
     Video_Seek(v, v->currentTime - (1.0 / v->fps));
 }
 
 void Video_TogglePlay(VideoEngine *v) {
     if (v->isLoaded) {
         v->isPlaying = !v->isPlaying;
-        if (v->isPlaying && v->currentTime >= v->durationSec - 0.05) {
+        v->isReversing = false;
+        Video_SetDecodeQuality(v, VIDEO_QUALITY_FULL);
+        bool atEnd = v->sequence ? (Video_FrameIndex(v, v->currentTime) >= v->frameCount - 1)
+                                 : (v->currentTime >= v->durationSec - 0.05);
+        if (v->isPlaying && atEnd) {
             Video_Seek(v, 0);
         }
     }
 }
 
-void Video_Unload(VideoEngine *v) {
+void Video_TogglePlayReverse(VideoEngine *v) {
     if (!v->isLoaded) return;
-    UnloadTexture(v->texture);
+    if (v->isPlaying && v->isReversing) {
+        v->isPlaying = false;
+        return;
+    }
+    Video_SetDecodeQuality(v, VIDEO_QUALITY_FULL);
+    v->isReversing = true;
+    v->isPlaying = true;
+    v->accumulator = 0;
+}
+
+void Video_SetPlaybackSpeed(VideoEngine *v, double speed) {
+    if (speed < VIDEO_SPEED_MIN) speed = VIDEO_SPEED_MIN;
+    if (speed > VIDEO_SPEED_MAX) speed = VIDEO_SPEED_MAX;
+    v->playbackSpeed = speed;
+}
+
+void Video_StepPlaybackSpeed(VideoEngine *v, int direction) {
+    double speed = (v->playbackSpeed > 0.0) ? v->playbackSpeed : 1.0;
+    Video_SetPlaybackSpeed(v, direction > 0 ? speed * 2.0 : speed / 2.0);
+}
+
+void Video_SetSequenceFps(VideoEngine *v, double fps) {
+    if (fps <= 0.0) return;
+    v->sequenceFps = fps;
+    if (!v->isLoaded || !v->sequence) return;
+
+    // Les temps mis en cache dépendent de la cadence : on les invalide.
+    long long frameIdx = Video_FrameIndex(v, v->currentTime);
+    v->fps = fps;
+    v->durationSec = v->frameCount / fps;
+    v->currentTime = frameIdx / fps;
+    FrameCache_Clear(v->cache);
+}
+
+void Video_SetDirectUpload(VideoEngine *v, bool direct) {
+    if (v->directUpload == direct) return;
+    v->directUpload = direct;
+    v->uploadAvgMs = 0.0;
+    v->uploadMaxMs = 0.0;
+}
+
+// Change la zone d'analyse : tout ce qui dépend de la taille de sortie (buffer, sws,
+// cache, textures, décodeur arrière) est reconstruit puis l'image courante est redécodée.
+void Video_SetCrop(VideoEngine *v, Rectangle crop) {
+    v->cropRequest = crop;
+    if (!v->isLoaded) return;
+
+    VideoCrop newCrop = VideoCrop_Make(crop.x, crop.y, crop.width, crop.height, v->width, v->height);
+    if (memcmp(&newCrop, &v->crop, sizeof(VideoCrop)) == 0) return;
+    // Le worker écrit encore dans le cache : Video_PollLoad rappellera Video_SetCrop.
+    if (Video_LoaderBusy(v)) return;
+    if (v->reverse) {
+        ReversePlayer_Destroy(v->reverse);
+        v->reverse = NULL;
+    }
+    if (v->sequence) ImageSequence_Wait(v->sequence);
+    Video_DestroyOutput(v);
+
+    v->crop = newCrop;
+    size_t frameBytes = (size_t)v->crop.width * v->crop.height * 3;
+    av_free(v->buffer);
+    v->buffer = (uint8_t *)av_malloc(frameBytes);
+    if (!v->buffer) {
+        Video_Unload(v);
+        return;
+    }
+    memset(v->buffer, 0, frameBytes);
+    if (v->frameRGB) {
+        av_image_fill_arrays(v->frameRGB->data, v->frameRGB->linesize, 
+                            v->buffer, AV_PIX_FMT_RGB24, 
+                            v->crop.width, v->crop.height, 1);
+    }
     if (v->swsCtx) {
         sws_freeContext(v->swsCtx);
         v->swsCtx = NULL;
     }
-    if (v->frameRGB) av_frame_free(&v->frameRGB);
-    if (v->frame) av_frame_free(&v->frame);
-    if (v->packet) av_packet_free(&v->packet);
-    if (v->codecCtx) avcodec_free_context(&v->codecCtx);
-    if (v->formatCtx) avformat_close_input(&v->formatCtx);
-    if (v->buffer) {
-        av_free(v->buffer);
-        v->buffer = NULL;
+    Video_CreateOutput(v);
+
+    if (v->sequence) Video_ShowSequenceFrame(v, Video_FrameIndex(v, v->currentTime));
+    else Video_SeekDecoder(v, v->currentTime);
+}
+
+void Video_Unload(VideoEngine *v) {
+    Video_EndLoader(v);
+    v->loadState = VIDEO_LOAD_IDLE;
+    if (!v->isLoaded) return;
+    if (v->reverse) {
+        ReversePlayer_Destroy(v->reverse);
+        v->reverse = NULL;
     }
+    Video_FreeDecoder(v);
+    Video_DestroyOutput(v);
 
     v->isLoaded = false;
-}
\ No newline at end of file
+}
@@ -0,0 +1,206 @@
+#include "video_reverse.h"
+#include "job_system.h"
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libswscale/swscale.h>
+#include <libavutil/imgutils.h>
+#include <stdlib.h>
+#include <math.h>
+
+struct ReversePlayer {
+    AVFormatContext *formatCtx;
+    AVCodecContext *codecCtx;
+    struct SwsContext *swsCtx;
+    AVFrame *frame;
+    AVPacket *packet;
+    int streamIndex;
+
+    VideoCrop crop;
+    double fps;
+    double baseTimeOffset;
+    int windowSize;
+    FrameCache *cache;
+
+    Job *job;
+    long long jobFirstIdx;
+    long long jobLastIdx;
+    long long lowestRequested;
+
+    int (*interrupt)(void *);
+    void *interruptOpaque;
+};
+
+static double ReversePlayer_FrameTime(ReversePlayer *rp, long long fallbackIdx) {
+    int64_t ts = rp->frame->best_effort_timestamp;
+    if (ts == AV_NOPTS_VALUE) ts = rp->frame->pts;
+    if (ts == AV_NOPTS_VALUE) ts = rp->frame->pkt_dts;
+    if (ts == AV_NOPTS_VALUE) return fallbackIdx / rp->fps;
+
+    double rel = ts * av_q2d(rp->formatCtx->streams[rp->streamIndex]->time_base) - rp->baseTimeOffset;
+    return (rel < 0) ? 0.0 : rel;
+}
+
+static void ReversePlayer_StoreFrame(ReversePlayer *rp, long long frameIdx, double time) {
+    uint8_t *dst = FrameCache_BeginWrite(rp->cache, frameIdx);
+    if (!dst) return;
+
+    VideoCrop_Apply(&rp->crop, rp->frame);
+    rp->swsCtx = sws_getCachedContext(rp->swsCtx,
+        rp->frame->width, rp->frame->height, rp->frame->format,
+        rp->crop.width, rp->crop.height, AV_PIX_FMT_RGB24,
+        SWS_BILINEAR, NULL, NULL, NULL);
+
+    bool ok = false;
+    if (rp->swsCtx) {
+        uint8_t *dstData[4] = { dst, NULL, NULL, NULL };
+        int dstLinesize[4] = { rp->crop.width * 3, 0, 0, 0 };
+        sws_scale(rp->swsCtx, (const uint8_t *const *)rp->frame->data, rp->frame->linesize,
+                  0, rp->frame->height, dstData, dstLinesize);
+        ok = true;
+    }
+    FrameCache_EndWrite(rp->cache, frameIdx, time, ok);
+}
+
+// Décode en avant depuis l'image clé qui précède seekIdx et garde les images de
+// [firstIdx, lastIdx]. Renvoie l'indice de la première image décodée (l'image clé), -1 en cas d'échec.
+static long long ReversePlayer_DecodeRange(ReversePlayer *rp, long long seekIdx, long long firstIdx, long long lastIdx) {
+    AVStream *stream = rp->formatCtx->streams[rp->streamIndex];
+    double seekTime = seekIdx / rp->fps + rp->baseTimeOffset;
+    int64_t targetTS = (int64_t)(seekTime / av_q2d(stream->time_base));
+    if (av_seek_frame(rp->formatCtx, rp->streamIndex, targetTS, AVSEEK_FLAG_BACKWARD) < 0) return -1;
+    avcodec_flush_buffers(rp->codecCtx);
+
+    long long decodedIdx = -1;
+    long long keyIdx = -1;
+    int safetyCount = 0;
+    while (decodedIdx < lastIdx && safetyCount < 4000) {
+        if (rp->interrupt && rp->interrupt(rp->interruptOpaque)) break;
+        if (av_read_frame(rp->formatCtx, rp->packet) < 0) break;
+        safetyCount++;
+
+        if (rp->packet->stream_index == rp->streamIndex && avcodec_send_packet(rp->codecCtx, rp->packet) == 0) {
+            while (avcodec_receive_frame(rp->codecCtx, rp->frame) == 0) {
+                double time = ReversePlayer_FrameTime(rp, decodedIdx + 1);
+                decodedIdx = llround(time * rp->fps);
+                if (keyIdx < 0 || decodedIdx < keyIdx) keyIdx = decodedIdx;
+                if (decodedIdx >= firstIdx && decodedIdx <= lastIdx) ReversePlayer_StoreFrame(rp, decodedIdx, time);
+            }
+        }
+        av_packet_unref(rp->packet);
+    }
+    return keyIdx;
+}
+
+static void ReversePlayer_Job(void *arg) {
+    ReversePlayer *rp = (ReversePlayer *)arg;
+    ReversePlayer_DecodeRange(rp, rp->jobFirstIdx, rp->jobFirstIdx, rp->jobLastIdx);
+}
+
+static void ReversePlayer_Submit(ReversePlayer *rp, long long firstIdx, long long lastIdx) {
+    rp->jobFirstIdx = firstIdx;
+    rp->jobLastIdx = lastIdx;
+    rp->job = Job_Submit(ReversePlayer_Job, rp);
+}
+
+ReversePlayer* ReversePlayer_Create(const char *path, double fps, double baseTimeOffset, const VideoCrop *crop, FrameCache *cache) {
+    if (!cache || !crop || fps <= 0) return NULL;
+
+    ReversePlayer *rp = (ReversePlayer *)calloc(1, sizeof(ReversePlayer));
+    if (!rp) return NULL;
+    rp->fps = fps;
+    rp->baseTimeOffset = baseTimeOffset;
+    rp->crop = *crop;
+    rp->cache = cache;
+    rp->windowSize = FrameCache_Capacity(cache) / 2;
+    if (rp->windowSize < 4) rp->windowSize = 4;
+    rp->lowestRequested = -1;
+
+    if (avformat_open_input(&rp->formatCtx, path, NULL, NULL) != 0) goto fail;
+    if (avformat_find_stream_info(rp->formatCtx, NULL) < 0) goto fail;
+
+    rp->streamIndex = av_find_best_stream(rp->formatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
+    if (rp->streamIndex < 0) goto fail;
+    for (unsigned int i = 0; i < rp->formatCtx->nb_streams; i++) {
+        if ((int)i != rp->streamIndex) rp->formatCtx->streams[i]->discard = AVDISCARD_ALL;
+    }
+
+    AVCodecParameters *codecParams = rp->formatCtx->streams[rp->streamIndex]->codecpar;
+    const AVCodec *codec = avcodec_find_decoder(codecParams->codec_id);
+    rp->codecCtx = avcodec_alloc_context3(codec);
+    if (!rp->codecCtx) goto fail;
+    avcodec_parameters_to_context(rp->codecCtx, codecParams);
+    if (avcodec_open2(rp->codecCtx, codec, NULL) < 0) goto fail;
+
+    rp->frame = av_frame_alloc();
+    rp->packet = av_packet_alloc();
+    if (!rp->frame || !rp->packet) goto fail;
+    return rp;
+
+fail:
+    ReversePlayer_Destroy(rp);
+    return NULL;
+}
+
+void ReversePlayer_Destroy(ReversePlayer *rp) {
+    if (!rp) return;
+    ReversePlayer_Wait(rp);
+    if (rp->swsCtx) sws_freeContext(rp->swsCtx);
+    if (rp->frame) av_frame_free(&rp->frame);
+    if (rp->packet) av_packet_free(&rp->packet);
+    if (rp->codecCtx) avcodec_free_context(&rp->codecCtx);
+    if (rp->formatCtx) avformat_close_input(&rp->formatCtx);
+    free(rp);
+}
+
+bool ReversePlayer_IsBusy(ReversePlayer *rp) {
+    return rp->job && !Job_IsDone(rp->job);
+}
+
+void ReversePlayer_Wait(ReversePlayer *rp) {
+    if (!rp->job) return;
+    Job_Wait(rp->job);
+    rp->job = NULL;
+}
+
+static long long ReversePlayer_WindowStart(ReversePlayer *rp, long long lastIdx) {
+    long long firstIdx = lastIdx - rp->windowSize + 1;
+    return (firstIdx < 0) ? 0 : firstIdx;
+}
+
+void ReversePlayer_DecodeWindow(ReversePlayer *rp, long long lastIdx) {
+    ReversePlayer_Wait(rp);
+    long long firstIdx = ReversePlayer_WindowStart(rp, lastIdx);
+    ReversePlayer_DecodeRange(rp, firstIdx, firstIdx, lastIdx);
+    rp->lowestRequested = firstIdx;
+}
+
+// Seul le GOP qui contient frameIdx est décodé sur le thread appelant ; le reste de la
+// fenêtre, avant son image clé, est confié au worker.
+void ReversePlayer_DecodeGop(ReversePlayer *rp, long long frameIdx) {
+    ReversePlayer_Wait(rp);
+    long long firstIdx = ReversePlayer_WindowStart(rp, frameIdx);
+    long long keyIdx = ReversePlayer_DecodeRange(rp, frameIdx, firstIdx, frameIdx);
+    rp->lowestRequested = firstIdx;
+    if (keyIdx > firstIdx) ReversePlayer_Submit(rp, firstIdx, keyIdx - 1);
+}
+
+// Lance le décodage de la fenêtre précédente dès que l'image affichée entre dans
+// la moitié basse de la zone déjà décodée.
+void ReversePlayer_Anticipate(ReversePlayer *rp, long long currentIdx) {
+    if (ReversePlayer_IsBusy(rp)) return;
+    ReversePlayer_Wait(rp);
+
+    if (rp->lowestRequested < 0 || currentIdx < rp->lowestRequested || currentIdx > rp->lowestRequested + 2 * rp->windowSize) {
+        rp->lowestRequested = currentIdx;
+    }
+    if (rp->lowestRequested <= 0 || currentIdx - rp->lowestRequested > rp->windowSize / 2) return;
+
+    long long lastIdx = rp->lowestRequested - 1;
+    rp->lowestRequested = ReversePlayer_WindowStart(rp, lastIdx);
+    ReversePlayer_Submit(rp, rp->lowestRequested, lastIdx);
+}
+
+void ReversePlayer_SetInterrupt(ReversePlayer *rp, int (*callback)(void *), void *opaque) {
+    rp->interrupt = callback;
+    rp->interruptOpaque = opaque;
+}